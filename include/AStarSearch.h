@@ -20,12 +20,90 @@
 
 #include <DataTypes.h>
 
+#include <algorithm>
 #include <list>
 #include <vector>
 
 class UnitBase;
 class Map;
 
+/**
+    This class contains the per tile working data of an A* search. It is owned by the map and reused
+    by every path query, so that no memory has to be allocated or cleared per search. The data is stored
+    as a structure of arrays and every tile carries a generation stamp: tile data with a stamp different
+    from the current generation is treated as untouched (all zero), so starting a new search is O(1).
+*/
+class AStarSearchContext {
+public:
+    AStarSearchContext() : sizeX(0), sizeY(0), currentGeneration(0), bInUse(false) { };
+    ~AStarSearchContext() { };
+
+    /**
+        Prepares this context for a new search on a map of the given size.
+        \param  newSizeX    the width of the map
+        \param  newSizeY    the height of the map
+    */
+    void beginSearch(int newSizeX, int newSizeY) {
+        if((newSizeX != sizeX) || (newSizeY != sizeY)) {
+            sizeX = newSizeX;
+            sizeY = newSizeY;
+
+            size_t numTiles = sizeX*sizeY;
+            generation.assign(numTiles, 0);
+            parent.resize(numTiles);
+            openListIndex.resize(numTiles);
+            g.resize(numTiles);
+            h.resize(numTiles);
+            f.resize(numTiles);
+            flags.resize(numTiles);
+            currentGeneration = 0;
+        }
+
+        if(++currentGeneration == 0) {
+            // generation counter wrapped around => really clear all stamps once
+            std::fill(generation.begin(), generation.end(), 0);
+            currentGeneration = 1;
+        }
+
+        openList.clear();
+        bInUse = true;
+    };
+
+    /**
+        Marks this context as free again. Must be called when the search that used it is finished.
+    */
+    void endSearch() { bInUse = false; };
+
+    /**
+        Is this context currently used by a search?
+        \return true if a search is using this context
+    */
+    bool isInUse() const { return bInUse; };
+
+private:
+    friend class AStarSearch;
+
+    enum {
+        Flag_InOpenList = 0x01,
+        Flag_Closed     = 0x02,
+        Flag_Reached    = 0x04
+    };
+
+    int     sizeX;                          ///< width of the map this context was set up for
+    int     sizeY;                          ///< height of the map this context was set up for
+    Uint32  currentGeneration;              ///< the generation of the currently running search
+    bool    bInUse;                         ///< is a search currently using this context?
+
+    std::vector<Uint32> generation;         ///< the search generation the data of each tile belongs to
+    std::vector<Sint32> parent;             ///< index of the parent tile or INVALID_POS
+    std::vector<Uint32> openListIndex;      ///< position of each tile inside the open list heap
+    std::vector<float>  g;                  ///< cost from start
+    std::vector<float>  h;                  ///< heuristic distance to destination
+    std::vector<float>  f;                  ///< g + h
+    std::vector<Uint8>  flags;              ///< combination of Flag_InOpenList, Flag_Closed and Flag_Reached
+    std::vector<Sint32> openList;           ///< binary heap of tile indices ordered by f
+};
+
 class AStarSearch {
 public:
     AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destination);
@@ -40,7 +118,7 @@ public:
 
         Coord currentCoord = bestCoord;
         while(true) {
-            Coord nextCoord = getMapData(currentCoord).parentCoord;
+            Coord nextCoord = getParentCoord(currentCoord);
 
             if(nextCoord.isInvalid()) {
                 break;
@@ -55,25 +133,9 @@ public:
 
     // Find a path reached to destination, otherwise return empty path list
     std::list<Coord> getFoundReachedPath() {
-        std::list<Coord> path;
-
-        if(bestCoord.isInvalid()) {
-            return path;
-        }
-
-        Coord currentCoord = bestCoord;
-        while(true) {
-            Coord nextCoord = getMapData(currentCoord).parentCoord;
-
-            if(nextCoord.isInvalid()) {
-                break;
-            }
-
-            path.push_front(currentCoord);
-            currentCoord = nextCoord;
-        }
+        std::list<Coord> path = getFoundPath();
 
-        if (!getMapData(path.back()).bReached)
+        if (!path.empty() && !isReached(path.back()))
         	path.clear();
 
        return path;
@@ -82,72 +144,87 @@ public:
 
     // Find the last point in a path to destination that is reacheable, otherwise return empty path list
     std::list<Coord> getFoundReacheablePath() {
-        std::list<Coord> path;
-        std::list<Coord> reversepath;
+        std::list<Coord> path = getFoundPath();
 
-        if(bestCoord.isInvalid()) {
+        if(path.empty()) {
             return path;
         }
 
-        Coord currentCoord = bestCoord;
-        while(true) {
-            Coord nextCoord = getMapData(currentCoord).parentCoord;
-
-            if(nextCoord.isInvalid()) {
-                break;
-            }
-
-            path.push_front(currentCoord);
-            currentCoord = nextCoord;
-        }
-        reversepath = path;
-
-
         // if final point could not be reached, reach the previous if any otherwise return empty path list
-        if (!getMapData(path.back()).bReached) {
+        if (!isReached(path.back())) {
         	path.pop_back();
         	if(path.size() > 0) {
-        		getMapData(path.back()).bReached = true;
-        		//fprintf(stderr,"path list size %d\n",path.size() );
+        		setReached(getIndex(path.back()), true);
         	}
         	else {
-        		//fprintf(stderr,"path list empty \n");
         		return path;
         	}
         }
 
-
-
        return path;
 
     };
 
 private:
-    struct TileData {
-        Coord   parentCoord;
-        size_t  openListIndex;
-        float   g;
-        float   h;
-        float   f;
-        bool    bInOpenList;
-        bool    bClosed;
-        bool	bReached;
+    inline Sint32 getIndex(const Coord& coord) const { return coord.y * sizeX + coord.x; };
+    inline Coord getCoord(Sint32 index) const { return Coord(index % sizeX, index / sizeX); };
+
+    /**
+        Returns true if the data of this tile was written during the current search
+    */
+    inline bool isTouched(Sint32 index) const { return (context.generation[index] == context.currentGeneration); };
+
+    /**
+        Makes sure the data of this tile belongs to the current search. Stale data is reset to its initial state.
+    */
+    inline void touch(Sint32 index) {
+        if(!isTouched(index)) {
+            context.generation[index] = context.currentGeneration;
+            context.parent[index] = INVALID_POS;
+            context.openListIndex[index] = 0;
+            context.g[index] = 0.0f;
+            context.h[index] = 0.0f;
+            context.f[index] = 0.0f;
+            context.flags[index] = 0;
+        }
+    };
+
+    inline bool hasFlag(Sint32 index, Uint8 flag) const { return isTouched(index) && ((context.flags[index] & flag) != 0); };
+    inline void setFlag(Sint32 index, Uint8 flag, bool bSet) {
+        touch(index);
+        if(bSet) {
+            context.flags[index] |= flag;
+        } else {
+            context.flags[index] &= ~flag;
+        }
     };
 
+    inline bool isInOpenList(Sint32 index) const { return hasFlag(index, AStarSearchContext::Flag_InOpenList); };
+    inline bool isClosed(Sint32 index) const { return hasFlag(index, AStarSearchContext::Flag_Closed); };
+    inline bool isReached(const Coord& coord) const { return hasFlag(getIndex(coord), AStarSearchContext::Flag_Reached); };
+    inline void setReached(Sint32 index, bool bReached) { setFlag(index, AStarSearchContext::Flag_Reached, bReached); };
 
-    inline TileData& getMapData(const Coord& coord) const { return mapData[coord.y * sizeX + coord.x]; };
+    inline Coord getParentCoord(const Coord& coord) const {
+        Sint32 index = getIndex(coord);
+        if(!isTouched(index) || (context.parent[index] == INVALID_POS)) {
+            return Coord::Invalid();
+        }
+        return getCoord(context.parent[index]);
+    };
 
     void trickleUp(size_t openListIndex) {
-        Coord bottom = openList[openListIndex];
-        float newf = getMapData(bottom).f;
+        std::vector<Sint32>& openList = context.openList;
+
+        Sint32 bottom = openList[openListIndex];
+        float newf = context.f[bottom];
 
         size_t current = openListIndex;
         size_t parent = (openListIndex - 1)/2;
-        while (current > 0 && getMapData(openList[parent]).f > newf) {
+        while (current > 0 && context.f[openList[parent]] > newf) {
 
             // copy parent to position of current
             openList[current] = openList[parent];
-            getMapData(openList[current]).openListIndex = current;
+            context.openListIndex[openList[current]] = current;
 
             // go up one level in the tree
             current = parent;
@@ -155,50 +232,57 @@ private:
         }
 
         openList[current] = bottom;
-        getMapData(openList[current]).openListIndex = current;
+        context.openListIndex[openList[current]] = current;
     };
 
-    void putOnOpenListIfBetter(const Coord& coord, const Coord& parentCoord, float g, float h) {
+    void putOnOpenListIfBetter(Sint32 index, Sint32 parentIndex, float g, float h) {
         float f = g + h;
 
-        if(getMapData(coord).bInOpenList == false) {
+        if(isInOpenList(index) == false) {
             // not yet in openlist => add at the end of the open list
-            getMapData(coord).g = g;
-            getMapData(coord).h = h;
-            getMapData(coord).f = f;
-            getMapData(coord).parentCoord = parentCoord;
-            getMapData(coord).bInOpenList = true;
-            openList.push_back(coord);
-            getMapData(coord).openListIndex = openList.size() - 1;
-
-            trickleUp(openList.size() - 1);
+            touch(index);
+            context.g[index] = g;
+            context.h[index] = h;
+            context.f[index] = f;
+            context.parent[index] = parentIndex;
+            context.flags[index] |= AStarSearchContext::Flag_InOpenList;
+            context.openList.push_back(index);
+            context.openListIndex[index] = context.openList.size() - 1;
+
+            trickleUp(context.openList.size() - 1);
         } else {
             // already on openlist
-            if(f >= getMapData(coord).f) {
+            if(f >= context.f[index]) {
                 // new item is worse => don't change anything
                 return;
             } else {
                 // new item is better => replace
-                getMapData(coord).g = g;
-                getMapData(coord).h = h;
-                getMapData(coord).f = f;
-                getMapData(coord).parentCoord = parentCoord;
-                trickleUp(getMapData(coord).openListIndex);
+                context.g[index] = g;
+                context.h[index] = h;
+                context.f[index] = f;
+                context.parent[index] = parentIndex;
+                trickleUp(context.openListIndex[index]);
             }
         }
     };
 
-    Coord extractMin() {
-        Coord ret = openList[0];
-        getMapData(ret).bInOpenList = false;
+    Sint32 extractMin() {
+        std::vector<Sint32>& openList = context.openList;
+
+        Sint32 ret = openList[0];
+        context.flags[ret] &= ~AStarSearchContext::Flag_InOpenList;
 
         openList[0] = openList.back();
-        getMapData(openList[0]).openListIndex = 0;
+        context.openListIndex[openList[0]] = 0;
         openList.pop_back();
 
+        if(openList.empty()) {
+            return ret;
+        }
+
         size_t current = 0;
-        Coord top = openList[current];  // save root
-        float topf = getMapData(top).f;
+        Sint32 top = openList[current];  // save root
+        float topf = context.f[top];
         while(current < openList.size()/2) {
 
             size_t leftChild = 2*current+1;
@@ -210,8 +294,8 @@ private:
             size_t smallerChild;
             float smallerChildf;
             if(rightChild < openList.size()) {
-                float leftf = getMapData(openList[leftChild]).f;
-                float rightf = getMapData(openList[rightChild]).f;
+                float leftf = context.f[openList[leftChild]];
+                float rightf = context.f[openList[rightChild]];
 
                 if(leftf < rightf) {
                     smallerChild = leftChild;
@@ -223,7 +307,7 @@ private:
             } else {
                 // there is only a left child
                 smallerChild = leftChild;
-                smallerChildf = getMapData(openList[leftChild]).f;
+                smallerChildf = context.f[openList[leftChild]];
             }
 
             // top >= largerChild?
@@ -232,14 +316,14 @@ private:
 
             // shift child up
             openList[current] = openList[smallerChild];
-            getMapData(openList[current]).openListIndex = current;
+            context.openListIndex[openList[current]] = current;
 
             // go down one level in the tree
             current = smallerChild;
         }
 
         openList[current] = top;
-        getMapData(openList[current]).openListIndex = current;
+        context.openListIndex[openList[current]] = current;
 
         return ret;
     };
@@ -247,8 +331,8 @@ private:
     int sizeX;
     int sizeY;
     Coord bestCoord;
-    TileData* mapData;
-    std::vector<Coord> openList;
+    AStarSearchContext* pOwnContext;    ///< only used if the map's context is already in use by another search
+    AStarSearchContext& context;        ///< the search data used by this search
 };
 
 #endif //ASTARSEARCH_H
@@ -24,6 +24,7 @@
 #include <ScreenBorder.h>
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
+#include <misc/ObjectPool.h>
 
 // forward declarations
 class House;
@@ -37,6 +38,25 @@ public:
 	void init();
 	~Bullet();
 
+	/**
+        Bullets are allocated from a pool instead of the heap.
+        \param size    the size of the object
+        \return the memory for the new bullet
+	*/
+	static void* operator new(size_t size);
+
+	/**
+        Gives the memory of a bullet back to the pool.
+        \param p   the memory of the bullet
+	*/
+	static void operator delete(void* p);
+
+	/**
+        Returns the pool all bullets are allocated from (e.g. for statistics).
+        \return the bullet pool
+	*/
+	static const ObjectPool<Bullet>& getPool();
+
 	void save(OutputStream& stream) const;
 
 	void blitToScreen();
@@ -56,6 +56,8 @@ typedef enum {
 	CMD_MAX
 } CMDTYPE;
 
+#define COMMAND_MAXPARAMETERS 4     ///< the maximum number of parameters of one command
+
 /**
     This class represents one command with all its parameters. The command is specified by CommandID (see CMDTYPE)
     and Parameter holds all its parameters (see the documentation for every CMDTYPE). There can be up to 4 parameters
@@ -141,7 +143,7 @@ public:
         Gets the parameters of this command.
         \return the parameters of this command
 	*/
-	const std::vector<Uint32> getParameter() const { return parameter; };
+	const std::vector<Uint32> getParameter() const { return std::vector<Uint32>(parameter, parameter + numParameters); };
 
 
     /**
@@ -150,7 +152,8 @@ public:
 	void executeCommand() const;
 
 private:
-	std::vector<Uint32> parameter;      ///< the parameters for this command
+	Uint32  parameter[COMMAND_MAXPARAMETERS];   ///< the parameters for this command (stored inline to avoid a heap allocation per command)
+	Uint8   numParameters;                      ///< the number of used entries in parameter
 	CMDTYPE commandID;                  ///< the type of command
     Uint8   playerID;                   ///< the ID of the player that gave the command
 };
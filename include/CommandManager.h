@@ -25,10 +25,19 @@
 
 #include <Network/CommandList.h>
 
+#include <utility>
 #include <vector>
 
+#define COMMANDMANAGER_HISTORY       MILLI2CYCLES(2500)  ///< number of past game cycles kept for resending them to other peers
+#define COMMANDMANAGER_INITIALSLOTS  256                 ///< initial size of the ring buffer (it grows if the network lookahead needs more)
+#define COMMANDMANAGER_FLUSHINTERVAL MILLI2CYCLES(5000)  ///< number of game cycles between two flushes of the stream set with setStream()
+
 /**
     The command manager collects all the given user commands (e.g. move unit u to position (x,y)) . These commands might be transfered over a network.
+
+    Only the scheduled commands and the last COMMANDMANAGER_HISTORY game cycles are kept in a ring buffer for executing
+    and resending them. The complete history of the game is additionally kept in an append-only list (for save games and
+    replays) and written to the stream set with setStream().
 */
 class CommandManager {
 public:
@@ -67,23 +76,37 @@ public:
 	bool getReadOnly() const { return bReadOnly; };
 
     /**
-        Save all commands to stream. The read-only status is not saved.
+        Save the complete command history to stream. These are all loaded commands (e.g. of a loaded save game or
+        replay) and all commands added since. The read-only status is not saved.
         \param  stream  the stream to write to
     */
 	void save(OutputStream& stream) const;
 
     /**
-        Load commands from stream
+        Load commands from stream (e.g. a replay). They are moved into the ring buffer when their game cycle is executed.
         \param  stream  the stream to read from
     */
 	void load(InputStream& stream);
 
+    /**
+        Restarts a loaded replay at game cycle CycleNumber (e.g. after the world was restored from a checkpoint).
+        All scheduled commands are dropped and the loaded commands from CycleNumber on will be executed again.
+        \param  CycleNumber the game cycle the replay continues at
+    */
+	void seekLoadedCommands(Uint32 CycleNumber);
+
 
 	Uint32 getNetworkCycleBuffer() const { return networkCycleBuffer; };
 
 
 	void setNetworkCycleBuffer(Uint32 newNetworkCycleBuffer) { networkCycleBuffer = newNetworkCycleBuffer; };
 
+    /**
+        Returns the last game cycle that has commands scheduled.
+        \return the game cycle of the last command or 0 if there are no commands
+    */
+	Uint32 getLastCommandCycle() const { return lastCommandCycle; };
+
 	/**
         Updates the command manager and sends commands to other peers
 	*/
@@ -113,10 +136,28 @@ public:
         Runs all commands scheduled for game cycle CycleNumber
         \param  CycleNumber the current game cycle
     */
-	void executeCommands(Uint32 CycleNumber) const;
+	void executeCommands(Uint32 CycleNumber);
 
 private:
-	std::vector< std::vector<Command> > timeslot;   ///< a vector of vectors containing the scheduled commands. At index x is a list of all commands scheduled for game cycle x.
+    /// The commands of one game cycle
+    struct CommandSlot {
+        CommandSlot() : cycle(0) { };
+
+        Uint32 cycle;                   ///< the game cycle the commands belong to
+        std::vector<Command> commands;  ///< the commands sorted by player ID (in the order they were added for each player)
+    };
+
+	bool insertCommand(const Command& cmd, Uint32 CycleNumber);
+	const std::vector<Command>* getCommands(Uint32 CycleNumber) const;
+	void growTimeslots();
+
+	std::vector<CommandSlot> timeslot;              ///< a ring buffer containing the scheduled commands. Game cycle x is at index x % timeslot.size() if timeslot[x % timeslot.size()].cycle == x.
+	std::vector< std::pair<Uint32, Command> > loadedCommands;  ///< the commands read by load() sorted by game cycle
+	std::vector< std::pair<Uint32, Command> > addedCommands;   ///< all commands added with addCommand() in the order they were added
+	size_t nextLoadedCommand;                       ///< the first entry of loadedCommands that was not moved into the ring buffer yet
+	Uint32 lastCommandCycle;                        ///< the last game cycle that has commands
+	bool bStreamDirty;                              ///< were commands written to pStream since the last flush?
+	Uint32 lastStreamFlushCycle;                    ///< the game cycle pStream was flushed last
 	OutputStream* pStream;                          ///< a stream all added commands will be written to. May be NULL
 	bool bReadOnly;                                 ///< true = addCommand() is a NO-OP, false = addCommand() has normal behaviour
 	Uint32 networkCycleBuffer;                      ///< the number of frames a command is given in advance
@@ -239,6 +239,8 @@ public:
 	class GeneralClass {
 	public:
 		bool		      playIntro;
+		bool		      compressSaveGames;
+		int		          autosaveInterval;     ///< minutes between two autosaves; 0 = no autosave
 		std::string     playerName;
 		std::string     language;
 	} general;
@@ -279,7 +281,8 @@ public:
         GameOptionsClass()
          : gameSpeed(GAMESPEED_DEFAULT), concreteRequired(true), structuresDegradeOnConcrete(true), fogOfWar(false),
            startWithExploredMap(false), instantBuild(false), onlyOnePalace(false), rocketTurretsNeedPower(false),
-           sandwormsRespawn(false), killedSandwormsDropSpice(false), daynight(false), dayscale(GAMEDAYSCALE_DEFAULT) {
+           sandwormsRespawn(false), killedSandwormsDropSpice(false), daynight(false), dayscale(GAMEDAYSCALE_DEFAULT),
+           hierarchicalPathfinding(false), flowFieldPathfinding(false) {
         }
 
 
@@ -295,7 +298,9 @@ public:
                     && (sandwormsRespawn == goc.sandwormsRespawn)
                     && (killedSandwormsDropSpice == goc.killedSandwormsDropSpice)
 					&& (daynight == goc.daynight)
-					&& (dayscale == goc.dayscale);
+					&& (dayscale == goc.dayscale)
+					&& (hierarchicalPathfinding == goc.hierarchicalPathfinding)
+					&& (flowFieldPathfinding == goc.flowFieldPathfinding);
         }
 
         bool operator!=(const GameOptionsClass& goc) const {
@@ -314,6 +319,8 @@ public:
 		bool        killedSandwormsDropSpice;
 		bool 		daynight;
 		Uint8		dayscale;
+		bool		hierarchicalPathfinding;
+		bool		flowFieldPathfinding;
 	} gameOptions;
 };
 
@@ -21,6 +21,7 @@
 #include <DataTypes.h>
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
+#include <misc/ObjectPool.h>
 
 #include <SDL.h>
 
@@ -32,6 +33,25 @@ public:
     Explosion(InputStream& stream);
     ~Explosion();
 
+    /**
+        Explosions are allocated from a pool instead of the heap.
+        \param size    the size of the object
+        \return the memory for the new explosion
+    */
+    static void* operator new(size_t size);
+
+    /**
+        Gives the memory of an explosion back to the pool.
+        \param p   the memory of the explosion
+    */
+    static void operator delete(void* p);
+
+    /**
+        Returns the pool all explosions are allocated from (e.g. for statistics).
+        \return the explosion pool
+    */
+    static const ObjectPool<Explosion>& getPool();
+
     void init();
 
     void save(OutputStream& stream) const;
@@ -23,6 +23,11 @@
 
 #include <misc/memory.h>
 #include <string>
+#include <list>
+#include <map>
+#include <utility>
+
+#define TEXTCACHE_MAXENTRIES    256     ///< maximum number of text surfaces kept in the text cache
 
 typedef enum {
 	FONT_STD10,
@@ -46,9 +51,46 @@ public:
 	int getTextHeight(unsigned int fontNum);
 	SDL_Surface* createSurfaceWithText(std::string text, unsigned char color, unsigned int fontNum);
 	SDL_Surface* createSurfaceWithMultilineText(std::string text, unsigned char color, unsigned int fontNum, bool bCentered = false);
+
+	/**
+		Returns a surface with the specified text. In contrast to createSurfaceWithText() the surface is taken from
+		a cache of recently used texts, so that texts drawn every frame do not need a new surface every frame.
+		The surface is owned by the cache and must not be freed or modified. It stays valid until
+		TEXTCACHE_MAXENTRIES other texts have been requested or the cache is cleared, so it should be blitted right away.
+		\param	text	the text to render
+		\param	color	the color of the text
+		\param	fontNum	the font to use
+		\return	the surface with the text or NULL on error
+	*/
+	SDL_Surface* getTextSurface(const std::string& text, unsigned char color, unsigned int fontNum);
+
+	/**
+		Frees all cached text surfaces. This method has to be called when the palette was changed.
+	*/
+	void clearTextCache();
+
+	/// \return the number of getTextSurface() calls that were answered from the cache
+	inline Uint32 getTextCacheHits() const { return numTextCacheHits; };
+
+	/// \return the number of getTextSurface() calls that had to render the text
+	inline Uint32 getTextCacheMisses() const { return numTextCacheMisses; };
+
 private:
+	typedef std::pair<std::string, Uint32> TextCacheKey;     ///< the text and (fontNum << 8) | color
+
+	/// One rendered text in the text cache
+	struct TextCacheEntry {
+		TextCacheKey	key;        ///< the text, font and color of this entry
+		SDL_Surface*	pSurface;   ///< the rendered text
+	};
+
 	std::shared_ptr<Font> fonts[NUM_FONTS];
 
+	std::list<TextCacheEntry> textCacheList;                                    ///< the cached texts, the most recently used first
+	std::map<TextCacheKey, std::list<TextCacheEntry>::iterator> textCacheMap;   ///< for every cached text its entry in textCacheList
+	Uint32	numTextCacheHits;       ///< the number of cache hits so far
+	Uint32	numTextCacheMisses;     ///< the number of cache misses so far
+
 };
 
 #endif // FONTMANAGER_H
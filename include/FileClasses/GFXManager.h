@@ -465,6 +465,16 @@ public:
 	SDL_Surface*    getTransparent150Surface() { return pTransparent150Surface; };
 	SDL_Surface*    getTransparentXSurface() { return pTransparentXSurface; };
 
+    /**
+        Returns the fog mask for a zoom level. The mask has the same layout as ObjPic_Terrain_Hidden: every hidden pixel is
+        black and blended with alpha 40 (or 150), all other pixels are transparent. Thus a fogged tile is drawn with one blit
+        using the same source rectangle as for ObjPic_Terrain_Hidden.
+        \param  zoomlevel   the zoom level
+        \return the fog mask
+    */
+	SDL_Surface*    getFog40Mask(int zoomlevel) { return pFog40Mask[zoomlevel]; };
+	SDL_Surface*    getFog150Mask(int zoomlevel) { return pFog150Mask[zoomlevel]; };
+
 	void			exportPicture();
 
 	Animation*		getAnimation(unsigned int id);
@@ -476,6 +486,7 @@ private:
     std::shared_ptr<Wsafile>  loadWsafile(std::string filename);
 
 	SDL_Surface*	extractSmallDetailPic(std::string filename);
+	SDL_Surface*	createFogMask(SDL_Surface* pHiddenSurface, Uint8 alpha);
 
 	SDL_Surface*	objPic[NUM_OBJPICS][(int) NUM_HOUSES][NUM_ZOOMLEVEL];
 	SDL_Surface*	smallDetailPic[NUM_SMALLDETAILPICS];
@@ -487,6 +498,8 @@ private:
 	SDL_Surface*    pTransparent40Surface;
 	SDL_Surface*    pTransparent150Surface;
 	SDL_Surface*    pTransparentXSurface;
+	SDL_Surface*    pFog40Mask[NUM_ZOOMLEVEL];     ///< ObjPic_Terrain_Hidden as black with alpha 40
+	SDL_Surface*    pFog150Mask[NUM_ZOOMLEVEL];    ///< ObjPic_Terrain_Hidden as black with alpha 150
 };
 
 #endif // GFXMANAGER_H
@@ -30,11 +30,11 @@
 class PictureFont : public Font
 {
 private:
-	// Internal structure used for storing the character data
+	// Internal structure used for storing the position of a character inside the glyph atlas
 	struct FontCharacter
 	{
 		int	width;
-		std::vector<char> data;
+		int	atlasX;
 	};
 
 public:
@@ -55,6 +55,8 @@ public:
 private:
 	FontCharacter character[256];
 	Uint8 characterHeight;
+	int atlasWidth;                     ///< the width of one row of the glyph atlas
+	std::vector<Uint8> glyphAtlas;      ///< all characters side by side, one byte per pixel (1 = set, 0 = transparent)
 };
 
 #endif //PICTUREFONT_H
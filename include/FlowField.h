@@ -0,0 +1,99 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include <DataTypes.h>
+#include <Definitions.h>
+#include <data.h>
+
+#include <list>
+#include <vector>
+
+class UnitBase;
+class Map;
+
+#define FLOWFIELD_LIFETIME      MILLI2CYCLES(3000)  ///< number of game cycles an unused flow field is kept
+#define FLOWFIELD_MAXFIELDS     4                   ///< maximum number of flow fields kept at the same time
+#define FLOWFIELD_MINDISTANCE   8.0f                ///< paths shorter than this are searched with plain A*
+#define FLOWFIELD_NUMTERRAINTYPES   (Terrain_SpecialBloom+1)    ///< number of terrain types a flow field stores the difficulty for
+
+/**
+    A flow field contains for every tile of the map the cost to reach one destination and the direction to move
+    to get there. When a group of units is ordered to the same destination, one flow field is computed and shared by
+    all units instead of running one A* search per unit.
+
+    A flow field only depends on the destination, on the static terrain (mountains and structures) and on the terrain
+    difficulties of the unit. Units only share a flow field if all of these are equal, and all flow fields are dropped
+    whenever a tile changes. So the path a unit gets is the same whether its flow field was cached or computed for it
+    and the cache does not need to be saved. The path handed to the unit ends in front of the first tile that is
+    currently blocked.
+*/
+class FlowFieldCache {
+public:
+    typedef enum {
+        MoveClass_Invalid = -1,
+        MoveClass_Vehicle = 0,      ///< wheeled and tracked units (blocked by mountains)
+        MoveClass_Infantry = 1,     ///< infantry (can climb mountains)
+        NUM_MOVECLASSES
+    } MOVECLASS;
+
+	FlowFieldCache(Map* pMap);
+	~FlowFieldCache();
+
+    /**
+        Searches a path for pUnit using a shared flow field. If false is returned the caller should use A* instead.
+        \param  pUnit       the unit to search the path for
+        \param  start       the start of the path
+        \param  destination the destination of the path
+        \param  path        the found path
+        \return true if a path was found, false otherwise
+    */
+	bool searchPath(UnitBase* pUnit, const Coord& start, const Coord& destination, std::list<Coord>& path);
+
+    /**
+        Removes all flow fields. This method is called when a tile has changed.
+    */
+	void clear();
+
+    /**
+        Returns the movement class of the specified unit.
+        \param  pUnit   the unit to check
+        \return the movement class or MoveClass_Invalid for units that do not use flow fields
+    */
+	static MOVECLASS getMoveClass(const UnitBase* pUnit);
+
+private:
+    /// The costs and directions to one destination for one movement class
+    struct FlowField {
+        Coord   destination;                ///< the destination of this flow field
+        int     moveClass;                  ///< the movement class this flow field was computed for
+        float   terrainDifficulties[FLOWFIELD_NUMTERRAINTYPES];    ///< the terrain difficulties this flow field was computed with
+        Uint32  lastUsedCycle;              ///< the game cycle this flow field was used last
+        std::vector<float> costs;           ///< for every tile the cost to reach the destination
+        std::vector<Sint8> directions;      ///< for every tile the angle to the next tile or INVALID
+    };
+
+	bool isPassable(MOVECLASS moveClass, int x, int y) const;
+	void computeFlowField(FlowField& flowField);
+
+	Map*                pMap;               ///< the map this cache works on
+	std::list<FlowField> flowFields;        ///< the cached flow fields, the most recently used first
+};
+
+#endif // FLOWFIELD_H
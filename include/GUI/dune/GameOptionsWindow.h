@@ -81,6 +81,8 @@ private:
 	Checkbox rocketTurretsNeedPowerCheckbox;        ///< If checked rocket turrets are dysfunctional on power shortage
 	Checkbox sandwormsRespawnCheckbox;              ///< If checked killed sandworms respawn after some time
 	Checkbox killedSandwormsDropSpiceCheckbox;      ///< If checked killed sandworms drop some spice
+	Checkbox hierarchicalPathfindingCheckbox;       ///< If checked long unit paths are searched with HPA*
+	Checkbox flowFieldPathfindingCheckbox;          ///< If checked units moving to the same destination share a flow field
 	Checkbox daynight;    							///< If checked game will cycle night and days
 	HBox            gameSpeedHBox;                  ///< The HBox containing the game speed selection
 	PictureButton	gameSpeedPlus;                  ///< The button for increasing the game speed
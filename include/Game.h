@@ -19,12 +19,13 @@
 #define GAME_H
 
 #include <misc/Random.h>
-#include <misc/RobustList.h>
+#include <misc/DenseList.h>
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
 #include <ObjectData.h>
 #include <ObjectManager.h>
 #include <CommandManager.h>
+#include <SaveGameWriter.h>
 #include <GameInterface.h>
 #include <INIMap/INIMapLoader.h>
 #include <GameInitSettings.h>
@@ -38,6 +39,7 @@
 #include <stdarg.h>
 #include <string>
 #include <map>
+#include <vector>
 #include <utility>
 #include <limits.h>
 
@@ -49,10 +51,21 @@ class WaitingForOtherPlayers;
 class ObjectManager;
 class House;
 class Explosion;
+class Tile;
 
 
 #define END_WAIT_TIME				(6*1000)
 
+#define HEADLESS_EXTRACYCLES		MILLI2CYCLES(10*1000)	///< a headless replay is simulated this long after its last command
+#define BENCHMARK_SALVOSHOTS		200						///< number of shots of the damage salvo fired at the end of a benchmark
+#define BENCHMARK_SALVOROUNDS		10						///< number of times the damage salvo is fired
+
+#define TARGETSEARCH_INTERVAL		4						///< an object may only search for a target every TARGETSEARCH_INTERVAL cycles
+#define TARGETSEARCH_BUDGET			64						///< maximum number of regular target searches per game cycle
+#define TARGETSEARCH_PRIORITYTIME	MILLI2CYCLES(2*1000)	///< objects damaged within this time may search in every cycle
+
+#define REPLAY_CHECKPOINTINTERVAL	MILLI2CYCLES(60*1000)	///< number of game cycles between two world checkpoints taken while playing a replay
+
 #define GAME_NOTHING			-1
 #define	GAME_RETURN_TO_MENU		0
 #define GAME_NEXTMISSION		1
@@ -118,6 +131,16 @@ public:
     */
 	Uint32 getGameCycleCount() const { return gameCycleCount; };
 
+    /**
+        Asks if pObject may search for a new target in this game cycle. To spread the searches of big armies over
+        several cycles every object gets a slot every TARGETSEARCH_INTERVAL cycles (depending on its object ID) and only
+        TARGETSEARCH_BUDGET searches are granted per cycle. Objects that were damaged recently are always allowed.
+        The decision only depends on the game state, so all players of a multiplayer game decide the same.
+        \param pObject the object that wants to search for a target
+        \return true if the object may search now, false if it should try again later
+    */
+	bool mayScanForTarget(const ObjectBase* pObject);
+
 	/**
         Return the game time in milliseconds.
         \return the current game time in milliseconds
@@ -174,7 +197,7 @@ public:
         Get the explosion list.
         \return the explosion list
 	*/
-	RobustList<Explosion*>& getExplosionList() { return explosionList; };
+	DenseList<Explosion*>& getExplosionList() { return explosionList; };
 
 	/**
         Returns the house with the id houseID
@@ -237,37 +260,53 @@ public:
 
     /**
         This method loads a previously saved game.
-        \param stream the stream to load from
+        \param stream        the stream to load from
+        \param bLoadCommands false = the stream contains no commands (e.g. a replay checkpoint)
         \return true on success, false on failure
     */
-	bool loadSaveGame(InputStream& stream);
+	bool loadSaveGame(InputStream& stream, bool bLoadCommands = true);
 
     /**
         This method saves the current running game.
-        \param filename the name of the file to save to
-        \return true on success, false on failure
+        \param filename       the name of the file to save to
+        \param bInBackground  true = only take a snapshot in memory and let a background thread write the file
+        \return true on success (or if the background save was started), false on failure
     */
-	bool saveGame(std::string filename);
+	bool saveGame(std::string filename, bool bInBackground = false);
+
+    /**
+        Returns how long taking the snapshot for the last background save took.
+        \return the time in microseconds or 0 if there was no background save yet
+    */
+	Uint64 getLastSaveSnapshotTime() const { return lastSaveSnapshotTime; };
 
     /**
         This method starts the game. Will return when the game is finished or aborted.
     */
 	void runMainLoop();
 
+    /**
+        This method runs a replay without drawing, sound and user input as fast as possible (see --headless).
+        It returns when the game is finished or the replay has no more commands. With --checkreplay the replay is
+        afterwards simulated again from its checkpoints (see checkReplayCheckpoints()) and the program exits with
+        EXIT_FAILURE if this does not give the same game.
+    */
+	void runHeadless();
+
+    /**
+        This method jumps to another game cycle of the running replay. The world is restored from the last
+        checkpoint before targetCycle (if jumping backwards or if it is ahead of the current game cycle) and the
+        remaining game cycles are simulated without drawing.
+        \param targetCycle   the game cycle to jump to
+    */
+	void seekReplay(Uint32 targetCycle);
+
 	inline void quitGame() { bQuitGame = true;};
 
     /**
         This method pauses the current game.
     */
-	void pauseGame() {
-        if(bPause != true) {
-            bPause = true;
-            palette.invertPalette();
-            palette.applyToSurface(screen,SDL_PHYSPAL,1,palette.getSDLPalette()->ncolors-1);
-            //	XXX memcheck reports a source and destination overlap in memcpy
-            SDL_SetGamma(1,1,1);
-        }
-	}
+	void pauseGame();
 
     /**
         This method resumes the current paused game.
@@ -281,6 +320,9 @@ public:
     */
 	void saveObject(OutputStream& stream, ObjectBase* obj);
 
+	void saveGameHeader(OutputStream& stream);
+	void saveGameBody(OutputStream& stream, bool bSaveCommands = true);
+
     /**
         This method loads an object from the stream.
         \param stream   the stream to read from
@@ -573,6 +615,116 @@ public:
 
 private:
 
+    /// A snapshot of the world taken while playing a replay
+    struct ReplayCheckpoint {
+        Uint32      cycle;          ///< the game cycle the snapshot was taken at (before the commands of this cycle are executed)
+        std::string data;           ///< the savegame header and the compressed savegame body without the commands
+    };
+
+    /**
+        Takes a new checkpoint of the running replay if the last one is at least REPLAY_CHECKPOINTINTERVAL game cycles ago.
+        This method has to be called at the beginning of a game cycle.
+    */
+	void recordReplayCheckpoint();
+
+    /**
+        Replaces the world by the one stored in checkpoint and continues the replay at the game cycle of the checkpoint.
+        \param checkpoint    the checkpoint to restore
+    */
+	void restoreReplayCheckpoint(const ReplayCheckpoint& checkpoint);
+
+    /**
+        Saves the world the same way as a replay checkpoint.
+        \param data    the saved savegame header and compressed savegame body without the commands
+    */
+	void saveReplayCheckpoint(std::string& data);
+
+    /**
+        Checks that seeking in the replay gives the same game as playing it straight through. Every checkpoint
+        recorded while playing straight through is restored and simulated until the game cycle of the next checkpoint,
+        where the world has to be saved to the same bytes as this next checkpoint.
+        \return true if all checkpoints were reproduced, false otherwise
+    */
+	bool checkReplayCheckpoints();
+
+    /**
+        Simulates one game cycle of a headless replay.
+    */
+	void simulateHeadlessCycle();
+
+    /**
+        Deletes all structures, units, bullets, explosions, houses and the map.
+    */
+	void destroyWorld();
+
+    /// The phases of a game cycle that are timed in benchmark mode (see --bench)
+    typedef enum {
+        BenchmarkPhase_Commands,
+        BenchmarkPhase_Houses,
+        BenchmarkPhase_Triggers,
+        BenchmarkPhase_Tiles,
+        BenchmarkPhase_Structures,
+        BenchmarkPhase_Units,
+        BenchmarkPhase_Bullets,
+        BenchmarkPhase_Explosions,
+        NUM_BENCHMARKPHASES
+    } BENCHMARKPHASE;
+
+    /**
+        Adds the time since phaseStart to the benchmark time of phase and sets phaseStart to now.
+        Does nothing if the benchmark mode is off.
+        \param  phase       the phase that just ended
+        \param  phaseStart  the start time of this phase in microseconds
+    */
+    void endBenchmarkPhase(BENCHMARKPHASE phase, Uint64& phaseStart);
+
+    /**
+        Prints the time spent in every phase and the number of cycles per second to stdout.
+        \param  totalTime   the time of the whole run in microseconds
+    */
+    void printBenchmarkResults(Uint64 totalTime) const;
+
+    /**
+        Fires BENCHMARK_SALVOROUNDS salvos of BENCHMARK_SALVOSHOTS shots at the units and structures on the map
+        and prints how long Map::damage() took. This changes the game, so it is only done at the end of a benchmark.
+    */
+    void benchmarkDamageSalvo();
+
+    /// The layers of the map drawn by drawScreen() in this order
+    typedef enum {
+        DrawLayer_Ground,
+        DrawLayer_Structures,
+        DrawLayer_UndergroundUnits,
+        DrawLayer_DeadUnits,
+        DrawLayer_Infantry,
+        DrawLayer_NonInfantryGroundUnits,
+        DrawLayer_AirUnits,
+        DrawLayer_SelectionRects,
+        DrawLayer_Fog,
+        NUM_DRAWLAYERS
+    } DRAWLAYER;
+
+    /// A tile inside the visible part of the map
+    struct VisibleTile {
+        Tile*   pTile;          ///< the tile
+        int     screenX;        ///< the x coordinate of the tile on the screen
+        int     screenY;        ///< the y coordinate of the tile on the screen
+        bool    bExplored;      ///< is this tile explored by the local house?
+        bool    bFogged;        ///< is this tile fogged for the local house?
+    };
+
+    /**
+        Collects all tiles of the visible part of the map (plus one tile border) and sorts them into the buckets
+        of the layers they have something to draw in.
+    */
+    void collectVisibleTiles();
+
+    /**
+        Draws all tiles in the bucket of the layer.
+        \param  layer   the layer to draw
+    */
+    void drawLayer(DRAWLAYER layer);
+
     /**
         Checks whether the cursor is on the radar view
         \param  mouseX  x-coordinate of cursor
@@ -703,6 +855,13 @@ private:
 
 
 	Uint32      gameCycleCount;
+	Uint32      numTargetSearches;      ///< number of regular target searches granted in the current game cycle
+	Uint64      benchmarkTime[NUM_BENCHMARKPHASES];    ///< the time spent in every phase in microseconds (benchmark mode only)
+	std::vector<VisibleTile> visibleTiles;              ///< the tiles drawn in the current frame
+	std::vector<Uint32> drawLayerBuckets[NUM_DRAWLAYERS];   ///< for every layer the indices into visibleTiles of the tiles to draw
+	int         numLayerDraws[NUM_DRAWLAYERS];          ///< for every layer the number of tiles drawn in the last frame
+	Coord       visibleTopLeftTile;                     ///< the top left tile drawn in the current frame
+	Coord       visibleBottomRightTile;                 ///< the bottom right tile drawn in the current frame
 	Uint32 		nbofdays;		///< Number of days on mission
 	Uint8		dayscale;		///< Scaler for the calculus of the day length [8 -14]
 	Phase		dayphase;		///< Phase of the current day
@@ -710,6 +869,12 @@ private:
 
 	Uint32      skipToGameCycle;    ///< skip to this game cycle
 
+	SaveGameWriter saveGameWriter;  ///< writes the background saves
+	Uint64      lastSaveSnapshotTime;   ///< the time the snapshot of the last background save took in microseconds
+	Uint32      lastAutosaveCycle;  ///< the game cycle of the last autosave (or the start of the game)
+
+	std::vector<ReplayCheckpoint> replayCheckpoints;    ///< the checkpoints of the running replay sorted by game cycle
+
 	SDL_Rect	powerIndicatorPos;  ///< position of the power indicator in the right game bar
 	SDL_Rect	spiceIndicatorPos;  ///< position of the spice indicator in the right game bar
 	SDL_Rect	topBarPos;          ///< position of the top game bar
@@ -756,7 +921,7 @@ private:
 	std::list<Uint32> selectedList;                      ///< A set of all selected units/structures
 	std::list<std::pair<Uint32,Coord>>	 selectedListCoord;				///< A list of all selected units/structures coordinates
 	std::list<Uint32> selectedByOtherPlayerList;         ///< This is only used in multiplayer games where two players control one house
-    RobustList<Explosion*> explosionList;               ///< A list containing all the explosions that must be drawn
+    DenseList<Explosion*> explosionList;               ///< A list containing all the explosions that must be drawn
 
     std::vector<House*> house;                          ///< All the houses of this game, index by their houseID; has the size NUM_HOUSES; unused houses are NULL
 
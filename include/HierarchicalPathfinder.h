@@ -0,0 +1,124 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HIERARCHICALPATHFINDER_H
+#define HIERARCHICALPATHFINDER_H
+
+#include <DataTypes.h>
+
+#include <list>
+#include <vector>
+
+class UnitBase;
+class Map;
+
+#define HPA_CLUSTERSIZE         16      ///< width and height of one cluster in tiles
+#define HPA_MAXENTRANCEWIDTH    6       ///< entrances wider than this get a transition at both ends
+#define HPA_MINDISTANCE         24.0f   ///< paths shorter than this are searched with plain A*
+#define HPA_REFINEDWAYPOINTS    3       ///< number of abstract waypoints refined into tiles per query
+
+/**
+    Hierarchical path-finding A* (HPA*). The map is divided into clusters of HPA_CLUSTERSIZE x HPA_CLUSTERSIZE
+    tiles. Tiles where two neighbouring clusters are connected become transition nodes and the costs between
+    all transition nodes of one cluster are precomputed. A long path query is first solved on this small
+    abstract graph and only the first few abstract waypoints are refined into a tile path with AStarSearch.
+    When the unit has walked this partial path it simply searches again.
+
+    Only the static terrain (mountains, rock and structures) is considered for the abstract graph, units are
+    handled by the refining A* searches. Changed tiles only mark their cluster dirty; dirty clusters are rebuilt
+    on the next query.
+*/
+class HierarchicalPathfinder {
+public:
+    typedef enum {
+        MoveClass_Invalid = -1,
+        MoveClass_Ground = 0,       ///< wheeled and tracked units: blocked by mountains and structures
+        MoveClass_Infantry = 1,     ///< infantry: blocked by structures
+        MoveClass_Sand = 2,         ///< sandworms: only sand, dunes and spice
+        NUM_MOVECLASSES
+    } MOVECLASS;
+
+	HierarchicalPathfinder(Map* pMap);
+	~HierarchicalPathfinder();
+
+    /**
+        Searches a path for pUnit. If false is returned the caller should fall back to a plain A* search.
+        \param  pUnit       the unit to search the path for
+        \param  start       the start of the path
+        \param  destination the destination of the path
+        \param  path        the found path (the first part of it if the destination is far away)
+        \return true if a path was found, false if no path was found or the query is not suited for HPA*
+    */
+	bool searchPath(UnitBase* pUnit, const Coord& start, const Coord& destination, std::list<Coord>& path);
+
+    /**
+        This method is called when the passability of a tile might have changed.
+        \param  pos the position of the changed tile
+    */
+	void tileChanged(const Coord& pos);
+
+    /**
+        Returns the movement class of the specified unit.
+        \param  pUnit   the unit to check
+        \return the movement class or MoveClass_Invalid for air units
+    */
+	static MOVECLASS getMoveClass(const UnitBase* pUnit);
+
+private:
+    /// One cluster of the abstract graph
+    struct Cluster {
+        Cluster() : bDirty(true) { };
+
+        std::vector<Coord> nodes;                   ///< the transition tiles inside this cluster
+        std::vector< std::vector<Coord> > exits;    ///< for every node the tiles in neighbour clusters it leads to
+        std::vector<float> distances;               ///< nodes.size() x nodes.size() matrix of costs inside this cluster
+        bool bDirty;                                ///< does this cluster need to be rebuilt?
+    };
+
+    /// The abstract graph for one movement class
+    struct Layer {
+        Layer() : bInitialized(false) { };
+
+        std::vector<Cluster> clusters;              ///< all clusters (row by row)
+        std::vector<Sint16> nodeIndex;              ///< for every tile the index in the node list of its cluster or -1
+        bool bInitialized;                          ///< has this layer been built yet?
+    };
+
+	bool isPassable(MOVECLASS moveClass, int x, int y) const;
+	float getStepCost(MOVECLASS moveClass, int x, int y, bool bDiagonal) const;
+
+    inline int getClusterIndex(int x, int y) const {
+        return (y / HPA_CLUSTERSIZE) * numClustersX + (x / HPA_CLUSTERSIZE);
+    }
+
+    inline int getClusterIndex(const Coord& pos) const {
+        return getClusterIndex(pos.x, pos.y);
+    }
+
+	void updateLayer(MOVECLASS moveClass);
+	void rebuildCluster(MOVECLASS moveClass, int clusterIndex);
+	void addBorderTransitions(MOVECLASS moveClass, int clusterIndex, const Coord& first, const Coord& step, const Coord& outside, int length);
+	void addTransition(MOVECLASS moveClass, int clusterIndex, const Coord& node, const Coord& exit);
+	void calculateClusterDistances(MOVECLASS moveClass, int clusterIndex, const Coord& source, std::vector<float>& distances) const;
+
+	Map*    pMap;                           ///< the map this pathfinder works on
+	int     numClustersX;                   ///< number of clusters in x direction
+	int     numClustersY;                   ///< number of clusters in y direction
+	Layer   layers[NUM_MOVECLASSES];        ///< one abstract graph for every movement class
+};
+
+#endif // HIERARCHICALPATHFINDER_H
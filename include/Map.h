@@ -19,11 +19,20 @@
 #define MAP_H
 
 #include <Tile.h>
+#include <AStarSearch.h>
+#include <HierarchicalPathfinder.h>
+#include <FlowField.h>
+#include <ReachabilityIndex.h>
+#include <SpatialIndex.h>
+#include <TerrainCache.h>
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
 
 #include <units/Harvester.h>
 
+#include <unordered_map>
+#include <vector>
+
 class Map
 {
 public:
@@ -40,6 +49,124 @@ public:
 	void damage(Uint32 damagerID, House* damagerOwner, const Coord& realPos, Uint32 bulletID, float damage, int damageRadius, bool air);
 	Coord getMapPos(int angle, const Coord& source) const;
 	void removeObjectFromMap(Uint32 objectID);
+
+    /**
+        Remembers that the object was assigned to the tile at pos. Called by the tile.
+        \param  objectID    the assigned object
+        \param  pos         the position of the tile
+    */
+	void addToObjectTileIndex(Uint32 objectID, const Coord& pos);
+
+    /**
+        Forgets one assignment of the object to the tile at pos. Called by the tile.
+        \param  objectID    the unassigned object
+        \param  pos         the position of the tile
+    */
+	void removeFromObjectTileIndex(Uint32 objectID, const Coord& pos);
+
+    /**
+        Checks that the object tile index matches the object lists of all tiles. Every mismatch is printed to stderr.
+        This is expensive and only meant for debugging.
+        \return true if the index is consistent, false otherwise
+    */
+	bool checkObjectTileIndex() const;
+
+    /**
+        Adds the tile to the list of tiles that are updated every cycle. Called by the tile when it gets tracks or dead units.
+        \param pTile    the tile to add
+    */
+	void activateTile(Tile* pTile);
+
+    /**
+        Updates all tiles with tracks or dead units and removes the tiles that have nothing left to do from the list.
+    */
+	void updateActiveTiles();
+
+    /**
+        Returns the number of tiles updated by the last call of updateActiveTiles().
+        \return the number of updated tiles
+    */
+	inline int getNumUpdatedTiles() const {
+		return numUpdatedTiles;
+	}
+
+    /**
+        Marks the radar cell of the tile at pos to be repainted. Called when terrain, occupancy, ownership, exploration or fog changes.
+        \param  pos the position of the changed tile
+    */
+	void markRadarDirty(const Coord& pos);
+
+    /**
+        Marks the radar cells of all tiles the object is assigned to to be repainted.
+        \param  objectID    the object that changed
+    */
+	void markObjectRadarDirty(Uint32 objectID);
+
+    /**
+        Returns the tiles whose radar cells have changed since the last call of clearRadarDirtyTiles().
+        \return the changed tiles
+    */
+	inline const std::vector<Tile*>& getRadarDirtyTiles() const {
+		return radarDirtyTiles;
+	}
+
+    /**
+        Forgets all changed radar cells. Called by the radar after repainting them.
+    */
+	void clearRadarDirtyTiles();
+
+    /**
+        Marks the ground of the tiles around pos to be redrawn by the terrain cache.
+        \param  pos     the position of the changed tile
+        \param  radius  the number of surrounding tiles in every direction that have to be redrawn as well
+    */
+	void markTerrainDirty(const Coord& pos, int radius = 0);
+
+    /**
+        Returns the cache of the pre-drawn ground of this map.
+        \return the terrain cache
+    */
+	inline TerrainCache& getTerrainCache() {
+		return terrainCache;
+	}
+
+    /**
+        Invalidates the cached terrain tile of the tile at pos and its four neighbours. Called when the terrain type changes.
+        \param  pos the position of the changed tile
+    */
+	void invalidateTerrainTiles(const Coord& pos);
+
+    /**
+        Invalidates the cached hide tiles of the four neighbours of pos. Called when the tile at pos gets explored.
+        \param  pos     the position of the changed tile
+        \param  houseID the house the tile was explored by
+    */
+	void invalidateHideTiles(const Coord& pos, int houseID);
+
+    /**
+        Invalidates the cached fog tiles of the four neighbours of pos. Called when the tile at pos gets fogged or unfogged.
+        \param  pos     the position of the changed tile
+        \param  houseID the house the fog changed for
+    */
+	void invalidateFogTiles(const Coord& pos, int houseID);
+
+    /**
+        Registers the tile to be checked by updateFogTimeouts() when it has not been seen for FOGTIMEOUT cycles.
+        \param  pTile   the tile that was seen
+        \param  houseID the house that saw the tile
+    */
+	void addFogTimeout(Tile* pTile, int houseID);
+
+    /**
+        Fogs all tiles whose fog timeout has passed. Called once every cycle.
+    */
+	void updateFogTimeouts();
+
+    /**
+        This method is called whenever the passability of a tile might have changed (terrain type changed, structure placed or removed).
+        \param  pos the position of the changed tile
+    */
+	void tilePassabilityChanged(const Coord& pos);
     /**
         Recalculate relative coordinates list based on the leading unit
         \param  objLeader    The unit that leads
@@ -106,12 +233,85 @@ public:
 		return getTile(location.x, location.y);
 	}
 
+    /**
+        Returns the search data that is shared by all path searches on this map.
+        \return the A* search context of this map
+    */
+	inline AStarSearchContext& getAStarSearchContext() {
+		return aStarSearchContext;
+	}
+
+    /**
+        Returns the hierarchical pathfinder of this map. It is created on first use.
+        \return the hierarchical pathfinder of this map
+    */
+	HierarchicalPathfinder& getHierarchicalPathfinder() {
+		if(pHierarchicalPathfinder == NULL) {
+			pHierarchicalPathfinder = new HierarchicalPathfinder(this);
+		}
+		return *pHierarchicalPathfinder;
+	}
+
+    /**
+        Returns the flow fields shared by units that move to the same destination.
+        \return the flow field cache of this map
+    */
+	inline FlowFieldCache& getFlowFieldCache() {
+		return flowFieldCache;
+	}
+
+    /**
+        Returns the index of connected areas used to reject path queries to unreachable destinations.
+        \return the reachability index of this map
+    */
+	inline ReachabilityIndex& getReachabilityIndex() {
+		return reachabilityIndex;
+	}
+
+    /**
+        Returns the index of all objects by map area and house used for target searches.
+        \return the spatial index of this map
+    */
+	inline SpatialIndex& getSpatialIndex() {
+		return spatialIndex;
+	}
+
+    /**
+        Returns for every object the tiles it is assigned to.
+        \return the object tile index
+    */
+	inline const std::unordered_map<Uint32, std::vector<Coord> >& getObjectTileIndex() const {
+		return objectTileIndex;
+	}
+
 
 private:
 	Sint32	sizeX;                          ///< number of tiles this map is wide (read only)
 	Sint32  sizeY;                          ///< number of tiles this map is high (read only)
 	Tile*   tiles;                          ///< the 2d-array containing all the tiles of the map
 	ObjectBase* lastSinglySelectedObject;   ///< The last selected object. If selected again all units of the same type are selected
+	AStarSearchContext aStarSearchContext;  ///< reusable working data for all A* searches on this map
+	HierarchicalPathfinder* pHierarchicalPathfinder;    ///< the abstract graph for HPA* searches (NULL until first used)
+	FlowFieldCache flowFieldCache;          ///< flow fields for group move orders
+	ReachabilityIndex reachabilityIndex;    ///< connected areas for every movement class
+	std::unordered_map<Uint32, std::vector<Coord> > objectTileIndex;   ///< for every object the tiles it is assigned to (once per assignment)
+	SpatialIndex spatialIndex;              ///< the objects of every house sorted into cells of the map
+	std::vector<Tile*> activeTiles;         ///< the tiles with tracks or dead units that have to be updated every cycle
+	int     numUpdatedTiles;                ///< the number of tiles updated in the last cycle
+	std::vector<Tile*> radarDirtyTiles;     ///< the tiles whose radar cells have to be repainted
+	TerrainCache terrainCache;              ///< the pre-drawn ground of the map
+
+    /// A tile that will get fogged in the specified cycle unless it is seen again
+    struct FogTimeout {
+        FogTimeout(Uint32 cycle, Uint32 tileIndex) : cycle(cycle), tileIndex(tileIndex) { };
+
+        bool operator>(const FogTimeout& other) const { return (cycle > other.cycle); }
+
+        Uint32  cycle;          ///< the cycle the timeout is reached
+        Uint32  tileIndex;      ///< the index of the tile in tiles
+    };
+
+	std::vector<FogTimeout> fogTimeouts[NUM_HOUSES];   ///< for every house a min-heap of the tiles that are seen but not fogged yet
 
 };
 
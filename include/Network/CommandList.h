@@ -24,8 +24,14 @@
 #include <Command.h>
 
 #include <SDL.h>
+#include <algorithm>
 #include <vector>
 
+/**
+    A command list contains the commands of one player for all game cycles from firstCycle up to (excluding) endCycle.
+    Only the cycles with commands are stored. When saved, the empty cycles before each stored cycle are written as
+    one run length, so a list of mostly empty cycles only takes a few bytes.
+*/
 class CommandList {
 public:
     class CommandListEntry {
@@ -35,35 +41,32 @@ public:
 
         }
 
-        CommandListEntry(InputStream& stream) {
-            cycle = stream.readUint32();
-            Uint32 numCommands = stream.readUint32();
-            for(Uint32 i = 0; i < numCommands; i++) {
-                commands.push_back(Command(stream));
-            }
-        }
-
-        void save(OutputStream& stream) const {
-            stream.writeUint32(cycle);
-
-            stream.writeUint32((Uint32) commands.size());
-            std::vector<Command>::const_iterator iter;
-            for(iter = commands.begin(); iter != commands.end(); ++iter) {
-                iter->save(stream);
-            }
-        }
-
         Uint32      cycle;
         std::vector<Command> commands;
     };
 
-    CommandList() {
+    CommandList(Uint32 firstCycle = 0, Uint32 endCycle = 0)
+     : firstCycle(firstCycle), endCycle(endCycle) {
     }
 
     CommandList(InputStream& stream) {
+        firstCycle = stream.readUint32();
+        endCycle = stream.readUint32();
+
+        Uint32 cycle = firstCycle;
         Uint32 numCommandListEntries = stream.readUint32();
         for(Uint32 i = 0; i < numCommandListEntries; i++) {
-            commandList.push_back(CommandListEntry(stream));
+            // skip the empty cycles before this entry
+            cycle += stream.readUint32();
+
+            std::vector<Command> commands;
+            Uint32 numCommands = stream.readUint32();
+            for(Uint32 j = 0; j < numCommands; j++) {
+                commands.push_back(Command(stream));
+            }
+
+            commandList.push_back(CommandListEntry(cycle, commands));
+            cycle++;
         }
     }
 
@@ -71,16 +74,46 @@ public:
 
     }
 
-    void save(OutputStream& stream) const {
-        stream.writeUint32((Uint32) commandList.size());
+    /**
+        Saves the cycles from startCycle on to stream. The saved list starts at the later one of firstCycle and startCycle.
+        \param  stream      the stream to write to
+        \param  startCycle  the first cycle to save
+    */
+    void save(OutputStream& stream, Uint32 startCycle = 0) const {
+        Uint32 first = std::min(std::max(firstCycle, startCycle), endCycle);
 
+        stream.writeUint32(first);
+        stream.writeUint32(endCycle);
+
+        Uint32 numCommandListEntries = 0;
         std::vector<CommandListEntry>::const_iterator iter;
         for(iter = commandList.begin(); iter != commandList.end(); ++iter) {
-            iter->save(stream);
+            if(iter->cycle >= first) {
+                numCommandListEntries++;
+            }
+        }
+        stream.writeUint32(numCommandListEntries);
+
+        Uint32 cycle = first;
+        for(iter = commandList.begin(); iter != commandList.end(); ++iter) {
+            if(iter->cycle < first) {
+                continue;
+            }
+
+            stream.writeUint32(iter->cycle - cycle);
+            stream.writeUint32((Uint32) iter->commands.size());
+            std::vector<Command>::const_iterator cmdIter;
+            for(cmdIter = iter->commands.begin(); cmdIter != iter->commands.end(); ++cmdIter) {
+                cmdIter->save(stream);
+            }
+
+            cycle = iter->cycle + 1;
         }
     }
 
-    std::vector<CommandListEntry> commandList;
+    Uint32 firstCycle;                              ///< the first cycle covered by this list
+    Uint32 endCycle;                                ///< the first cycle not covered by this list anymore
+    std::vector<CommandListEntry> commandList;      ///< the cycles with commands in ascending order
 };
 
 #endif //COMMANDLIST_H
@@ -79,8 +79,37 @@ public:
 
 	void sendStartGame(unsigned int timeLeft);
 
+    /**
+        Sends the commands of the local player to all peers. Every peer only gets the cycles it has not acknowledged yet.
+        \param  commandList the commands of the local player
+    */
 	void sendCommandList(const CommandList& commandList);
 
+    /**
+        Returns the first cycle that was not acknowledged by every connected peer yet.
+        \return the first unacknowledged cycle
+    */
+	Uint32 getMinAcknowledgedCycle() const;
+
+    /**
+        Sets the first game cycle commands are exchanged for. This is the game cycle a loaded game continues at;
+        no commands before it will ever be sent, so they count as received and acknowledged.
+        \param  cycle   the first game cycle
+    */
+	void setFirstCommandCycle(Uint32 cycle);
+
+    /**
+        Returns the number of bytes sent in the last second (including the ENet protocol overhead).
+        \return bytes per second
+    */
+	Uint32 getBytesSentPerSecond() const { return bytesSentPerSecond; };
+
+    /**
+        Returns the number of bytes received in the last second (including the ENet protocol overhead).
+        \return bytes per second
+    */
+	Uint32 getBytesReceivedPerSecond() const { return bytesReceivedPerSecond; };
+
     void sendSelectedList(const std::list<Uint32>& selectedList, int groupListIndex = -1);
 
 	std::list<std::string> getConnectedPeers() const {
@@ -196,7 +225,7 @@ private:
 
 
         PeerData(ENetPeer* pPeer, PeerState peerState)
-         : pPeer(pPeer), peerState(peerState), timeout(0)  {
+         : pPeer(pPeer), peerState(peerState), timeout(0), acknowledgedCycle(0), receivedCycle(0)  {
         }
 
 
@@ -205,6 +234,9 @@ private:
         PeerState               peerState;
 		Uint32                  timeout;
 
+		Uint32                  acknowledgedCycle;  ///< the peer has received all our commands before this cycle
+		Uint32                  receivedCycle;      ///< we have received all commands of the peer before this cycle
+
         std::string             name;
 		std::list<ENetPeer*>    notYetConnectedPeers;
 	};
@@ -235,6 +267,10 @@ private:
 
 	LANGameFinderAndAnnouncer*	pLANGameFinderAndAnnouncer;
 	MetaServerClient*           pMetaServerClient;
+
+	Uint32  lastBandwidthMeasurement;   ///< the time (SDL_GetTicks()) the bandwidth was measured last
+	Uint32  bytesSentPerSecond;         ///< the bytes sent in the last measured second
+	Uint32  bytesReceivedPerSecond;     ///< the bytes received in the last measured second
 };
 
 #endif // NETWORKMANAGER_H
@@ -183,13 +183,14 @@ public:
 	inline const ObjectBase* getTarget() const { return target.getObjPointer(); }
 	inline ObjectBase* getOldTarget() { return oldtarget.getObjPointer(); }
 	inline const ObjectBase* getOldTarget() const { return oldtarget.getObjPointer(); }
+	inline Uint32 getLastDamageCycle() const { return lastDamageCycle; }
 
 	inline int getOriginalHouseID() const { return originalHouseID; }
 	virtual void setOriginalHouseID(int i) { originalHouseID = i; }
 	inline House* getOwner() { return owner; }
 	inline const House* getOwner() const { return owner; }
 
-	inline void setOwner(House* no) { owner = no; }
+	void setOwner(House* no);
 	inline SDL_Surface** getGraphic() { return graphic; }
 	inline int getGraphicID() { return graphicID; }
 	inline Sint8 getDrawnAngle() { return drawnAngle; }
@@ -259,6 +260,7 @@ protected:
 	ObjectPointer   fellow;			///< The fellow object to move to/follow (i.e leader)
 	ObjectPointer	oldfellow;      ///< A copy pointer of the fellow to fellow or move to
 	ATTACKMODE      attackMode;     ///< The attack mode of this unit/structure
+	Uint32          lastDamageCycle;    ///< The game cycle this object was damaged the last time (NONE if never)
 
     bool    visible[NUM_HOUSES];   ///< To which houses is this unit visible?
 
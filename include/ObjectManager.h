@@ -21,22 +21,36 @@
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
 
-#include <map>
+#include <deque>
+#include <vector>
 #include <SDL.h>
 
 // forward declarations
 class ObjectBase;
 
-typedef std::map<Uint32,ObjectBase*> ObjectMap;
+#define OBJECTID_SLOTBITS       16                              ///< number of bits of an object id used for the slot index
+#define OBJECTID_SLOTMASK       ((1 << OBJECTID_SLOTBITS) - 1)  ///< mask for the slot index of an object id
+#define OBJECTID_MAXGENERATION  0xFFFE                          ///< highest generation before it wraps around (0xFFFF is reserved for NONE)
 
-/// This class holds all objects (structures and units) in the game.
+/**
+    This class holds all objects (structures and units) in the game.
+
+    The objects are stored in a generational slot map: an object id consists of a slot index (lower OBJECTID_SLOTBITS bits)
+    and the generation of this slot (upper bits). Looking up an object is a plain vector access. When an object is removed
+    the generation of its slot is increased, so stale ids of removed objects do not find the next object in the same slot.
+    Free slots are reused in the order they were freed; all of this state is saved, so ids stay the same after loading.
+    The objects themselves are saved in the order of structureList and unitList and not in slot order, because after
+    a slot was reused the slot order is no longer the order the objects were created in.
+*/
 class ObjectManager{
 public:
 	/**
 		Default constructor
 	*/
-    ObjectManager() : nextFreeObjectID(1)
+    ObjectManager() : numObjects(0)
     {
+        // slot 0 is never used, so that no object gets the id 0
+        slots.push_back(Slot());
     }
 
     /**
@@ -70,12 +84,12 @@ public:
 		\return Pointer to this object (NULL if not found)
 	*/
 	inline ObjectBase* getObject(Uint32 objectID) const {
-	    ObjectMap::const_iterator iter = objectMap.find(objectID);
+	    Uint32 slotIndex = objectID & OBJECTID_SLOTMASK;
 
-	    if(iter == objectMap.end()) {
+	    if((slotIndex >= slots.size()) || (slots[slotIndex].generation != (objectID >> OBJECTID_SLOTBITS))) {
             return NULL;
 	    } else {
-            return iter->second;
+            return slots[slotIndex].pObject;
 	    }
 	}
 
@@ -84,13 +98,35 @@ public:
 		\param	ObjectID		ID of the object to remove
 		\return false if there was no object with this ObjectID, true if it could be removed
 	*/
-	bool removeObject(Uint32 objectID) {
-	    return (bool) objectMap.erase(objectID);
+	bool removeObject(Uint32 objectID);
+
+    /**
+		Returns the number of objects.
+		\return the number of objects
+	*/
+	inline Uint32 getNumObjects() const {
+        return numObjects;
 	}
 
 private:
-    Uint32 nextFreeObjectID;
-    ObjectMap objectMap;
+    /**
+		Saves one object together with its id
+		\param	stream	Stream to save to
+		\param	pObject	the object to save
+	*/
+	void saveObject(OutputStream& stream, ObjectBase* pObject) const;
+
+    /// One entry of the slot map
+    struct Slot {
+        Slot() : pObject(NULL), generation(0) { };
+
+        ObjectBase* pObject;        ///< the object in this slot or NULL if the slot is free
+        Uint32      generation;     ///< the generation of this slot; increased every time the object in it is removed
+    };
+
+    std::vector<Slot>   slots;      ///< all slots, indexed by the lower bits of the object id
+    std::deque<Uint32>  freeSlots;  ///< indices of the free slots in the order they will be reused
+    Uint32              numObjects; ///< number of objects in the slot map
 };
 
 #endif //OBJECTMANAGER_H
@@ -24,6 +24,8 @@
 
 #include <SDL.h>
 
+class Tile;
+
 
 /// This class manages the mini map at the top right corner of the screen
 class RadarView : public RadarViewBase
@@ -71,6 +73,7 @@ public:
         \param bStatus  true = switches the radar on, false = switches the radar off
 	*/
 	void setRadarMode(bool bStatus) {
+        bFullRepaint = true;
         if(bStatus == true) {
             currentRadarMode = Mode_RadarOn;
             animFrame = 0;
@@ -88,9 +91,16 @@ public:
 	*/
 	void switchRadarMode(bool bOn);
 
+    /**
+        Returns the number of radar cells repainted by the last draw() call.
+        \return the number of repainted cells
+	*/
+	int getNumRepaintedCells() const { return numRepaintedCells; }
+
 private:
 
     void updateRadarSurface(int mapSizeX, int mapSizeY, int scale, int offsetX, int offsetY);
+    void updateRadarCell(Tile* pTile, bool bRadar, int scale, int offsetX, int offsetY);
 
 	RadarViewMode currentRadarMode;         ///< the current mode of the radar
 
@@ -101,6 +111,11 @@ private:
     SDL_Surface* radarSurface;              ///< contains the image to be drawn when the radar is active
 	SDL_Surface* radarStaticAnimation;      ///< holds the animation graphic for radar static
 
+	bool bFullRepaint;                      ///< repaint all cells on the next draw instead of only the changed ones
+	bool bLastRadarOn;                      ///< was the radar of the local house on when the surface was last painted?
+	bool bLastDebug;                        ///< was the debug mode on when the surface was last painted?
+	int numRepaintedCells;                  ///< the number of cells repainted by the last draw
+
 };
 
 #endif // RADARVIEW_H
@@ -0,0 +1,128 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REACHABILITYINDEX_H
+#define REACHABILITYINDEX_H
+
+#include <DataTypes.h>
+
+#include <vector>
+
+class UnitBase;
+class Map;
+class Tile;
+
+/**
+    The reachability index stores for every movement class which tiles are connected to each other. It is the
+    generalisation of the sand regions (see Map::createSandRegions()) to all ground units and is kept up to date
+    when tiles change, so that a path query to an unreachable destination can be detected in constant time instead of
+    letting A* sweep the whole area around the destination.
+
+    Only static obstacles (mountains, rock and structures) are considered. Air units can reach every tile.
+*/
+class ReachabilityIndex {
+public:
+    typedef enum {
+        MoveClass_Invalid = -1,
+        MoveClass_Ground = 0,       ///< wheeled and tracked units: blocked by mountains and structures
+        MoveClass_Infantry = 1,     ///< infantry: blocked by structures
+        MoveClass_Sand = 2,         ///< sandworms: only sand, dunes and spice
+        NUM_MOVECLASSES
+    } MOVECLASS;
+
+	ReachabilityIndex(Map* pMap);
+	~ReachabilityIndex();
+
+    /**
+        Checks if a unit of the specified movement class can get from start to (or next to) destination.
+        \param  moveClass   the movement class to check
+        \param  start       the start position
+        \param  destination the destination; if it is blocked itself it is enough to reach a neighbour tile
+        \return true if the destination can be reached or the start position is blocked itself, false otherwise
+    */
+	bool isReachable(MOVECLASS moveClass, const Coord& start, const Coord& destination);
+
+    /**
+        Finds the tile that is closest to destination and can be reached from start.
+        \param  moveClass   the movement class to check
+        \param  start       the start position
+        \param  destination the position to get as close as possible to
+        \return the closest reachable tile (start if no other tile is reachable)
+    */
+	Coord findClosestReachableTile(MOVECLASS moveClass, const Coord& start, const Coord& destination);
+
+    /**
+        Returns the number of the connected area the specified tile belongs to.
+        \param  moveClass   the movement class
+        \param  pos         the position of the tile
+        \return the number of the area or INVALID if the tile is blocked
+    */
+	Sint32 getComponentID(MOVECLASS moveClass, const Coord& pos);
+
+    /**
+        This method is called when the passability of a tile might have changed.
+        \param  pos the position of the changed tile
+    */
+	void tileChanged(const Coord& pos);
+
+    /**
+        Forgets all components. They are rebuilt on the next query.
+    */
+	void clear();
+
+    /**
+        Returns the movement class of the specified unit.
+        \param  pUnit   the unit to check
+        \return the movement class or MoveClass_Invalid for air units
+    */
+	static MOVECLASS getMoveClass(const UnitBase* pUnit);
+
+    /**
+        Checks if the specified tile is passable for the movement class, ignoring units.
+        \param  pTile       the tile to check
+        \param  moveClass   the movement class
+        \return true if passable, false otherwise
+    */
+	static bool isPassable(const Tile* pTile, MOVECLASS moveClass);
+
+private:
+    /// The connected components of one movement class
+    struct Layer {
+        Layer() : bInitialized(false) { };
+
+        std::vector<Sint32> components;         ///< for every tile the component it belongs to or INVALID if blocked
+        std::vector<Uint32> componentSizes;     ///< the number of tiles of every component
+        bool bInitialized;                      ///< has this layer been built yet?
+    };
+
+	void updateLayer(MOVECLASS moveClass);
+	void rebuildLayer(MOVECLASS moveClass);
+	void floodFill(MOVECLASS moveClass, const Coord& start, Sint32 newComponent);
+	void tileBecamePassable(MOVECLASS moveClass, const Coord& pos);
+	void tileBecameBlocked(MOVECLASS moveClass, const Coord& pos, Sint32 oldComponent);
+
+	inline Sint32 getComponent(MOVECLASS moveClass, int x, int y) const {
+        return layers[moveClass].components[x + y*sizeX];
+	}
+
+	Map*    pMap;                           ///< the map this index belongs to
+	int     sizeX;                          ///< the width of the map
+	int     sizeY;                          ///< the height of the map
+	Layer   layers[NUM_MOVECLASSES];        ///< one set of components for every movement class
+};
+
+#endif // REACHABILITYINDEX_H
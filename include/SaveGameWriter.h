@@ -0,0 +1,82 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SAVEGAMEWRITER_H
+#define SAVEGAMEWRITER_H
+
+#include <misc/OMemoryStream.h>
+
+#include <SDL.h>
+#include <string>
+
+/**
+    The save game writer writes a snapshot of the game to disk in a background thread. The game is serialized into
+    memory by the game thread (see Game::saveGame()), the slow part - compressing the data and writing it to the
+    file - is done by this class without blocking the game.
+
+    Only one save is written at a time. If a new save is started while the last one is still being written, the game
+    thread waits for the last one to finish.
+*/
+class SaveGameWriter {
+public:
+	SaveGameWriter();
+
+	/// destructor. Waits for the running save to finish.
+	~SaveGameWriter();
+
+    /**
+        Starts writing a save game in the background. The data of headerStream and bodyStream is copied.
+        \param  filename        the file to write to
+        \param  headerStream    the uncompressed header of the save game
+        \param  bodyStream      the rest of the save game; it is stored in an OCompressedStream
+        \param  bCompress       compress the body?
+        \return true if the save was started, false otherwise
+    */
+	bool startSave(const std::string& filename, const OMemoryStream& headerStream, const OMemoryStream& bodyStream, bool bCompress);
+
+    /**
+        Checks if the background save has finished and reports errors to the news ticker. This method is called
+        by the game thread.
+    */
+	void update();
+
+    /**
+        Is a save game being written at the moment?
+        \return true if a save is running, false otherwise
+    */
+	bool isBusy() const { return (saveThread != NULL); };
+
+private:
+	void waitForSave();
+	void writeSaveGame();
+	static int saveThreadMain(void* data);
+
+	// Shared data (used by the game thread and the save thread):
+	SDL_mutex*  sharedDataMutex;    ///< This mutex must be locked before bFinished or bSuccess is read or modified
+	bool        bFinished;          ///< has the save thread finished? (\see sharedDataMutex)
+	bool        bSuccess;           ///< was the save game written successfully? (\see sharedDataMutex)
+
+	// Only used by the save thread while it is running:
+	std::string filename;           ///< the file to write to
+	std::string headerData;         ///< the uncompressed header of the save game
+	std::string bodyData;           ///< the rest of the save game
+	bool        bCompress;          ///< compress the body?
+
+	SDL_Thread* saveThread;         ///< the thread writing the save game or NULL if no save is running
+};
+
+#endif // SAVEGAMEWRITER_H
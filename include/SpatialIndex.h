@@ -0,0 +1,141 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include <DataTypes.h>
+
+#include <unordered_map>
+#include <vector>
+
+class Map;
+class ObjectBase;
+
+#define SPATIALINDEX_CELLSIZE   8                       ///< width and height of one cell in tiles
+#define SPATIALINDEX_ALLHOUSES  ((1 << NUM_HOUSES) - 1) ///< house mask that matches the objects of every house
+
+/**
+    The spatial index divides the map into cells of SPATIALINDEX_CELLSIZE x SPATIALINDEX_CELLSIZE tiles and keeps for
+    every cell and every house the objects that are assigned to one of the tiles in this cell. It is updated whenever
+    an object is assigned to or removed from a tile (see Map::addToObjectTileIndex()), so target searches only have to
+    look at the cells around the searching object instead of every tile or every object of the game.
+
+    The owner of an object is only looked up when it is added. If the owner changes objectOwnerChanged() has to be
+    called. After loading a map the objects do not exist yet, so the index is rebuilt on the first query.
+*/
+class SpatialIndex {
+public:
+	SpatialIndex(Map* pMap);
+	~SpatialIndex();
+
+    /**
+        Called when an object is assigned to the tile at pos.
+        \param  objectID    the assigned object
+        \param  pos         the position of the tile
+    */
+	void objectAssigned(Uint32 objectID, const Coord& pos);
+
+    /**
+        Called when one assignment of an object to the tile at pos is removed.
+        \param  objectID    the unassigned object
+        \param  pos         the position of the tile
+    */
+	void objectUnassigned(Uint32 objectID, const Coord& pos);
+
+    /**
+        Called when an object changed its owner.
+        \param  objectID    the object that has a new owner
+    */
+	void objectOwnerChanged(Uint32 objectID);
+
+    /**
+        Forgets all objects. The index is rebuilt from the map on the next query.
+    */
+	void clear();
+
+    /**
+        Returns all objects of the houses in houseMask that are assigned to at least one tile in the cells
+        overlapping the rectangle (x1,y1)-(x2,y2). Every object is returned once and the objects are sorted by their
+        object ID.
+        \param  x1          the left edge of the rectangle (inclusive)
+        \param  y1          the top edge of the rectangle (inclusive)
+        \param  x2          the right edge of the rectangle (inclusive)
+        \param  y2          the bottom edge of the rectangle (inclusive)
+        \param  houseMask   a bit for every house to return (1 << houseID)
+        \param  objects     the found objects are appended to this list
+    */
+	void getObjectsInRect(int x1, int y1, int x2, int y2, Uint32 houseMask, std::vector<ObjectBase*>& objects);
+
+    /**
+        Returns all objects of the houses in houseMask that are in one of the cells with a distance of exactly ring cells
+        to the cell containing center. Calling this method with ring = 0, 1, 2, ... returns the objects ordered by their
+        distance. An object that was already returned for a smaller ring around the same center is not returned again.
+        The objects of one ring are sorted by their object ID.
+        \param  center      the center of the search
+        \param  ring        the distance in cells (0 starts a new search)
+        \param  houseMask   a bit for every house to return (1 << houseID)
+        \param  objects     the found objects are appended to this list
+        \return false if the ring is completely outside the map, true otherwise
+    */
+	bool getObjectsInRing(const Coord& center, int ring, Uint32 houseMask, std::vector<ObjectBase*>& objects);
+
+    /**
+        Returns the minimal block distance between a tile in the cell of center and any tile in a cell of the specified
+        ring. Objects returned by getObjectsInRing() for this ring are at least this far away.
+        \param  ring    the distance in cells
+        \return the minimal distance in tiles
+    */
+	static inline int getRingMinDistance(int ring) {
+        return (ring <= 0) ? 0 : ((ring-1)*SPATIALINDEX_CELLSIZE + 1);
+	}
+
+private:
+    /// The objects in one cell
+    struct Cell {
+        std::vector<Uint32> objects[NUM_HOUSES];    ///< for every house the assigned objects (once per assigned tile)
+    };
+
+    /// What the index knows about one object
+    struct ObjectEntry {
+        ObjectEntry() : houseID(0), numTiles(0), queryStamp(0) { };
+
+        int     houseID;                            ///< the house the object is filed under
+        Uint32  numTiles;                           ///< the number of tile assignments of this object
+        Uint32  queryStamp;                         ///< the query this object was last returned for
+    };
+
+	void checkMapSize();
+	void rebuild();
+	void addToCell(int houseID, Uint32 objectID, const Coord& pos);
+	bool removeFromCell(int houseID, Uint32 objectID, const Coord& pos);
+	void collectCell(int cellX, int cellY, Uint32 houseMask, std::vector<ObjectBase*>& objects);
+
+	inline Cell& getCell(const Coord& pos) {
+        return cells[(pos.x / SPATIALINDEX_CELLSIZE) + (pos.y / SPATIALINDEX_CELLSIZE)*numCellsX];
+	}
+
+	Map*    pMap;                                   ///< the map this index belongs to
+	int     numCellsX;                              ///< the number of cells in x direction
+	int     numCellsY;                              ///< the number of cells in y direction
+	bool    bDirty;                                 ///< the cells have to be rebuilt before the next query
+	Uint32  queryStamp;                             ///< increased for every query to return every object only once
+	std::vector<Cell> cells;                        ///< all the cells of the map
+	std::unordered_map<Uint32, ObjectEntry> objectEntries;  ///< all objects in the index
+};
+
+#endif // SPATIALINDEX_H
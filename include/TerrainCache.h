@@ -0,0 +1,100 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TERRAINCACHE_H
+#define TERRAINCACHE_H
+
+#include <DataTypes.h>
+
+#include <SDL.h>
+#include <vector>
+
+class Map;
+
+#define TERRAINCACHE_CHUNKSIZE  16      ///< width and height of one cached chunk in tiles
+#define TERRAINCACHE_MAXCHUNKS  24      ///< maximum number of chunks kept at the same time (more only if they are all visible)
+
+/**
+    The terrain cache keeps the ground layer of the map (terrain, destroyed structures, tracks and damage) pre-drawn
+    in chunks of TERRAINCACHE_CHUNKSIZE x TERRAINCACHE_CHUNKSIZE tiles for the current zoom level. The map reports every
+    tile whose ground might look different now (see Map::markTerrainDirty()) and only these tiles are redrawn into
+    their chunk before the next frame. Drawing the ground, including scrolling, is just blitting the visible part of
+    the cached chunks.
+
+    Chunks are created when they become visible. Once more than TERRAINCACHE_MAXCHUNKS chunks exist the least recently
+    used one is freed. Changing the zoom level or the debug mode drops all chunks.
+*/
+class TerrainCache {
+public:
+	TerrainCache(Map* pMap);
+	~TerrainCache();
+
+    /**
+        Marks the tile at pos to be redrawn into its chunk before the next frame.
+        \param  pos the position of the changed tile
+    */
+	void tileChanged(const Coord& pos);
+
+    /**
+        Frees all chunks. They are redrawn when they become visible again.
+    */
+	void clear();
+
+    /**
+        Draws the ground of the specified tiles to the screen. Missing chunks are created and changed tiles redrawn first.
+        \param  pScreen         the surface to draw on
+        \param  topLeftTile     the top left visible tile
+        \param  bottomRightTile the bottom right visible tile
+    */
+	void draw(SDL_Surface* pScreen, const Coord& topLeftTile, const Coord& bottomRightTile);
+
+    /**
+        Returns the number of tiles redrawn into the cache by the last call of draw().
+        \return the number of redrawn tiles
+    */
+	inline int getNumRedrawnTiles() const {
+		return numRedrawnTiles;
+	}
+
+private:
+    /// The pre-drawn ground of TERRAINCACHE_CHUNKSIZE x TERRAINCACHE_CHUNKSIZE tiles
+    struct Chunk {
+        Chunk() : pSurface(NULL), lastUsedFrame(0) { };
+
+        SDL_Surface*        pSurface;       ///< the drawn ground or NULL if this chunk is not cached
+        std::vector<Coord>  dirtyTiles;     ///< the tiles of this chunk that have to be redrawn
+        std::vector<bool>   dirtyFlags;     ///< for every tile of this chunk if it is contained in dirtyTiles
+        Uint32              lastUsedFrame;  ///< the frame this chunk was drawn last
+    };
+
+	void createChunk(Chunk& chunk, int chunkX, int chunkY);
+	void freeChunk(Chunk& chunk);
+	void freeLeastRecentlyUsedChunk();
+	void drawTiles(SDL_Surface* pSurface, const Coord& chunkOrigin, int x1, int y1, int x2, int y2);
+
+	Map*    pMap;                   ///< the map this cache belongs to
+	int     numChunksX;             ///< the number of chunks in x direction
+	int     numChunksY;             ///< the number of chunks in y direction
+	int     zoomlevel;              ///< the zoom level the chunks are drawn for
+	bool    bDebug;                 ///< the debug mode the chunks are drawn for
+	std::vector<Chunk> chunks;      ///< all chunks of the map (empty until the first draw)
+	int     numCachedChunks;        ///< the number of chunks with a surface
+	Uint32  frameCounter;           ///< the number of calls of draw()
+	int     numRedrawnTiles;        ///< the number of tiles redrawn by the last call of draw()
+};
+
+#endif // TERRAINCACHE_H
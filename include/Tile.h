@@ -30,6 +30,7 @@
 
 
 #define DAMAGE_PER_TILE 5
+#define FOGTIMEOUT      MILLI2CYCLES(10*1000)   ///< number of game cycles after which a tile that is not seen anymore gets fogged
 
 
 // forward declarations
@@ -235,6 +236,7 @@ public:
         newDeadUnit.timer = 2000;
 
         deadUnits.push_back(newDeadUnit);
+        activate();
 	}
 
 	void assignNonInfantryGroundObject(Uint32 newObjectID);
@@ -242,11 +244,12 @@ public:
 	void assignUndergroundUnit(Uint32 newObjectID);
 
     /**
-        This method draws the terrain of this tile
-        \param xPos the x position of the left top corner of this tile on the screen
-        \param yPos the y position of the left top corner of this tile on the screen
+        This method draws the terrain of this tile. It is used by the terrain cache (see TerrainCache).
+        \param pSurface    the surface to draw on
+        \param xPos        the x position of the left top corner of this tile on pSurface
+        \param yPos        the y position of the left top corner of this tile on pSurface
     */
-	void blitGround(int xPos, int yPos);
+	void blitGround(SDL_Surface* pSurface, int xPos, int yPos);
 
     /**
         This method draws the structures.
@@ -307,6 +310,9 @@ public:
     */
 	void drawRallyPoint(ObjectBase* structure, Uint32 color, Coord size);
 
+    /**
+        Updates the tracks and dead units of this tile. Only called for active tiles (see Map::updateActiveTiles()).
+    */
 	inline void update() {
 
 	    // Performance tweak because this function is called alot (every game cycle for every tile)
@@ -322,6 +328,9 @@ public:
             for(int i=0;i<NUM_ANGLES;i++) {
                 if(tracksCounter[i] > 0) {
                     tracksCounter[i]--;
+                    if(tracksCounter[i] == 0) {
+                        markTerrainDirty();
+                    }
                 }
             }
         }
@@ -336,12 +345,29 @@ public:
         }
     }
 
+    /**
+        Checks if this tile has tracks or dead units that still have to be updated.
+        \return true if update() has something to do, false otherwise
+    */
+	inline bool needsUpdate() const {
+        for(int i=0;i<NUM_ANGLES;i++) {
+            if(tracksCounter[i] > 0) {
+                return true;
+            }
+        }
+        return !deadUnits.empty();
+	}
+
 	void clearTerrain();
 
 	inline void setTrack(Uint8 direction) {
 	    if(type == Terrain_Sand || type == Terrain_Dunes
             || type == Terrain_Spice || type == Terrain_ThickSpice) {
+            if(tracksCounter[direction] == 0) {
+                markTerrainDirty();
+            }
             tracksCounter[direction] = 5000;
+            activate();
 	    }
     }
 	void selectAllPlayersUnits(int houseID, ObjectBase** lastCheckedObject, ObjectBase** lastSelectedObject, ObjectBase* groupLeader) ;
@@ -449,12 +475,25 @@ public:
 	*/
 	inline void setExplored(int houseID, Uint32 cycle) {
         lastAccess[houseID] = cycle;
-        explored[houseID] = true;
+        if(!explored[houseID] || fogTimedOut[houseID]) {
+            exploredStateChanged(houseID);
+        }
     }
 
+    /**
+        Checks if the fog timeout of this tile has passed for this house. Called by the map when the timeout registered
+        with Map::addFogTimeout() is reached.
+        \param  houseID the house to check
+        \param  cycle   the current game cycle
+        \return true if the tile is fogged now, false if it has been seen again in the meantime
+    */
+	bool updateFogTimeout(int houseID, Uint32 cycle);
+
+	inline Uint32 getLastAccess(int houseID) const { return lastAccess[houseID]; }
+
 	inline void setOwner(int newOwner) { owner = newOwner; }
 	inline void setSandRegion(int newSandRegion) { sandRegion = newSandRegion; }
-	inline void setDestroyedStructureTile(int newDestroyedStructureTile) { destroyedStructureTile = newDestroyedStructureTile; };
+	void setDestroyedStructureTile(int newDestroyedStructureTile);
 
 	inline bool hasAGroundObject() const { return (hasInfantry() || hasANonInfantryGroundObject()); }
 	inline bool hasAnAirUnit() const { return !assignedAirUnitList.empty(); }
@@ -462,6 +501,7 @@ public:
 	inline bool hasANonInfantryGroundObject() const { return !assignedNonInfantryGroundObjectList.empty(); }
 	bool hasAStructure() const;
 	inline bool hasInfantry() const { return !assignedInfantryList.empty(); }
+	inline bool hasDeadUnits() const { return !deadUnits.empty(); }
     inline bool hasAnObject() { return (hasAGroundObject() || hasAnAirUnit() || hasAnUndergroundUnit()); }
 
 	inline bool hasSpice() const { return (fixFloat(spice) > 0.0f); }
@@ -512,6 +552,10 @@ public:
 	int getTerrainTile() const;
     int getHideTile(int houseID) const;
     int getFogTile(int houseID) const;
+
+	inline void invalidateTerrainTile() { terrainTile = INVALID; }
+	inline void invalidateHideTile(int houseID) { hideTile[houseID] = INVALID; }
+	inline void invalidateFogTile(int houseID) { fogTile[houseID] = INVALID; }
     int getDestroyedStructureTile() const { return  destroyedStructureTile; };
 
     bool isBlocked() const {
@@ -519,20 +563,39 @@ public:
     }
 
 
-    void addDamage(Uint32 damageType, int tile, Coord realPos) {
-        if(damage.size() < DAMAGE_PER_TILE) {
-            DAMAGETYPE newDamage;
-            newDamage.tile = tile;
-            newDamage.damageType = damageType;
-            newDamage.realPos = realPos;
-
-            damage.push_back(newDamage);
-        }
-    }
+    void addDamage(Uint32 damageType, int tile, Coord realPos);
 
 	Coord	location;   ///< location of this tile in map coordinates
+	bool	bActive;    ///< is this tile in the list of tiles that are updated every cycle? (maintained by the map)
+	bool	bRadarDirty;    ///< is this tile in the list of tiles whose radar cells have to be repainted? (maintained by the map)
 
 private:
+    /**
+        Adds this tile to the list of tiles that are updated every cycle.
+    */
+	void activate();
+
+    /**
+        Marks this tile to be redrawn by the terrain cache.
+    */
+	void markTerrainDirty();
+
+    /**
+        Marks this tile as explored and not fogged for this house and invalidates the hide and fog tiles of the neighbours.
+        \param  houseID the house that sees this tile
+    */
+	void exploredStateChanged(int houseID);
+
+	int computeTerrainTile() const;
+	int computeHideTile(int houseID) const;
+	int computeFogTile(int houseID) const;
+
+    /**
+        Removes all occurrences of objectID from objectList and keeps the object tile index of the map up to date.
+        \param objectList  the list to remove from
+        \param objectID    the object to remove
+    */
+	void removeFromList(std::list<Uint32>& objectList, Uint32 objectID);
 
 	Uint32  	type;   ///< the type of the tile (Terrain_Sand, Terrain_Rock, ...)
 
@@ -558,6 +621,11 @@ private:
 
 	Uint32      lastAccess[NUM_HOUSES];    ///< contains for every house when this tile was seen last by this house
 	bool        explored[NUM_HOUSES];      ///< contains for every house if this tile is explored
+	bool        fogTimedOut[NUM_HOUSES];   ///< contains for every house if this tile has not been seen for FOGTIMEOUT cycles (maintained by the map)
+
+	mutable Sint16  terrainTile;            ///< cached result of getTerrainTile() or INVALID if it has to be recomputed
+	mutable Sint8   hideTile[NUM_HOUSES];   ///< cached result of getHideTile() for every house or INVALID
+	mutable Sint8   fogTile[NUM_HOUSES];    ///< cached result of getFogTile() for every house or INVALID
 };
 
 
@@ -67,6 +67,11 @@ public:
     */
     const std::list<std::shared_ptr<Trigger> >& getTriggers() const { return triggers; };
 
+    /**
+        Removes all triggers.
+    */
+    void clear() { triggers.clear(); };
+
 private:
     std::list<std::shared_ptr<Trigger> > triggers;  ///< list of all triggers. sorted by the time when they shall be triggered.
 
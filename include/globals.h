@@ -22,7 +22,7 @@
 #include <Definitions.h>
 #include <FileClasses/Palette.h>
 #include <data.h>
-#include <misc/RobustList.h>
+#include <misc/DenseList.h>
 #include <SDL.h>
 
 
@@ -104,15 +104,19 @@ EXTERN Map*                 currentGameMap;             ///< the map for the cur
 EXTERN House*		        pLocalHouse;                ///< the house of the human player that is playing the current running game on this computer
 EXTERN HumanPlayer*         pLocalPlayer;               ///< the player that is playing the current running game on this computer
 
-EXTERN RobustList<UnitBase*>       unitList;           ///< the list of all units
-EXTERN RobustList<StructureBase*>  structureList;      ///< the list of all structures
-EXTERN RobustList<Bullet*>     bulletList;         ///< the list of all bullets
+EXTERN DenseList<UnitBase*>       unitList;           ///< the list of all units
+EXTERN DenseList<StructureBase*>  structureList;      ///< the list of all structures
+EXTERN DenseList<Bullet*>     bulletList;         ///< the list of all bullets
 
 
 // misc
 EXTERN SettingsClass    settings;                       ///< the settings read from the settings file
 
 EXTERN bool debug;                                      ///< is set for debugging purposes
+EXTERN int replayPathfinding;                           ///< pathfinding for replays: 0 = as recorded, 1 = A*, 2 = HPA* (set by --Pathfinding=)
+EXTERN bool bHeadless;                                  ///< run a replay without window, sound and user input (set by --headless)
+EXTERN bool bBenchmark;                                 ///< time the phases of every game cycle and print them at the end (set by --bench)
+EXTERN bool bCheckReplay;                               ///< check that restored replay checkpoints reproduce the replay (set by --checkreplay)
 
 
 // constants
@@ -0,0 +1,53 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include <SDL.h>
+#include <stdlib.h>
+
+/**
+    Returns the maximum size compressData() may need for srcLength bytes of input.
+    \param  srcLength   the length of the uncompressed data
+    \return the size the destination buffer should have
+*/
+size_t getMaxCompressedSize(size_t srcLength);
+
+/**
+    Compresses a block of data with a simple LZ77 scheme (the block format of LZ4: a token with the literal and match
+    length, the literals and a 16-bit offset for every sequence). It is fast enough to be used for every save game and
+    replay and does not need any external library.
+    \param  pSrc        the data to compress
+    \param  srcLength   the length of the data to compress
+    \param  pDst        the buffer for the compressed data
+    \param  dstCapacity the size of pDst
+    \return the length of the compressed data or 0 if it does not fit into dstCapacity bytes
+*/
+size_t compressData(const Uint8* pSrc, size_t srcLength, Uint8* pDst, size_t dstCapacity);
+
+/**
+    Decompresses a block of data compressed with compressData().
+    \param  pSrc        the compressed data
+    \param  srcLength   the length of the compressed data
+    \param  pDst        the buffer for the uncompressed data
+    \param  dstLength   the length of the uncompressed data
+    \return true if the data was decompressed successfully, false if it is corrupt
+*/
+bool decompressData(const Uint8* pSrc, size_t srcLength, Uint8* pDst, size_t dstLength);
+
+#endif // COMPRESSION_H
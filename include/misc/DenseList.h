@@ -0,0 +1,316 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DENSELIST_H
+#define DENSELIST_H
+
+#include <algorithm>
+#include <vector>
+#include <stdlib.h>
+
+/**
+	A list of pointers that stores its elements in one contiguous array. Like RobustList it may be modified while
+	iterating through it, but the iterators do not have to register at the list:
+	- removed elements are only marked as removed (set to NULL) and skipped by the iterators; they are erased by compact()
+	- elements added with push_back() while iterating are visited by the running iteration (as with RobustList)
+
+	The iteration order is the order the elements were added in. compact() keeps this order and must not be called
+	while iterating through the list. NULL must not be added to the list.
+*/
+template<typename T>
+class DenseList {
+public:
+	class const_iterator;
+
+	/// The iterator of a DenseList
+	class iterator {
+	public:
+		/**
+			Default constructor. The iterator points at the end of no list.
+		*/
+		iterator() : pList(NULL), index(0) {
+		}
+
+		/**
+			This operator returns the element the iterator is currently pointing to. If this element was removed
+			while iterating, NULL is returned.
+			\return a reference to the element the iterator is currently pointing to
+		*/
+		T& operator*() const {
+			return pList->elements[index];
+		}
+
+		/**
+			This operator returns a pointer to the element the iterator is currently pointing to
+			\return a pointer to the element the iterator is currently pointing to
+		*/
+		T* operator->() const {
+			return &(pList->elements[index]);
+		}
+
+		/**
+			This operator advances to the next element that was not removed.
+			\return A reference to this iterator
+		*/
+		iterator& operator++() {
+			index++;
+			skipRemoved();
+			return *this;
+		}
+
+		/**
+			This operator advances to the next element that was not removed.
+		*/
+		void operator++(int) {
+			operator++();
+		}
+
+		/**
+			This operator compares to iterators.
+			\param	x	the other iterator
+			\return	true if both iterators point to the same element or are both at the end, false otherwise
+		*/
+		bool operator==(const iterator& x) const {
+			if(isEnd() || x.isEnd()) {
+				return (isEnd() == x.isEnd());
+			}
+			return (index == x.index);
+		}
+
+		/**
+			This operator compares to iterators.
+			\param	x	the other iterator
+			\return	false if both iterators point to the same element or are both at the end, true otherwise
+		*/
+		bool operator!=(const iterator& x) const {
+			return !(operator==(x));
+		}
+
+	private:
+		iterator(DenseList<T>* pList, size_t index) : pList(pList), index(index) {
+			skipRemoved();
+		}
+
+		/// the end is checked against the current size, so elements added while iterating are visited
+		bool isEnd() const {
+			return ((pList == NULL) || (index >= pList->elements.size()));
+		}
+
+		void skipRemoved() {
+			while((index < pList->elements.size()) && (pList->elements[index] == NULL)) {
+				index++;
+			}
+		}
+
+		friend class DenseList<T>;
+		friend class const_iterator;
+
+		DenseList<T>* pList;    ///< the list iterated through (NULL for the end iterator)
+		size_t index;           ///< the index of the current element in the list
+	};
+
+	/// The const iterator of a DenseList
+	class const_iterator {
+	public:
+		/**
+			Default constructor. The iterator points at the end of no list.
+		*/
+		const_iterator() : pList(NULL), index(0) {
+		}
+
+		/**
+			Copy constructor.
+		*/
+		const_iterator(const iterator& x) : pList(x.pList), index(x.index) {
+		}
+
+		/**
+			This operator returns the element the iterator is currently pointing to. If this element was removed
+			while iterating, NULL is returned.
+			\return a reference to the element the iterator is currently pointing to
+		*/
+		const T& operator*() const {
+			return pList->elements[index];
+		}
+
+		/**
+			This operator returns a pointer to the element the iterator is currently pointing to
+			\return a pointer to the element the iterator is currently pointing to
+		*/
+		const T* operator->() const {
+			return &(pList->elements[index]);
+		}
+
+		/**
+			This operator advances to the next element that was not removed.
+			\return A reference to this iterator
+		*/
+		const_iterator& operator++() {
+			index++;
+			skipRemoved();
+			return *this;
+		}
+
+		/**
+			This operator advances to the next element that was not removed.
+		*/
+		void operator++(int) {
+			operator++();
+		}
+
+		/**
+			This operator compares to iterators.
+			\param	x	the other iterator
+			\return	true if both iterators point to the same element or are both at the end, false otherwise
+		*/
+		bool operator==(const const_iterator& x) const {
+			if(isEnd() || x.isEnd()) {
+				return (isEnd() == x.isEnd());
+			}
+			return (index == x.index);
+		}
+
+		/**
+			This operator compares to iterators.
+			\param	x	the other iterator
+			\return	false if both iterators point to the same element or are both at the end, true otherwise
+		*/
+		bool operator!=(const const_iterator& x) const {
+			return !(operator==(x));
+		}
+
+	private:
+		const_iterator(const DenseList<T>* pList, size_t index) : pList(pList), index(index) {
+			skipRemoved();
+		}
+
+		/// the end is checked against the current size, so elements added while iterating are visited
+		bool isEnd() const {
+			return ((pList == NULL) || (index >= pList->elements.size()));
+		}
+
+		void skipRemoved() {
+			while((index < pList->elements.size()) && (pList->elements[index] == NULL)) {
+				index++;
+			}
+		}
+
+		friend class DenseList<T>;
+
+		const DenseList<T>* pList;  ///< the list iterated through (NULL for the end iterator)
+		size_t index;               ///< the index of the current element in the list
+	};
+
+	/**
+		Default constructor
+	*/
+	DenseList() : numElements(0) {
+	}
+
+	/**
+		Returns the number of elements currently stored in the list (without the removed ones).
+		\return number of elements in the list
+	*/
+	int size() const {
+		return numElements;
+	}
+
+	/**
+		Checks whether this list is empty.
+		\returns true if the number of elements is zero, false otherwise.
+	*/
+	bool empty() const {
+		return (numElements == 0);
+	}
+
+	/**
+		Adds the element x at the end of the list.
+		\param	x	Element to add (must not be NULL)
+	*/
+	void push_back(const T& x) {
+		elements.push_back(x);
+		numElements++;
+	}
+
+	/**
+		Removes the element value from the list. The element is only marked as removed until compact() is called.
+		\param	value	value to remove
+	*/
+	void remove(const T& value) {
+		typename std::vector<T>::iterator iter = std::find(elements.begin(), elements.end(), value);
+		if(iter != elements.end()) {
+			*iter = NULL;
+			numElements--;
+		}
+	}
+
+	/**
+		Erases all elements from this list.
+	*/
+	void clear() {
+		elements.clear();
+		numElements = 0;
+	}
+
+	/**
+		Erases the removed elements from the array. The order of the remaining elements is not changed.
+		This method must not be called while iterating through the list.
+	*/
+	void compact() {
+		if(elements.size() != (size_t) numElements) {
+			elements.erase(std::remove(elements.begin(), elements.end(), (T) NULL), elements.end());
+		}
+	}
+
+	/**
+		Returns an iterator that references the beginning of the list.
+		\return	Iterator that points to the beginning of the list
+	*/
+	iterator begin() {
+		return iterator(this, 0);
+	}
+
+	/**
+		Returns an const iterator that references the beginning of the list.
+		\return	Iterator that points to the beginning of the list
+	*/
+	const_iterator begin() const {
+		return const_iterator(this, 0);
+	}
+
+	/**
+		Returns an iterator that references a position just past the last element in the list.
+		\return	Iterator that points to the end of the list
+	*/
+	iterator end() {
+		return iterator();
+	}
+
+	/**
+		Returns an const iterator that references a position just past the last element in the list.
+		\return	Iterator that points to the end of the list
+	*/
+	const_iterator end() const {
+		return const_iterator();
+	}
+
+private:
+	std::vector<T> elements;    ///< all elements in the order they were added; removed elements are NULL
+	int numElements;            ///< the number of elements that are not removed
+};
+
+#endif // DENSELIST_H
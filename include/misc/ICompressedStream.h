@@ -0,0 +1,61 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ICOMPRESSEDSTREAM_H
+#define ICOMPRESSEDSTREAM_H
+
+#include "InputStream.h"
+#include <stdlib.h>
+#include <string>
+
+/**
+    Reads data written by OCompressedStream from another stream. The blocks are read and decompressed when needed.
+*/
+class ICompressedStream : public InputStream
+{
+public:
+    /**
+        Constructor
+        \param  pStream     the stream to read the blocks from
+        \param  bOwnStream  true = pStream is deleted by this stream's destructor
+    */
+	ICompressedStream(InputStream* pStream, bool bOwnStream = false);
+
+	/// destructor
+	~ICompressedStream();
+
+	std::string readString();
+
+	Uint8 readUint8();
+	Uint16 readUint16();
+	Uint32 readUint32();
+	Uint64 readUint64();
+	bool readBool();
+	float readFloat();
+	Coord readCoord();
+
+private:
+	void readBuffered(void* pData, size_t length);
+	void readBlock();
+
+	InputStream*    pStream;            ///< the stream the blocks are read from
+	bool            bOwnStream;         ///< delete pStream in the destructor?
+	std::string     block;              ///< the current uncompressed block
+	size_t          blockPos;           ///< the next byte to read from block
+};
+
+#endif // ICOMPRESSEDSTREAM_H
@@ -22,6 +22,11 @@
 #include <stdlib.h>
 #include <string>
 
+#define IFILESTREAM_BUFFERSIZE  (64*1024)   ///< the size of the read buffer
+
+/**
+    Reads from a file. The file is read in blocks of IFILESTREAM_BUFFERSIZE bytes into an internal buffer.
+*/
 class IFileStream : public InputStream
 {
 public:
@@ -43,7 +48,12 @@ public:
 	Coord readCoord();
 
 private:
-	FILE* fp;
+	void readBuffered(void* pData, size_t length, const char* pFunctionName);
+
+	FILE*   fp;
+	char*   pBuffer;        ///< the read buffer (IFILESTREAM_BUFFERSIZE bytes)
+	size_t  bufferPos;      ///< the next byte to read from pBuffer
+	size_t  bufferFill;     ///< the number of valid bytes in pBuffer
 };
 
 #endif // IFILESTREAM_H
@@ -0,0 +1,82 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OCOMPRESSEDSTREAM_H
+#define OCOMPRESSEDSTREAM_H
+
+#include "OutputStream.h"
+#include <stdlib.h>
+#include <string>
+
+#define COMPRESSEDSTREAM_BLOCKSIZE  (64*1024)   ///< the maximum number of uncompressed bytes in one block
+
+/// The ways a block of a compressed stream can be stored
+typedef enum {
+    CompressionMethod_None = 0,     ///< the block is stored uncompressed
+    CompressionMethod_LZ = 1        ///< the block is compressed with compressData()
+} COMPRESSIONMETHOD;
+
+/**
+    Writes all data in blocks of up to COMPRESSEDSTREAM_BLOCKSIZE bytes to another stream. Every block is written as
+    Uint8 method (see COMPRESSIONMETHOD), Uint32 uncompressed length and the (compressed) data as a string. A block is
+    written when it is full or when flush() is called. Use ICompressedStream to read the data back.
+*/
+class OCompressedStream : public OutputStream
+{
+public:
+    /**
+        Constructor
+        \param  pStream     the stream to write the blocks to
+        \param  bCompress   true = compress the blocks, false = only store them (faster, bigger)
+        \param  bOwnStream  true = pStream is deleted by this stream's destructor
+    */
+	OCompressedStream(OutputStream* pStream, bool bCompress = true, bool bOwnStream = false);
+
+	/// destructor. Writes the last block.
+	~OCompressedStream();
+
+    /**
+        Writes the current block and flushes the underlying stream.
+    */
+	virtual void flush();
+
+	// write operations
+
+	void writeString(const std::string& str);
+
+	void writeUint8(Uint8 x);
+	void writeUint16(Uint16 x);
+	void writeUint32(Uint32 x);
+	void writeUint64(Uint64 x);
+	void writeBool(bool x);
+	void writeFloat(float x);
+	void writeCoord(Coord c);
+	void writeData(const void* pData, size_t length);
+
+private:
+	void writeBuffered(const void* pData, size_t length);
+	void writeBlock();
+
+	OutputStream*   pStream;            ///< the stream the blocks are written to
+	bool            bCompress;          ///< compress the blocks?
+	bool            bOwnStream;         ///< delete pStream in the destructor?
+	char*           pBuffer;            ///< the current block (COMPRESSEDSTREAM_BLOCKSIZE bytes)
+	size_t          bufferPos;          ///< the number of bytes in pBuffer
+	std::string     compressedBlock;    ///< reused buffer for the compressed data
+};
+
+#endif // OCOMPRESSEDSTREAM_H
@@ -22,6 +22,12 @@
 #include <stdlib.h>
 #include <string>
 
+#define OFILESTREAM_BUFFERSIZE  (64*1024)   ///< the size of the write buffer
+
+/**
+    Writes to a file. All writes go to an internal buffer that is written to the file when it is full, when flush()
+    is called or when the file is closed, so that saving does not need one fwrite per value.
+*/
 class OFileStream : public OutputStream
 {
 public:
@@ -45,9 +51,15 @@ public:
 	void writeBool(bool x);
 	void writeFloat(float x);
 	void writeCoord(Coord c);
+	void writeData(const void* pData, size_t length);
 
 private:
-	FILE* fp;
+	void writeBuffered(const void* pData, size_t length);
+	bool writeBuffer();
+
+	FILE*   fp;
+	char*   pBuffer;        ///< the write buffer (OFILESTREAM_BUFFERSIZE bytes)
+	size_t  bufferPos;      ///< the number of bytes in pBuffer
 };
 
 #endif // OFILESTREAM_H
@@ -20,6 +20,7 @@
 
 #include "OutputStream.h"
 #include <stdlib.h>
+#include <string.h>
 #include <string>
 
 class OMemoryStream : public OutputStream
@@ -50,7 +51,7 @@ public:
     }
 
     size_t getDataLength() const {
-        return (bReadOnly == true) ? bufferSize : currentPos;
+        return currentPos;
     }
 
 	void flush() {
@@ -109,6 +110,12 @@ public:
         writeUint32(tmp);
     }
 
+	void writeData(const void* pData, size_t length) {
+        ensureBufferSize(currentPos + length);
+        memcpy(pBuffer + currentPos, pData, length);
+        currentPos += length;
+	}
+
 	void writeCoord(Coord c) {
         ensureBufferSize(currentPos + sizeof(Uint32));
         c.x = SDL_SwapLE32(c.x);
@@ -0,0 +1,127 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <stdlib.h>
+#include <type_traits>
+#include <vector>
+
+/**
+	A pool for objects of type T that are created and destroyed very often (e.g. bullets). The memory is taken from
+	chunks of objectsPerChunk objects and freed objects are kept in a free list for the next allocation, so creating
+	and destroying an object does not go through malloc/free. The chunks are only freed when the pool is destroyed.
+
+	The pool only provides the memory; it is meant to be used in the class specific operator new and operator delete of T.
+	Which memory an object gets has no influence on the game, so the construction order stays deterministic.
+*/
+template<typename T>
+class ObjectPool {
+public:
+	/**
+		Constructor
+		\param	objectsPerChunk	the number of objects allocated at once when the free list is empty
+	*/
+	ObjectPool(size_t objectsPerChunk = 256)
+	 : objectsPerChunk(objectsPerChunk), pFreeList(NULL), numLive(0), numAllocations(0) {
+	}
+
+	/**
+		Destructor. Frees all chunks.
+	*/
+	~ObjectPool() {
+		for(size_t i = 0; i < chunks.size(); i++) {
+			delete[] chunks[i];
+		}
+	}
+
+	/**
+		Returns memory for one object of type T.
+		\return	the memory (never NULL)
+	*/
+	void* allocate() {
+		if(pFreeList == NULL) {
+			addChunk();
+		}
+
+		Slot* pSlot = pFreeList;
+		pFreeList = pSlot->pNext;
+		numLive++;
+		numAllocations++;
+		return pSlot;
+	}
+
+	/**
+		Gives the memory of an object back to the pool.
+		\param	p	the memory returned by allocate() (may be NULL)
+	*/
+	void release(void* p) {
+		if(p == NULL) {
+			return;
+		}
+
+		Slot* pSlot = static_cast<Slot*>(p);
+		pSlot->pNext = pFreeList;
+		pFreeList = pSlot;
+		numLive--;
+	}
+
+	/**
+		Returns the number of objects currently allocated from this pool.
+		\return	the number of live objects
+	*/
+	size_t getNumLive() const { return numLive; }
+
+	/**
+		Returns the number of objects this pool can hold without allocating another chunk.
+		\return	the capacity of all chunks
+	*/
+	size_t getCapacity() const { return chunks.size() * objectsPerChunk; }
+
+	/**
+		Returns the number of allocate() calls since the pool was created.
+		\return	the number of allocations
+	*/
+	size_t getNumAllocations() const { return numAllocations; }
+
+private:
+	/// The memory of one object. While the object is not allocated it links to the next free slot.
+	union Slot {
+		Slot* pNext;                                                            ///< the next free slot
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;     ///< the memory for the object
+	};
+
+	void addChunk() {
+		Slot* pChunk = new Slot[objectsPerChunk];
+		chunks.push_back(pChunk);
+
+		// the slots are handed out in the order of the chunk
+		for(size_t i = objectsPerChunk; i > 0; i--) {
+			pChunk[i-1].pNext = pFreeList;
+			pFreeList = &pChunk[i-1];
+		}
+	}
+
+	size_t objectsPerChunk;     ///< the number of objects allocated at once
+	std::vector<Slot*> chunks;  ///< all allocated chunks
+	Slot* pFreeList;            ///< the first free slot or NULL
+	size_t numLive;             ///< the number of allocated objects
+	size_t numAllocations;      ///< the number of allocate() calls
+};
+
+#endif // OBJECTPOOL_H
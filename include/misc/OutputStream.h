@@ -51,6 +51,19 @@ public:
 	virtual void writeFloat(float x) = 0;
 	virtual void writeCoord(Coord c) = 0;
 
+    /**
+        Writes out raw bytes without any length information. Streams with a buffer override this method to copy
+        the data in one go.
+        \param pData   the data to write out
+        \param length  the number of bytes to write out
+	*/
+	virtual void writeData(const void* pData, size_t length) {
+        const Uint8* p = (const Uint8*) pData;
+        for(size_t i = 0; i < length; i++) {
+            writeUint8(p[i]);
+        }
+	}
+
     /**
         Writes out a Sint8 value.
         \param x    the value to write out
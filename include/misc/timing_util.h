@@ -0,0 +1,34 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TIMING_UTIL_H
+#define TIMING_UTIL_H
+
+#include <SDL.h>
+
+#include <chrono>
+
+/**
+    Returns a timestamp in microseconds for measuring how long something takes. Unlike SDL_GetTicks() it is
+    precise enough to time single game cycles or AI updates. Only differences of two timestamps are meaningful.
+    \return the current time in microseconds
+*/
+inline Uint64 getMicroseconds() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif // TIMING_UTIL_H
@@ -22,6 +22,8 @@
 
 #include <DataTypes.h>
 
+#include <vector>
+
 class AIPlayer : public Player
 {
 public:
@@ -51,12 +53,24 @@ public:
         return new AIPlayer(stream, associatedHouse);
 	}
 
+    /// \return the time in microseconds the last AI update took
+    inline Uint32 getLastUpdateTime() const { return lastUpdateTime; };
+
+    /// \return the time in microseconds the longest AI update took
+    inline Uint32 getMaxUpdateTime() const { return maxUpdateTime; };
+
+    /// \return the time in microseconds all AI updates took together
+    inline Uint64 getTotalUpdateTime() const { return totalUpdateTime; };
+
+    /// \return the number of AI updates so far
+    inline Uint32 getNumUpdates() const { return numUpdates; };
 
 private:
 	AIPlayer(House* associatedHouse, std::string playername, Uint8 difficulty);
 	AIPlayer(InputStream& stream, House* associatedHouse);
 
      void scrambleUnitsAndDefend(const ObjectBase* pIntruder, Uint8 number = 3);
+     void scrambleIdleUnitsAndDefend(const ObjectBase* pIntruder, Uint8 number, const std::vector<const UnitBase*>& idleUnits);
      void scrambleUnitsAndDefendFromWorm(const ObjectBase* pIntruder, Uint8 number);
 
 	Coord findPlaceLocation(Uint32 itemID);
@@ -79,6 +93,11 @@ private:
     Sint32  buildTimer;     ///< When to build the next structure/unit
 
 	std::list<Coord> placeLocations;    ///< Where to place structures
+
+	Uint32  lastUpdateTime;     ///< duration of the last AI update in microseconds (not saved)
+	Uint32  maxUpdateTime;      ///< duration of the longest AI update in microseconds (not saved)
+	Uint64  totalUpdateTime;    ///< duration of all AI updates in microseconds (not saved)
+	Uint32  numUpdates;         ///< number of AI updates (not saved)
 };
 
 #endif //AIPLAYER_H
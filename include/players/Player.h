@@ -21,7 +21,7 @@
 #include <DataTypes.h>
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
-#include <misc/RobustList.h>
+#include <misc/DenseList.h>
 #include <structures/StarPort.h>
 
 class GameInitSettings;
@@ -78,8 +78,8 @@ protected:
     const Map& getMap() const;
     const ObjectBase* getObject(Uint32 objectID) const;
 
-    const RobustList<const StructureBase*>& getStructureList() const;
-    const RobustList<const UnitBase*>& getUnitList() const;
+    const DenseList<const StructureBase*>& getStructureList() const;
+    const DenseList<const UnitBase*>& getUnitList() const;
 
     const House* getHouse(int houseID) const;
 
@@ -27,38 +27,36 @@
 
 #define MAX_NODES_CHECKED   (128*128)
 
-AStarSearch::AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destination) {
-    sizeX = pMap->getSizeX();
-    sizeY = pMap->getSizeY();
+AStarSearch::AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destination)
+ : sizeX(pMap->getSizeX()), sizeY(pMap->getSizeY()), bestCoord(Coord::Invalid()),
+   pOwnContext(pMap->getAStarSearchContext().isInUse() ? new AStarSearchContext() : NULL),
+   context((pOwnContext != NULL) ? *pOwnContext : pMap->getAStarSearchContext()) {
 
-    mapData = (TileData*) calloc(sizeX*sizeY, sizeof(TileData));
-    if(mapData == NULL) {
-        throw std::bad_alloc();
-    }
+    context.beginSearch(sizeX, sizeY);
 
     float heuristic = blockDistance(start, destination);
     float smallestHeuristic = heuristic;
-    bestCoord = Coord::Invalid();
 
     //if the unit is not directly next to its destination or it is and the destination is unblocked
 	if ((heuristic > 1.5f) || (pUnit->canPass(destination.x, destination.y) == true)) {
 
-        putOnOpenListIfBetter(start, Coord::Invalid(), 0.0f, heuristic);
+        putOnOpenListIfBetter(getIndex(start), INVALID_POS, 0.0f, heuristic);
 
         std::vector<short> depthCheckCount(std::min(sizeX, sizeY));
 
         int numNodesChecked = 0;
-        while(openList.empty() == false) {
-            Coord currentCoord = extractMin();
-        	getMapData(currentCoord).bReached=false;
+        while(context.openList.empty() == false) {
+            Sint32 currentIndex = extractMin();
+            Coord currentCoord = getCoord(currentIndex);
+        	setReached(currentIndex, false);
 
-            if (getMapData(currentCoord).h < smallestHeuristic) {
-				smallestHeuristic = getMapData(currentCoord).h;
+            if (context.h[currentIndex] < smallestHeuristic) {
+				smallestHeuristic = context.h[currentIndex];
 				bestCoord = currentCoord;
 
 				if(currentCoord == destination) {
                     // destination found
-                	getMapData(currentCoord).bReached=true;
+                	setReached(currentIndex, true);
                     break;
 				}
 			}
@@ -69,7 +67,7 @@ AStarSearch::AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destinat
                     Coord nextCoord = pMap->getMapPos(angle, currentCoord);
                     if(pUnit->canPass(nextCoord.x, nextCoord.y)) {
                         Tile& nextTile = *(pMap->getTile(nextCoord));
-                        float g = getMapData(currentCoord).g;
+                        float g = context.g[currentIndex];
 
                         if((nextCoord.x != currentCoord.x) && (nextCoord.y != currentCoord.y)) {
                             //add diagonal movement cost
@@ -78,24 +76,25 @@ AStarSearch::AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destinat
                             g += (pUnit->isAFlyingUnit() ? 1.0f : pUnit->getTerrainDifficulty((TERRAINTYPE) nextTile.getType()));
                         }
 
-                        if(getMapData(currentCoord).parentCoord.isValid())	{
+                        if(context.parent[currentIndex] != INVALID_POS)	{
                             //add cost of turning time
-                            int posAngle = currentGameMap->getPosAngle(getMapData(currentCoord).parentCoord, currentCoord);
+                            int posAngle = currentGameMap->getPosAngle(getCoord(context.parent[currentIndex]), currentCoord);
                             if (posAngle != angle)
                                 g += (1.0f/currentGame->objectData.data[pUnit->getItemID()][pUnit->getOriginalHouseID()].turnspeed * (float)std::min(abs(angle - posAngle), NUM_ANGLES - std::max(angle, posAngle) + std::min(angle, posAngle)))/((float)TILESIZE);
                         }
 
                         float h = blockDistance(nextCoord, destination);
 
-                        if(getMapData(nextCoord).bClosed == false) {
-                            putOnOpenListIfBetter(nextCoord, currentCoord, g, h);
+                        Sint32 nextIndex = getIndex(nextCoord);
+                        if(isClosed(nextIndex) == false) {
+                            putOnOpenListIfBetter(nextIndex, currentIndex, g, h);
                         }
                     }
 
                 }
             }
 
-            if (getMapData(currentCoord).bClosed == false) {
+            if (isClosed(currentIndex) == false) {
 
 				int depth = std::max(abs(currentCoord.x - destination.x), abs(currentCoord.y - destination.y));
 
@@ -140,12 +139,12 @@ AStarSearch::AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destinat
 
                     if (++depthCheckCount[k] >= depthCheckMax) {
                         // we have searched a whole square around destination, it can't be reached
-                    	getMapData(currentCoord).bReached=false;
+                    	setReached(currentIndex, false);
                         break;
                     }
 				}
 
-                getMapData(currentCoord).bClosed = true;
+                setFlag(currentIndex, AStarSearchContext::Flag_Closed, true);
                 numNodesChecked++;
             }
         }
@@ -156,6 +155,7 @@ AStarSearch::AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destinat
 }
 
 AStarSearch::~AStarSearch() {
-    free(mapData);
+    context.endSearch();
+    delete pOwnContext;
 }
 
@@ -32,6 +32,9 @@
 
 #include <algorithm>
 
+/// all bullets are allocated from this pool
+static ObjectPool<Bullet> bulletPool;
+
 
 Bullet::Bullet(Uint32 shooterID, Coord* newRealLocation, Coord* newRealDestination, Uint32 bulletID, int damage, bool air, int precisionOffset)
 {
@@ -264,6 +267,18 @@ Bullet::~Bullet()
     }
 }
 
+void* Bullet::operator new(size_t size) {
+    return bulletPool.allocate();
+}
+
+void Bullet::operator delete(void* p) {
+    bulletPool.release(p);
+}
+
+const ObjectPool<Bullet>& Bullet::getPool() {
+    return bulletPool;
+}
+
 void Bullet::save(OutputStream& stream) const
 {
 	stream.writeUint32(bulletID);
@@ -37,37 +37,43 @@
 #include <stdexcept>
 
 Command::Command(Uint8 playerID, CMDTYPE id) {
+	this->playerID = playerID;
 	commandID = id;
+	numParameters = 0;
 }
 
 Command::Command(Uint8 playerID, CMDTYPE id, Uint32 parameter1) {
 	this->playerID = playerID;
 	commandID = id;
-	parameter.push_back(parameter1);
+	numParameters = 1;
+	parameter[0] = parameter1;
 }
 
 Command::Command(Uint8 playerID, CMDTYPE id, Uint32 parameter1, Uint32 parameter2) {
 	this->playerID = playerID;
 	commandID = id;
-	parameter.push_back(parameter1);
-	parameter.push_back(parameter2);
+	numParameters = 2;
+	parameter[0] = parameter1;
+	parameter[1] = parameter2;
 }
 
 Command::Command(Uint8 playerID, CMDTYPE id, Uint32 parameter1, Uint32 parameter2, Uint32 parameter3) {
 	this->playerID = playerID;
 	commandID = id;
-	parameter.push_back(parameter1);
-	parameter.push_back(parameter2);
-	parameter.push_back(parameter3);
+	numParameters = 3;
+	parameter[0] = parameter1;
+	parameter[1] = parameter2;
+	parameter[2] = parameter3;
 }
 
 Command::Command(Uint8 playerID, CMDTYPE id, Uint32 parameter1, Uint32 parameter2, Uint32 parameter3, Uint32 parameter4) {
 	this->playerID = playerID;
 	commandID = id;
-	parameter.push_back(parameter1);
-	parameter.push_back(parameter2);
-	parameter.push_back(parameter3);
-	parameter.push_back(parameter4);
+	numParameters = 4;
+	parameter[0] = parameter1;
+	parameter[1] = parameter2;
+	parameter[2] = parameter3;
+	parameter[3] = parameter4;
 }
 
 Command::Command(Uint8 playerID, Uint8* data, Uint32 length) {
@@ -79,6 +85,10 @@ Command::Command(Uint8 playerID, Uint8* data, Uint32 length) {
 		throw std::invalid_argument("Command::Command(): Command must be at least 4 bytes long!");
 	}
 
+	if((length-4)/4 > COMMAND_MAXPARAMETERS) {
+		throw std::invalid_argument("Command::Command(): Command has too many parameters!");
+	}
+
     this->playerID = playerID;
 	commandID = (CMDTYPE) *((Uint32*) data);
 
@@ -86,9 +96,10 @@ Command::Command(Uint8 playerID, Uint8* data, Uint32 length) {
 		throw std::invalid_argument("Command::Command(): CommandID unknown!");
 	}
 
+	numParameters = (length-4)/4;
 	Uint32* pData = (Uint32*) (data+4);
-	for(Uint32 i=0;i<(length-4)/4;i++) {
-		parameter.push_back(*pData);
+	for(Uint32 i=0;i<numParameters;i++) {
+		parameter[i] = *pData;
 		pData++;
 	}
 }
@@ -96,7 +107,16 @@ Command::Command(Uint8 playerID, Uint8* data, Uint32 length) {
 Command::Command(InputStream& stream) {
     playerID = stream.readUint8();
 	commandID = (CMDTYPE) stream.readUint32();
-	parameter = stream.readUint32Vector();
+
+	// same format as InputStream::readUint32Vector() but without allocating a vector
+	Uint32 size = stream.readUint32();
+	if(size > COMMAND_MAXPARAMETERS) {
+		throw std::invalid_argument("Command::Command(): Command has too many parameters!");
+	}
+	numParameters = size;
+	for(Uint32 i=0;i<numParameters;i++) {
+		parameter[i] = stream.readUint32();
+	}
 }
 
 Command::~Command() {
@@ -105,15 +125,19 @@ Command::~Command() {
 void Command::save(OutputStream& stream) const {
     stream.writeUint8(playerID);
 	stream.writeUint32((Uint32) commandID);
-	stream.writeUint32Vector(parameter);
-	stream.flush();
+
+	// same format as OutputStream::writeUint32Vector()
+	stream.writeUint32(numParameters);
+	for(Uint32 i=0;i<numParameters;i++) {
+		stream.writeUint32(parameter[i]);
+	}
 }
 
 void Command::executeCommand() const {
 	switch(commandID) {
 
 		case CMD_PLACE_STRUCTURE: {
-			if(parameter.size() != 3) {
+			if(numParameters != 3) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_PLACE_STRUCTURE needs 3 Parameters!");
 			}
 			ConstructionYard* pConstYard = dynamic_cast<ConstructionYard*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -125,7 +149,7 @@ void Command::executeCommand() const {
 
 
 		case CMD_UNIT_MOVE2POS: {
-			if(parameter.size() != 4) {
+			if(numParameters != 4) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_UNIT_MOVE2POS needs 4 Parameters!");
 			}
 			UnitBase* unit = dynamic_cast<UnitBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -137,7 +161,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_UNIT_MOVE2OBJECT: {
-			if(parameter.size() != 3) {
+			if(numParameters != 3) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_UNIT_MOVE2OBJECT needs 3 Parameters!");
 			}
 			UnitBase* unit =  dynamic_cast<UnitBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -148,7 +172,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_UNIT_ATTACKPOS: {
-			if(parameter.size() != 4) {
+			if(numParameters != 4) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_UNIT_ATTACKPOS needs 4 Parameters!");
 			}
 			UnitBase* unit = dynamic_cast<UnitBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -159,7 +183,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_UNIT_SALVEATTACKPOS: {
-			if(parameter.size() != 4) {
+			if(numParameters != 4) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_UNIT_SALVEATTACKPOS needs 4 Parameters!");
 			}
 			UnitBase* unit = dynamic_cast<UnitBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -170,7 +194,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_UNIT_ATTACKOBJECT: {
-			if(parameter.size() != 2) {
+			if(numParameters != 2) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_UNIT_ATTACKOBJECT needs 2 Parameters!");
 			}
 			UnitBase* pUnit = dynamic_cast<UnitBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -181,7 +205,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_UNIT_SALVEATTACKOBJECT: {
-			if(parameter.size() != 2) {
+			if(numParameters != 2) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_UNIT_SALVEATTACKOBJECT needs 2 Parameters!");
 			}
 			UnitBase* pUnit = dynamic_cast<UnitBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -192,7 +216,7 @@ void Command::executeCommand() const {
 		} break;
 
         case CMD_INFANTRY_CAPTURE: {
-			if(parameter.size() != 2) {
+			if(numParameters != 2) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_INFANTRY_CAPTURE needs 2 Parameters!");
 			}
 			InfantryBase* pInfantry = dynamic_cast<InfantryBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -203,7 +227,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_UNIT_SETMODE: {
-			if(parameter.size() != 2) {
+			if(numParameters != 2) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_UNIT_SETMODE needs 2 Parameter!");
 			}
 			UnitBase* pUnit = dynamic_cast<UnitBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -214,7 +238,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_UNIT_CANCEL: {
-			if(parameter.size() != 1) {
+			if(numParameters != 1) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_UNIT_CANCEL needs 1 Parameter!");
 			}
 			UnitBase* pUnit = dynamic_cast<UnitBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -226,7 +250,7 @@ void Command::executeCommand() const {
 
 
 		case CMD_DEVASTATOR_STARTDEVASTATE: {
-			if(parameter.size() != 1) {
+			if(numParameters != 1) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_DEVASTATOR_STARTDEVASTATE needs 1 Parameter!");
 			}
 			Devastator* pDevastator = dynamic_cast<Devastator*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -237,7 +261,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_MCV_DEPLOY: {
-			if(parameter.size() != 1) {
+			if(numParameters != 1) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_MCV_DEPLOY needs 1 Parameter!");
 			}
 			MCV* pMCV = dynamic_cast<MCV*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -248,7 +272,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_HARVESTER_RETURN: {
-			if(parameter.size() != 1) {
+			if(numParameters != 1) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_HARVESTER_RETURN needs 1 Parameter!");
 			}
 			Harvester* pHarvester = dynamic_cast<Harvester*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -259,7 +283,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_UNIT_REPAIR: {
-					if(parameter.size() != 1) {
+					if(numParameters != 1) {
 						throw std::invalid_argument("Command::executeCommand(): CMD_UNIT_REPAIR needs 1 Parameter!");
 					}
 					GroundUnit* pUnit = dynamic_cast<GroundUnit*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -270,7 +294,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_STRUCTURE_SETDEPLOYPOSITION: {
-			if(parameter.size() != 3) {
+			if(numParameters != 3) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_STRUCTURE_SETDEPLOYPOSITION needs 3 Parameters!");
 			}
 			StructureBase* pStructure = dynamic_cast<StructureBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -281,7 +305,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_STRUCTURE_REPAIR: {
-			if(parameter.size() != 1) {
+			if(numParameters != 1) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_STRUCTURE_REPAIR needs 1 Parameter!");
 			}
 			StructureBase* pStructure = dynamic_cast<StructureBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -295,7 +319,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_BUILDER_AUTOMATE: {
-			if(parameter.size() != 1) {
+			if(numParameters != 1) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_BUILDER_AUTOMATE needs 1 Parameter!");
 			}
 			BuilderBase* pBuilder = dynamic_cast<BuilderBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -305,7 +329,7 @@ void Command::executeCommand() const {
 			pBuilder->doAutomate();
 		} break;
 		case CMD_BUILDER_UPGRADE: {
-			if(parameter.size() != 1) {
+			if(numParameters != 1) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_BUILDER_UPGRADE needs 1 Parameter!");
 			}
 			BuilderBase* pBuilder = dynamic_cast<BuilderBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -316,7 +340,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_BUILDER_PRODUCEITEM: {
-			if(parameter.size() != 3) {
+			if(numParameters != 3) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_BUILDER_PRODUCEITEM needs 3 Parameter!");
 			}
 			BuilderBase* pBuilder = dynamic_cast<BuilderBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -327,7 +351,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_BUILDER_CANCELITEM: {
-			if(parameter.size() != 3) {
+			if(numParameters != 3) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_BUILDER_CANCELITEM needs 3 Parameter!");
 			}
 			BuilderBase* pBuilder = dynamic_cast<BuilderBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -338,7 +362,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_BUILDER_SETONHOLD: {
-			if(parameter.size() != 2) {
+			if(numParameters != 2) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_BUILDER_SETONHOLD needs 2 Parameters!");
 			}
 			BuilderBase* pBuilder = dynamic_cast<BuilderBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -349,7 +373,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_PALACE_SPECIALWEAPON: {
-			if(parameter.size() != 1) {
+			if(numParameters != 1) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_PALACE_SPECIALWEAPON needs 1 Parameter!");
 			}
 			Palace* palace = dynamic_cast<Palace*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -360,7 +384,7 @@ void Command::executeCommand() const {
 		} break;
 
         case CMD_PALACE_DEATHHAND: {
-			if(parameter.size() != 3) {
+			if(numParameters != 3) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_PALACE_DEATHHAND needs 3 Parameter!");
 			}
 			Palace* palace = dynamic_cast<Palace*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -371,7 +395,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_STARPORT_PLACEORDER: {
-			if(parameter.size() != 1) {
+			if(numParameters != 1) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_STARPORT_PLACEORDER needs 1 Parameter!");
 			}
 			StarPort* pStarport = dynamic_cast<StarPort*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -382,7 +406,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_STARPORT_CANCELORDER: {
-			if(parameter.size() != 1) {
+			if(numParameters != 1) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_STARPORT_CANCELORDER needs 1 Parameter!");
 			}
 			StarPort* pStarport = dynamic_cast<StarPort*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -393,7 +417,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_TURRET_ATTACKOBJECT: {
-			if(parameter.size() != 2) {
+			if(numParameters != 2) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_TURRET_ATTACKOBJECT needs 2 Parameters!");
 			}
 			TurretBase* pTurret = dynamic_cast<TurretBase*>(currentGame->getObjectManager().getObject(parameter[0]));
@@ -404,7 +428,7 @@ void Command::executeCommand() const {
 		} break;
 
 		case CMD_TEST_SYNC: {
-			if(parameter.size() != 1) {
+			if(numParameters != 1) {
 				throw std::invalid_argument("Command::executeCommand(): CMD_TEST_SYNC needs 1 Parameters!");
 			}
 
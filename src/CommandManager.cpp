@@ -26,14 +26,27 @@
 
 #include <algorithm>
 
-bool compareCommands(Command cmd1, Command cmd2) {
+static bool compareCommands(const Command& cmd1, const Command& cmd2) {
     return (cmd1.getPlayerID() < cmd2.getPlayerID());
 }
 
+static bool compareLoadedCommands(const std::pair<Uint32, Command>& cmd1, const std::pair<Uint32, Command>& cmd2) {
+    return (cmd1.first < cmd2.first);
+}
+
+static bool compareLoadedCommandCycle(const std::pair<Uint32, Command>& cmd, Uint32 cycle) {
+    return (cmd.first < cycle);
+}
+
 CommandManager::CommandManager() {
 	pStream = NULL;
 	bReadOnly = false;
 	networkCycleBuffer = 0;
+	nextLoadedCommand = 0;
+	lastCommandCycle = 0;
+	bStreamDirty = false;
+	lastStreamFlushCycle = 0;
+	timeslot.resize(COMMANDMANAGER_INITIALSLOTS);
 }
 
 CommandManager::~CommandManager() {
@@ -51,14 +64,14 @@ void CommandManager::addCommand(Command cmd) {
 }
 
 void CommandManager::save(OutputStream& stream) const {
-	for(unsigned int i=0;i<timeslot.size();i++) {
-		const std::vector<Command>& cmdlist = timeslot[i];
-		std::vector<Command>::const_iterator iter;
+	for(size_t i=0;i<loadedCommands.size();i++) {
+        stream.writeUint32(loadedCommands[i].first);
+        loadedCommands[i].second.save(stream);
+	}
 
-		for(iter = cmdlist.begin(); iter != cmdlist.end(); ++iter) {
-			stream.writeUint32(i);
-			iter->save(stream);
-		}
+	for(size_t i=0;i<addedCommands.size();i++) {
+        stream.writeUint32(addedCommands[i].first);
+        addedCommands[i].second.save(stream);
 	}
 }
 
@@ -66,29 +79,59 @@ void CommandManager::load(InputStream& stream) {
 	try {
 		while(1) {
 			Uint32 cycle = stream.readUint32();
-			addCommand(Command(stream), cycle);
+			loadedCommands.push_back(std::make_pair(cycle, Command(stream)));
+			lastCommandCycle = std::max(lastCommandCycle, cycle);
 		}
 	} catch (InputStream::exception&) {
 		;
 	}
+
+	// commands received over the network are recorded when they arrive, not in game cycle order
+	std::stable_sort(loadedCommands.begin() + nextLoadedCommand, loadedCommands.end(), compareLoadedCommands);
+}
+
+void CommandManager::seekLoadedCommands(Uint32 CycleNumber) {
+	for(size_t i=0;i<timeslot.size();i++) {
+		timeslot[i].cycle = 0;
+		timeslot[i].commands.clear();
+	}
+
+	nextLoadedCommand = std::lower_bound(loadedCommands.begin(), loadedCommands.end(), CycleNumber, compareLoadedCommandCycle) - loadedCommands.begin();
 }
 
 void CommandManager::update() {
+    // the stream is flushed from time to time only; every flush ends a compressed block of the replay
+    if((pStream != NULL) && bStreamDirty && (currentGame->getGameCycleCount() >= lastStreamFlushCycle + COMMANDMANAGER_FLUSHINTERVAL)) {
+        pStream->flush();
+        bStreamDirty = false;
+        lastStreamFlushCycle = currentGame->getGameCycleCount();
+    }
+
     if(pNetworkManager != NULL) {
-        CommandList commandList;
-        for(Uint32 i = std::max((int) currentGame->getGameCycleCount() - MILLI2CYCLES(2500), 0); i < currentGame->getGameCycleCount() + networkCycleBuffer; i++) {
+        // the cycles every peer has acknowledged do not have to be sent again
+        Uint32 endCycle = currentGame->getGameCycleCount() + networkCycleBuffer;
+        Uint32 firstCycle = std::max((int) currentGame->getGameCycleCount() - COMMANDMANAGER_HISTORY, 0);
+        firstCycle = std::min(std::max(firstCycle, pNetworkManager->getMinAcknowledgedCycle()), endCycle);
+
+        CommandList commandList(firstCycle, endCycle);
+        for(Uint32 i = firstCycle; i < endCycle; i++) {
+            const std::vector<Command>* pCommands = getCommands(i);
+            if(pCommands == NULL) {
+                continue;
+            }
+
             std::vector<Command> commands;
 
-            if(i < timeslot.size()) {
-                std::vector<Command>::const_iterator iter;
-                for(iter = timeslot[i].begin(); iter != timeslot[i].end(); ++iter) {
-                    if(iter->getPlayerID() == pLocalPlayer->getPlayerID()) {
-                        commands.push_back(*iter);
-                    }
+            std::vector<Command>::const_iterator iter;
+            for(iter = pCommands->begin(); iter != pCommands->end(); ++iter) {
+                if(iter->getPlayerID() == pLocalPlayer->getPlayerID()) {
+                    commands.push_back(*iter);
                 }
             }
 
-            commandList.commandList.push_back(CommandList::CommandListEntry(i, commands));
+            if(commands.empty() == false) {
+                commandList.commandList.push_back(CommandList::CommandListEntry(i, commands));
+            }
         }
 
         pNetworkManager->sendCommandList(commandList);
@@ -101,6 +144,11 @@ void CommandManager::addCommandList(const std::string& playername, const Command
         return;
     }
 
+    if(commandList.firstCycle > pPlayer->nextExpectedCommandsCycle) {
+        // some cycles in between are missing (packets are unsequenced); they will be sent again as they are not acknowledged
+        return;
+    }
+
     std::vector<CommandList::CommandListEntry>::const_iterator iter;
     for(iter = commandList.commandList.begin(); iter != commandList.commandList.end(); ++iter) {
         if(pPlayer->nextExpectedCommandsCycle > iter->cycle) {
@@ -115,34 +163,43 @@ void CommandManager::addCommandList(const std::string& playername, const Command
 
             addCommand(*iter2, iter->cycle);
         }
-
-        pPlayer->nextExpectedCommandsCycle = std::max(pPlayer->nextExpectedCommandsCycle, iter->cycle+1);
     }
+
+    // the empty cycles are not contained in the list
+    pPlayer->nextExpectedCommandsCycle = std::max(pPlayer->nextExpectedCommandsCycle, commandList.endCycle);
 }
 
 void CommandManager::addCommand(Command cmd, Uint32 CycleNumber) {
 	if(bReadOnly == false) {
-
-		if(CycleNumber >= timeslot.size()) {
-			timeslot.resize(CycleNumber+1);
+		if(insertCommand(cmd, CycleNumber) == false) {
+			return;
 		}
 
-		timeslot[CycleNumber].push_back(cmd);
-		std::stable_sort(timeslot[CycleNumber].begin(), timeslot[CycleNumber].end(), compareCommands);
+		addedCommands.push_back(std::make_pair(CycleNumber, cmd));
 
 		if(pStream != NULL) {
 			pStream->writeUint32(CycleNumber);
 			cmd.save(*pStream);
+			bStreamDirty = true;
 		}
 	}
 }
 
-void CommandManager::executeCommands(Uint32 CycleNumber) const {
-	if(CycleNumber >= timeslot.size()) {
+void CommandManager::executeCommands(Uint32 CycleNumber) {
+	// move the commands of a loaded replay into the ring buffer
+	while((nextLoadedCommand < loadedCommands.size()) && (loadedCommands[nextLoadedCommand].first <= CycleNumber)) {
+		if(loadedCommands[nextLoadedCommand].first == CycleNumber) {
+			insertCommand(loadedCommands[nextLoadedCommand].second, CycleNumber);
+		}
+		nextLoadedCommand++;
+	}
+
+	const std::vector<Command>* pCommands = getCommands(CycleNumber);
+	if(pCommands == NULL) {
 		return;
 	}
 
-	const std::vector<Command>& cmdlist = timeslot[CycleNumber];
+	const std::vector<Command>& cmdlist = *pCommands;
 	std::vector<Command>::const_iterator iter;
 
 	for(iter = cmdlist.begin(); iter != cmdlist.end(); ++iter) {
@@ -162,3 +219,58 @@ void CommandManager::executeCommands(Uint32 CycleNumber) const {
 	}
 }
 
+bool CommandManager::insertCommand(const Command& cmd, Uint32 CycleNumber) {
+	Uint32 currentCycle = currentGame->getGameCycleCount();
+	Uint32 oldestNeededCycle = (currentCycle > COMMANDMANAGER_HISTORY) ? (currentCycle - COMMANDMANAGER_HISTORY) : 0;
+
+	if(CycleNumber < oldestNeededCycle) {
+		fprintf(stderr, "CommandManager::insertCommand(): Command for game cycle %d is too old and is dropped!\n", CycleNumber);
+		return false;
+	}
+
+	// the slot holds another game cycle that is still needed (not executed yet or within the history; it may also be
+	// newer than CycleNumber if commands arrive out of order) => the ring buffer is too small
+	CommandSlot* pSlot = &timeslot[CycleNumber % timeslot.size()];
+	while((pSlot->cycle != CycleNumber) && (pSlot->commands.empty() == false) && (pSlot->cycle >= oldestNeededCycle)) {
+		growTimeslots();
+		pSlot = &timeslot[CycleNumber % timeslot.size()];
+	}
+
+	if(pSlot->cycle != CycleNumber) {
+		// reuse the slot; clear() keeps the capacity
+		pSlot->cycle = CycleNumber;
+		pSlot->commands.clear();
+	}
+
+	// keep the commands ordered by player ID, the same order on every peer
+	std::vector<Command>::iterator iter = std::upper_bound(pSlot->commands.begin(), pSlot->commands.end(), cmd, compareCommands);
+	pSlot->commands.insert(iter, cmd);
+
+	lastCommandCycle = std::max(lastCommandCycle, CycleNumber);
+
+	return true;
+}
+
+const std::vector<Command>* CommandManager::getCommands(Uint32 CycleNumber) const {
+	const CommandSlot& slot = timeslot[CycleNumber % timeslot.size()];
+	if((slot.cycle != CycleNumber) || slot.commands.empty()) {
+		return NULL;
+	}
+
+	return &slot.commands;
+}
+
+void CommandManager::growTimeslots() {
+	std::vector<CommandSlot> oldTimeslot;
+	oldTimeslot.swap(timeslot);
+	timeslot.resize(oldTimeslot.size() * 2);
+
+	// two cycles with different indices in the old buffer also get different indices in the new one
+	for(size_t i=0;i<oldTimeslot.size();i++) {
+		if(oldTimeslot[i].commands.empty() == false) {
+			CommandSlot& newSlot = timeslot[oldTimeslot[i].cycle % timeslot.size()];
+			newSlot.cycle = oldTimeslot[i].cycle;
+			newSlot.commands.swap(oldTimeslot[i].commands);
+		}
+	}
+}
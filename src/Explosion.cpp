@@ -25,6 +25,9 @@
 
 #define CYCLES_PER_FRAME    5
 
+/// all explosions are allocated from this pool
+static ObjectPool<Explosion> explosionPool;
+
 Explosion::Explosion()
  : explosionID(NONE), house(HOUSE_HARKONNEN)
 {
@@ -60,6 +63,18 @@ Explosion::~Explosion()
 
 }
 
+void* Explosion::operator new(size_t size) {
+    return explosionPool.allocate();
+}
+
+void Explosion::operator delete(void* p) {
+    explosionPool.release(p);
+}
+
+const ObjectPool<Explosion>& Explosion::getPool() {
+    return explosionPool;
+}
+
 void Explosion::init()
 {
     switch(explosionID) {
@@ -23,15 +23,14 @@
 #include <FileClasses/Fntfile.h>
 #include <FileClasses/PictureFont.h>
 
-#include <list>
-
-FontManager::FontManager() {
+FontManager::FontManager() : numTextCacheHits(0), numTextCacheMisses(0) {
 	fonts[FONT_STD10] = std::shared_ptr<Font>(new PictureFont(SDL_LoadBMP_RW(pFileManager->openFile("Font10.bmp"),true), true));
 	fonts[FONT_STD12] = std::shared_ptr<Font>(new PictureFont(SDL_LoadBMP_RW(pFileManager->openFile("Font12.bmp"),true), true));
 	fonts[FONT_STD24] = std::shared_ptr<Font>(new PictureFont(SDL_LoadBMP_RW(pFileManager->openFile("Font24.bmp"),true), true));
 }
 
 FontManager::~FontManager() {
+	clearTextCache();
 }
 
 void FontManager::drawTextOnSurface(SDL_Surface* pSurface, std::string text, unsigned char color, unsigned int fontNum) {
@@ -130,3 +129,64 @@ SDL_Surface* FontManager::createSurfaceWithMultilineText(std::string text, unsig
 
     return pic;
 }
+
+SDL_Surface* FontManager::getTextSurface(const std::string& text, unsigned char color, unsigned int fontNum) {
+	if(fontNum >= NUM_FONTS) {
+		return NULL;
+	}
+
+	TextCacheKey key(text, (fontNum << 8) | color);
+
+	std::map<TextCacheKey, std::list<TextCacheEntry>::iterator>::iterator mapIter = textCacheMap.find(key);
+	if(mapIter != textCacheMap.end()) {
+		numTextCacheHits++;
+		textCacheList.splice(textCacheList.begin(), textCacheList, mapIter->second);
+		return mapIter->second->pSurface;
+	}
+
+	numTextCacheMisses++;
+
+	if(textCacheList.size() < TEXTCACHE_MAXENTRIES) {
+		TextCacheEntry entry;
+		entry.pSurface = NULL;
+		textCacheList.push_front(entry);
+	} else {
+		// reuse the least recently used entry
+		textCacheMap.erase(textCacheList.back().key);
+		textCacheList.splice(textCacheList.begin(), textCacheList, --textCacheList.end());
+	}
+
+	TextCacheEntry& entry = textCacheList.front();
+	entry.key = key;
+
+	int width = fonts[fontNum]->getTextWidth(text);
+	int height = fonts[fontNum]->getTextHeight();
+
+	if((entry.pSurface != NULL) && (entry.pSurface->w == width) && (entry.pSurface->h == height)) {
+		// the old surface has the same size (e.g. a changing number) => just clear it
+		SDL_FillRect(entry.pSurface, NULL, 0);
+		fonts[fontNum]->drawTextOnSurface(entry.pSurface,text,color);
+	} else {
+		SDL_FreeSurface(entry.pSurface);
+		entry.pSurface = createSurfaceWithText(text, color, fontNum);
+	}
+
+	if(entry.pSurface == NULL) {
+		textCacheList.pop_front();
+		return NULL;
+	}
+
+	textCacheMap[key] = textCacheList.begin();
+
+	return entry.pSurface;
+}
+
+void FontManager::clearTextCache() {
+	std::list<TextCacheEntry>::iterator iter;
+	for(iter = textCacheList.begin(); iter != textCacheList.end(); ++iter) {
+		SDL_FreeSurface(iter->pSurface);
+	}
+
+	textCacheList.clear();
+	textCacheMap.clear();
+}
@@ -1139,6 +1139,12 @@ GFXManager::GFXManager() {
     SDL_SetColorKey(pTransparentXSurface, pTransparentXSurface->flags & (SDL_SRCCOLORKEY | SDL_RLEACCEL), 255);*/
     SDL_SetAlpha(pTransparentXSurface, SDL_SRCALPHA, 40);
 
+    // Create the fog masks from the hidden terrain tiles
+    for(int z = 0; z < NUM_ZOOMLEVEL; z++) {
+        pFog40Mask[z] = createFogMask(objPic[ObjPic_Terrain_Hidden][HOUSE_HARKONNEN][z], 40);
+        pFog150Mask[z] = createFogMask(objPic[ObjPic_Terrain_Hidden][HOUSE_HARKONNEN][z], 150);
+    }
+
 }
 
 GFXManager::~GFXManager() {
@@ -1195,6 +1201,39 @@ GFXManager::~GFXManager() {
 	SDL_FreeSurface(pTransparent40Surface);
 	SDL_FreeSurface(pTransparent150Surface);
 	SDL_FreeSurface(pTransparentXSurface);
+
+	for(int z = 0; z < NUM_ZOOMLEVEL; z++) {
+		SDL_FreeSurface(pFog40Mask[z]);
+		SDL_FreeSurface(pFog150Mask[z]);
+	}
+}
+
+SDL_Surface* GFXManager::createFogMask(SDL_Surface* pHiddenSurface, Uint8 alpha) {
+	SDL_Surface* pMask = SDL_CreateRGBSurface(SDL_HWSURFACE, pHiddenSurface->w, pHiddenSurface->h, 32, 0, 0, 0, 0);
+	if(pMask == NULL) {
+		throw std::runtime_error("GFXManager::createFogMask(): Cannot create surface!");
+	}
+
+	Uint32 transparentColor = SDL_MapRGB(pMask->format, 255, 0, 255);
+	Uint32 fogColor = SDL_MapRGB(pMask->format, 0, 0, 0);
+	SDL_FillRect(pMask, NULL, transparentColor);
+
+	SDL_LockSurface(pHiddenSurface);
+	SDL_LockSurface(pMask);
+	for(int y = 0; y < pHiddenSurface->h; y++) {
+		for(int x = 0; x < pHiddenSurface->w; x++) {
+			if(getPixel(pHiddenSurface, x, y) == 12) {
+				putPixel(pMask, x, y, fogColor);
+			}
+		}
+	}
+	SDL_UnlockSurface(pMask);
+	SDL_UnlockSurface(pHiddenSurface);
+
+	SDL_SetColorKey(pMask, SDL_SRCCOLORKEY, transparentColor);
+	SDL_SetAlpha(pMask, SDL_SRCALPHA, alpha);
+
+	return pMask;
 }
 
 SDL_Surface** GFXManager::getObjPic(unsigned int id, int house) {
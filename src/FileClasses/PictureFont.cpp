@@ -20,6 +20,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdexcept>
+#include <algorithm>
 
 /// Constructor
 /**
@@ -39,6 +40,7 @@ PictureFont::PictureFont(SDL_Surface* pic, int freesrc)
 
     try {
         characterHeight = pic->h - 2;
+        atlasWidth = 0;
 
         int curXPos = 1;
         int oldXPos = curXPos;
@@ -53,24 +55,27 @@ PictureFont::PictureFont(SDL_Surface* pic, int freesrc)
             }
 
             character[i].width = curXPos - oldXPos;
-            character[i].data.resize(character[i].width * characterHeight);
-
-            int mempos = 0;
-            for(int y = 1; y < pic->h - 1; y++) {
-                for(int x = oldXPos; x < curXPos; x++) {
-                    unsigned char col = *(((unsigned char*) pic->pixels) + y*pic->pitch + x);
-                    if(col != 0) {
-                        col = 1;
-                    }
-
-                    character[i].data[mempos] = col;
-                    mempos++;
-                }
-            }
+            character[i].atlasX = atlasWidth;
+            atlasWidth += character[i].width;
+
             curXPos++;
             oldXPos = curXPos;
         }
 
+        // copy all characters without the separating columns into one atlas
+        glyphAtlas.resize(atlasWidth * characterHeight);
+        for(int i = 0; i < 256; i++) {
+            // in the picture every character is preceded by one separating column
+            int srcX = character[i].atlasX + i + 1;
+            for(int y = 0; y < characterHeight; y++) {
+                const unsigned char* pSrc = ((unsigned char*) pic->pixels) + (y+1)*pic->pitch + srcX;
+                Uint8* pDest = &glyphAtlas[y*atlasWidth + character[i].atlasX];
+                for(int x = 0; x < character[i].width; x++) {
+                    pDest[x] = (pSrc[x] != 0) ? 1 : 0;
+                }
+            }
+        }
+
         SDL_UnlockSurface(pic);
         if(freesrc) SDL_FreeSurface(pic);
 
@@ -94,23 +99,26 @@ PictureFont::~PictureFont()
 void PictureFont::drawTextOnSurface(SDL_Surface* pSurface, std::string text, unsigned char baseColor) {
 	SDL_LockSurface(pSurface);
 
+	int height = std::min((int) characterHeight, (int) pSurface->h);
+
 	int curXPos = 0;
 	const unsigned char* pText = (unsigned char*) text.c_str();
 	while(*pText != '\0') {
-		int index = *pText;
-
-		//Now we can copy pixel by pixel
-		for(int y = 0; y < characterHeight; y++) {
-			for(int x = 0; x < character[index].width; x++) {
-				char color = character[index].data[y*character[index].width+x];
-				if(color != 0) {
-					*(((char*) pSurface->pixels) + y*pSurface->pitch + x + curXPos) = baseColor;
+		const FontCharacter& fontCharacter = character[*pText];
+		int width = std::min(fontCharacter.width, pSurface->w - curXPos);
+
+		//Now we can copy the rows of the character out of the atlas
+		for(int y = 0; y < height; y++) {
+			const Uint8* pGlyph = &glyphAtlas[y*atlasWidth + fontCharacter.atlasX];
+			Uint8* pDest = ((Uint8*) pSurface->pixels) + y*pSurface->pitch + curXPos;
+			for(int x = 0; x < width; x++) {
+				if(pGlyph[x] != 0) {
+					pDest[x] = baseColor;
 				}
-
 			}
 		}
 
-		curXPos += character[index].width;
+		curXPos += fontCharacter.width;
 		pText++;
 	}
 
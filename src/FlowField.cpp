@@ -0,0 +1,181 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FlowField.h>
+
+#include <globals.h>
+
+#include <Game.h>
+#include <Map.h>
+#include <Tile.h>
+#include <units/UnitBase.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
+typedef std::pair<float, Sint32> CostIndexPair;
+
+FlowFieldCache::FlowFieldCache(Map* pMap)
+ : pMap(pMap) {
+}
+
+FlowFieldCache::~FlowFieldCache() {
+}
+
+FlowFieldCache::MOVECLASS FlowFieldCache::getMoveClass(const UnitBase* pUnit) {
+    if(!pUnit->isAGroundUnit() || (pUnit->getItemID() == Unit_Sandworm)) {
+        return MoveClass_Invalid;
+    } else if(pUnit->isInfantry()) {
+        return MoveClass_Infantry;
+    } else {
+        return MoveClass_Vehicle;
+    }
+}
+
+void FlowFieldCache::clear() {
+    flowFields.clear();
+}
+
+bool FlowFieldCache::searchPath(UnitBase* pUnit, const Coord& start, const Coord& destination, std::list<Coord>& path) {
+    path.clear();
+
+    MOVECLASS moveClass = getMoveClass(pUnit);
+    if((moveClass == MoveClass_Invalid) || !pMap->tileExists(start) || !pMap->tileExists(destination)
+        || (blockDistance(start, destination) < FLOWFIELD_MINDISTANCE) || !isPassable(moveClass, destination.x, destination.y)) {
+        return false;
+    }
+
+    float terrainDifficulties[FLOWFIELD_NUMTERRAINTYPES];
+    for(int i = 0; i < FLOWFIELD_NUMTERRAINTYPES; i++) {
+        terrainDifficulties[i] = pUnit->getTerrainDifficulty((TERRAINTYPE) i);
+    }
+
+    Uint32 currentCycle = currentGame->getGameCycleCount();
+
+    // look for a flow field computed for the same destination, movement class and terrain difficulties
+    std::list<FlowField>::iterator fieldIter = flowFields.begin();
+    while(fieldIter != flowFields.end()) {
+        if(currentCycle - fieldIter->lastUsedCycle > FLOWFIELD_LIFETIME) {
+            fieldIter = flowFields.erase(fieldIter);
+        } else if((fieldIter->destination == destination) && (fieldIter->moveClass == moveClass)
+                    && std::equal(terrainDifficulties, terrainDifficulties + FLOWFIELD_NUMTERRAINTYPES, fieldIter->terrainDifficulties)) {
+            break;
+        } else {
+            ++fieldIter;
+        }
+    }
+
+    if(fieldIter == flowFields.end()) {
+        if(flowFields.size() >= FLOWFIELD_MAXFIELDS) {
+            flowFields.pop_back();
+        }
+
+        flowFields.push_front(FlowField());
+        fieldIter = flowFields.begin();
+        fieldIter->destination = destination;
+        fieldIter->moveClass = moveClass;
+        std::copy(terrainDifficulties, terrainDifficulties + FLOWFIELD_NUMTERRAINTYPES, fieldIter->terrainDifficulties);
+        computeFlowField(*fieldIter);
+    } else if(fieldIter != flowFields.begin()) {
+        flowFields.splice(flowFields.begin(), flowFields, fieldIter);
+        fieldIter = flowFields.begin();
+    }
+
+    fieldIter->lastUsedCycle = currentCycle;
+
+    const FlowField& flowField = *fieldIter;
+
+    // follow the directions until the destination or a blocked tile is reached
+    Coord currentCoord = start;
+    int maxSteps = pMap->getSizeX() * pMap->getSizeY();
+    while((currentCoord != destination) && (maxSteps-- > 0)) {
+        int direction = flowField.directions[currentCoord.x + currentCoord.y*pMap->getSizeX()];
+        if(direction == INVALID) {
+            break;
+        }
+
+        Coord nextCoord = pMap->getMapPos(direction, currentCoord);
+        if(!pUnit->canPass(nextCoord.x, nextCoord.y)) {
+            break;
+        }
+
+        path.push_back(nextCoord);
+        currentCoord = nextCoord;
+    }
+
+    return (path.empty() == false);
+}
+
+bool FlowFieldCache::isPassable(MOVECLASS moveClass, int x, int y) const {
+    const Tile* pTile = pMap->getTile(x,y);
+
+    if(moveClass == MoveClass_Infantry) {
+        return !pTile->hasAStructure();
+    } else {
+        return (!pTile->isMountain() && !pTile->hasAStructure());
+    }
+}
+
+void FlowFieldCache::computeFlowField(FlowField& flowField) {
+    const int sizeX = pMap->getSizeX();
+    const int sizeY = pMap->getSizeY();
+    const MOVECLASS moveClass = (MOVECLASS) flowField.moveClass;
+
+    flowField.costs.assign(sizeX*sizeY, std::numeric_limits<float>::infinity());
+    flowField.directions.assign(sizeX*sizeY, INVALID);
+
+    // dijkstra from the destination to all other tiles
+    std::priority_queue<CostIndexPair, std::vector<CostIndexPair>, std::greater<CostIndexPair> > openList;
+    Sint32 destinationIndex = flowField.destination.x + flowField.destination.y*sizeX;
+    flowField.costs[destinationIndex] = 0.0f;
+    openList.push(CostIndexPair(0.0f, destinationIndex));
+
+    while(openList.empty() == false) {
+        float cost = openList.top().first;
+        Sint32 index = openList.top().second;
+        openList.pop();
+
+        if(cost > flowField.costs[index]) {
+            continue;
+        }
+
+        Coord currentCoord(index % sizeX, index / sizeX);
+
+        // the cost of entering the current tile from any neighbour
+        float difficulty = flowField.terrainDifficulties[pMap->getTile(currentCoord)->getType()];
+
+        for(int angle = 0; angle < NUM_ANGLES; angle++) {
+            Coord neighbour = pMap->getMapPos(angle, currentCoord);
+            if(!pMap->tileExists(neighbour) || !isPassable(moveClass, neighbour.x, neighbour.y)) {
+                continue;
+            }
+
+            bool bDiagonal = (neighbour.x != currentCoord.x) && (neighbour.y != currentCoord.y);
+            float neighbourCost = cost + (bDiagonal ? DIAGONALCOST*difficulty : difficulty);
+            Sint32 neighbourIndex = neighbour.x + neighbour.y*sizeX;
+
+            if(neighbourCost < flowField.costs[neighbourIndex]) {
+                flowField.costs[neighbourIndex] = neighbourCost;
+                // from the neighbour we move in the opposite direction back to the current tile
+                flowField.directions[neighbourIndex] = (angle + NUM_ANGLES/2) % NUM_ANGLES;
+                openList.push(CostIndexPair(neighbourCost, neighbourIndex));
+            }
+        }
+    }
+}
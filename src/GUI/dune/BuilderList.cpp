@@ -256,11 +256,10 @@ void BuilderList::draw(SDL_Surface* screen, Point position) {
 				// draw price
 				char text[50];
 				sprintf(text, "%d", iter->price);
-				SDL_Surface* textSurface = pFontManager->createSurfaceWithText(text, COLOR_WHITE, FONT_STD10);
+				SDL_Surface* textSurface = pFontManager->getTextSurface(text, COLOR_WHITE, FONT_STD10);
 				SDL_Rect drawLocation = {   dest.x + 2, dest.y + BUILDERBTN_HEIGHT - textSurface->h + 3,
                                             textSurface->w, textSurface->h };
 				SDL_BlitSurface(textSurface, NULL, screen, &drawLocation);
-				SDL_FreeSurface(textSurface);
 
 				if(pStarport != NULL) {
 				    bool soldOut = (pStarport->getOwner()->getChoam().getNumAvailable(iter->itemID) == 0);
@@ -348,13 +347,12 @@ void BuilderList::draw(SDL_Surface* screen, Point position) {
 				if(iter->num > 0) {
 					// draw number of this in build list
 					sprintf(text, "%d", iter->num);
-					textSurface = pFontManager->createSurfaceWithText(text, COLOR_RED, FONT_STD10);
+					textSurface = pFontManager->getTextSurface(text, COLOR_RED, FONT_STD10);
                     SDL_Rect drawLocation = {   dest.x + BUILDERBTN_WIDTH - textSurface->w - 2,
                                                 dest.y + BUILDERBTN_HEIGHT - textSurface->h + 3,
                                                 textSurface->w,
                                                 textSurface->h };
 					SDL_BlitSurface(textSurface, NULL, screen, &drawLocation);
-					SDL_FreeSurface(textSurface);
 				}
 			}
 		}
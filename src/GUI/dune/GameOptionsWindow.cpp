@@ -95,6 +95,18 @@ GameOptionsWindow::GameOptionsWindow(SettingsClass::GameOptionsClass& initialGam
     vbox2.addWidget(&killedSandwormsDropSpiceCheckbox);
     vbox2.addWidget(VSpacer::create(4));
 
+    hierarchicalPathfindingCheckbox.setText(_("Hierarchical Pathfinding"));
+    hierarchicalPathfindingCheckbox.setTooltipText(_("If checked long unit paths are searched on a coarse map of the terrain first (faster on big maps)."));
+    hierarchicalPathfindingCheckbox.setChecked(gameOptions.hierarchicalPathfinding);
+    vbox2.addWidget(&hierarchicalPathfindingCheckbox);
+    vbox2.addWidget(VSpacer::create(4));
+
+    flowFieldPathfindingCheckbox.setText(_("Flow Field Pathfinding"));
+    flowFieldPathfindingCheckbox.setTooltipText(_("If checked long unit paths to the same destination are read from one shared flow field."));
+    flowFieldPathfindingCheckbox.setChecked(gameOptions.flowFieldPathfinding);
+    vbox2.addWidget(&flowFieldPathfindingCheckbox);
+    vbox2.addWidget(VSpacer::create(4));
+
     daynight.setText(_("Night & Day cycling"));
     daynight.setTooltipText(_("Game will simulated night & day cycling registering number of days on mission."));
     daynight.setChecked(gameOptions.daynight);
@@ -189,6 +201,8 @@ void GameOptionsWindow::onOK() {
     gameOptions.killedSandwormsDropSpice = killedSandwormsDropSpiceCheckbox.isChecked();
     gameOptions.daynight = daynight.isChecked();
     gameOptions.dayscale = currentDayScale;
+    gameOptions.hierarchicalPathfinding = hierarchicalPathfindingCheckbox.isChecked();
+    gameOptions.flowFieldPathfinding = flowFieldPathfindingCheckbox.isChecked();
 
     Window* pParentWindow = dynamic_cast<Window*>(getParent());
     if(pParentWindow != NULL) {
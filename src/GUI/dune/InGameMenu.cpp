@@ -154,7 +154,7 @@ void InGameMenu::onChildWindowClose(Window* pChildWindow) {
 
             } else {
                 // save window
-                currentGame->saveGame(FileName);
+                currentGame->saveGame(FileName, true);
 
 //              currentGame->resumeGame();
             }
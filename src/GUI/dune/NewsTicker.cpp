@@ -124,7 +124,7 @@ void NewsTicker::draw(SDL_Surface* screen, Point position) {
 		}
 
 
-		SDL_Surface *surface = pFontManager->createSurfaceWithText(messages.front(), COLOR_BLACK, FONT_STD10);
+		SDL_Surface *surface = pFontManager->getTextSurface(messages.front(), COLOR_BLACK, FONT_STD10);
 		SDL_Rect cut = { 0, 0, 0, 0 };
 		if(timer>0) {
 			cut.y = 3*SLOWDOWN;
@@ -138,6 +138,5 @@ void NewsTicker::draw(SDL_Surface* screen, Point position) {
 		cut.h = surface->h - cut.y;
 
 		SDL_BlitSurface(surface, &cut, screen, &textLocation);
-		SDL_FreeSurface(surface);
 	};
 }
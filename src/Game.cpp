@@ -29,14 +29,19 @@
 #include <misc/IFileStream.h>
 #include <misc/OFileStream.h>
 #include <misc/IMemoryStream.h>
+#include <misc/OMemoryStream.h>
+#include <misc/ICompressedStream.h>
+#include <misc/OCompressedStream.h>
 #include <misc/FileSystem.h>
 #include <misc/fnkdat.h>
 #include <misc/draw_util.h>
 #include <misc/string_util.h>
 #include <misc/strictmath.h>
 #include <misc/md5.h>
+#include <misc/timing_util.h>
 
 #include <players/HumanPlayer.h>
+#include <players/AIPlayer.h>
 
 #include <Network/NetworkManager.h>
 
@@ -139,7 +144,16 @@ Game::Game() {
     gameState = START;
 
 	gameCycleCount = 0;
+	numTargetSearches = 0;
+	for(int i = 0; i < NUM_DRAWLAYERS; i++) {
+		numLayerDraws[i] = 0;
+	}
+	for(int i = 0; i < NUM_BENCHMARKPHASES; i++) {
+		benchmarkTime[i] = 0;
+	}
 	skipToGameCycle = 0;
+	lastSaveSnapshotTime = 0;
+	lastAutosaveCycle = 0;
 
 	FrameTime = new float[sideBarPos.x*2];
 
@@ -189,22 +203,31 @@ Game::~Game() {
     delete pWaitingForOtherPlayers;
     pWaitingForOtherPlayers = NULL;
 
-    for(RobustList<StructureBase*>::const_iterator iter = structureList.begin(); iter != structureList.end(); ++iter) {
+    destroyWorld();
+
+	delete[] FrameTime;
+	delete screenborder;
+	screenborder = NULL;
+}
+
+
+void Game::destroyWorld() {
+    for(DenseList<StructureBase*>::const_iterator iter = structureList.begin(); iter != structureList.end(); ++iter) {
         delete *iter;
     }
     structureList.clear();
 
-    for(RobustList<UnitBase*>::const_iterator iter = unitList.begin(); iter != unitList.end(); ++iter) {
+    for(DenseList<UnitBase*>::const_iterator iter = unitList.begin(); iter != unitList.end(); ++iter) {
         delete *iter;
     }
     unitList.clear();
 
-	for(RobustList<Bullet*>::const_iterator iter = bulletList.begin(); iter != bulletList.end(); ++iter) {
+	for(DenseList<Bullet*>::const_iterator iter = bulletList.begin(); iter != bulletList.end(); ++iter) {
 	    delete *iter;
 	}
 	bulletList.clear();
 
-    for(RobustList<Explosion*>::const_iterator iter = explosionList.begin(); iter != explosionList.end(); ++iter) {
+    for(DenseList<Explosion*>::const_iterator iter = explosionList.begin(); iter != explosionList.end(); ++iter) {
 	    delete *iter;
 	}
 	explosionList.clear();
@@ -214,11 +237,13 @@ Game::~Game() {
 		house[i] = NULL;
 	}
 
-	delete[] FrameTime;
 	delete currentGameMap;
 	currentGameMap = NULL;
-	delete screenborder;
-	screenborder = NULL;
+
+	selectedList.clear();
+	selectedListCoord.clear();
+	houseInfoListSetup.clear();
+	triggerManager.clear();
 }
 
 
@@ -293,11 +318,24 @@ void Game::initReplay(const std::string& filename) {
 		exit(EXIT_FAILURE);
 	}
 
+	Uint32 magicNum = fs.readUint32();
+	Uint32 replayVersion = fs.readUint32();
+	if((magicNum != SAVEMAGIC) || (replayVersion != SAVEGAMEVERSION)) {
+		fprintf(stderr,"Game::initReplay(): No valid replay! Expected savegame version %d, but got %d!\n", SAVEGAMEVERSION, replayVersion);
+		exit(EXIT_FAILURE);
+	}
+
 	// read GameInitInfo
 	GameInitSettings loadedGameInitSettings(fs);
 
-	// load all commands
-	cmdManager.load(fs);
+	if(replayPathfinding != 0) {
+        // pathfinding was overridden on the command line
+        loadedGameInitSettings.setGameOptions().hierarchicalPathfinding = (replayPathfinding == 2);
+	}
+
+	// load all commands (stored in compressed blocks)
+	ICompressedStream cmdStream(&fs);
+	cmdManager.load(cmdStream);
 
 	initGame(loadedGameInitSettings);
 
@@ -305,51 +343,152 @@ void Game::initReplay(const std::string& filename) {
 }
 
 
-void Game::processObjects()
-{
-	// update all tiles
-    for(int y = 0; y < currentGameMap->getSizeY(); y++) {
-		for(int x = 0; x < currentGameMap->getSizeX(); x++) {
-            currentGameMap->getTile(x,y)->update();
+void Game::endBenchmarkPhase(BENCHMARKPHASE phase, Uint64& phaseStart) {
+	if(bBenchmark) {
+		Uint64 now = getMicroseconds();
+		benchmarkTime[phase] += now - phaseStart;
+		phaseStart = now;
+	}
+}
+
+void Game::printBenchmarkResults(Uint64 totalTime) const {
+	static const char* phaseNames[NUM_BENCHMARKPHASES] = { "commands", "houses/AI", "triggers", "tiles", "structures", "units", "bullets", "explosions" };
+
+	Uint32 numCycles = std::max(gameCycleCount, (Uint32) 1);
+
+	fprintf(stdout, "Benchmark: %d cycles in %.1f ms (%.1f cycles/s)\n", gameCycleCount, totalTime / 1000.0, (totalTime > 0) ? (gameCycleCount * 1000000.0 / totalTime) : 0.0);
+	for(int i = 0; i < NUM_BENCHMARKPHASES; i++) {
+		fprintf(stdout, "  %-12s %10.1f ms %10.2f us/cycle %6.1f%%\n", phaseNames[i], benchmarkTime[i] / 1000.0, (double) benchmarkTime[i] / numCycles,
+				(totalTime > 0) ? (benchmarkTime[i] * 100.0 / totalTime) : 0.0);
+	}
+
+	for(int i = 0; i < NUM_HOUSES; i++) {
+		if(house[i] == NULL) {
+			continue;
+		}
+
+		std::list<std::shared_ptr<Player> >::const_iterator playerIter;
+		for(playerIter = house[i]->getPlayerList().begin(); playerIter != house[i]->getPlayerList().end(); ++playerIter) {
+			const AIPlayer* pAIPlayer = dynamic_cast<const AIPlayer*>(playerIter->get());
+			if(pAIPlayer != NULL) {
+				fprintf(stdout, "  AI %-9.9s %10.1f ms %10.2f us/update (%d updates, max %d us)\n", pAIPlayer->getPlayername().c_str(),
+						pAIPlayer->getTotalUpdateTime() / 1000.0, (double) pAIPlayer->getTotalUpdateTime() / std::max(pAIPlayer->getNumUpdates(), (Uint32) 1),
+						pAIPlayer->getNumUpdates(), pAIPlayer->getMaxUpdateTime());
+			}
 		}
 	}
+	fflush(stdout);
+}
 
+void Game::benchmarkDamageSalvo() {
+	// aim at the objects left on the map
+	std::vector<Coord> targets;
+	for(DenseList<UnitBase*>::const_iterator iter = unitList.begin(); (iter != unitList.end()) && (targets.size() < BENCHMARK_SALVOSHOTS); ++iter) {
+		targets.push_back((*iter)->getCenterPoint());
+	}
+	for(DenseList<StructureBase*>::const_iterator iter = structureList.begin(); (iter != structureList.end()) && (targets.size() < BENCHMARK_SALVOSHOTS); ++iter) {
+		targets.push_back((*iter)->getCenterPoint());
+	}
 
-    for(RobustList<StructureBase*>::iterator iter = structureList.begin(); iter != structureList.end(); ++iter) {
+	if(targets.empty()) {
+		fprintf(stdout, "Damage salvo: no units or structures left to shoot at\n");
+		fflush(stdout);
+		return;
+	}
+
+	Uint64 startTime = getMicroseconds();
+
+	for(int round = 0; round < BENCHMARK_SALVOROUNDS; round++) {
+		for(int i = 0; i < BENCHMARK_SALVOSHOTS; i++) {
+			currentGameMap->damage(NONE, NULL, targets[i % targets.size()], Bullet_ShellMedium, 1.0f, TILESIZE/2, false);
+		}
+	}
+
+	Uint64 time = getMicroseconds() - startTime;
+
+	fprintf(stdout, "Damage salvo: %d shots at %d targets in %.1f us per salvo (%.2f us per shot)\n", BENCHMARK_SALVOSHOTS, (int) targets.size(),
+			(double) time / BENCHMARK_SALVOROUNDS, (double) time / (BENCHMARK_SALVOROUNDS * BENCHMARK_SALVOSHOTS));
+	fflush(stdout);
+}
+
+void Game::processObjects()
+{
+	numTargetSearches = 0;
+
+	Uint64 phaseStart = bBenchmark ? getMicroseconds() : 0;
+
+	// update all tiles with tracks or dead units
+	currentGameMap->updateActiveTiles();
+
+	// fog all tiles that have not been seen for a while
+	currentGameMap->updateFogTimeouts();
+
+	endBenchmarkPhase(BenchmarkPhase_Tiles, phaseStart);
+
+    for(DenseList<StructureBase*>::iterator iter = structureList.begin(); iter != structureList.end(); ++iter) {
         StructureBase* tempStructure = *iter;
         tempStructure->update();
     }
 
+	endBenchmarkPhase(BenchmarkPhase_Structures, phaseStart);
+
 	if ((currentCursorMode == CursorMode_Placing) && selectedList.empty()) {
 		currentCursorMode = CursorMode_Normal;
 	}
 
-	for(RobustList<UnitBase*>::iterator iter = unitList.begin(); iter != unitList.end(); ++iter) {
+	for(DenseList<UnitBase*>::iterator iter = unitList.begin(); iter != unitList.end(); ++iter) {
 		UnitBase* tempUnit = *iter;
 		tempUnit->update();
 	}
 
-    for(RobustList<Bullet*>::iterator iter = bulletList.begin(); iter != bulletList.end(); ++iter) {
+	endBenchmarkPhase(BenchmarkPhase_Units, phaseStart);
+
+    for(DenseList<Bullet*>::iterator iter = bulletList.begin(); iter != bulletList.end(); ++iter) {
         (*iter)->update();
 	}
 
-    for(RobustList<Explosion*>::iterator iter = explosionList.begin(); iter != explosionList.end(); ++iter) {
+	endBenchmarkPhase(BenchmarkPhase_Bullets, phaseStart);
+
+    for(DenseList<Explosion*>::iterator iter = explosionList.begin(); iter != explosionList.end(); ++iter) {
         (*iter)->update();
 	}
+
+	endBenchmarkPhase(BenchmarkPhase_Explosions, phaseStart);
+
+	// erase the objects removed in this cycle; nobody is iterating through the lists now
+	structureList.compact();
+	unitList.compact();
+	bulletList.compact();
+	explosionList.compact();
+
+	if(DEBUG && ((gameCycleCount % MILLI2CYCLES(10*1000)) == 0)) {
+		// validate the object tile index against the object lists of all tiles
+		currentGameMap->checkObjectTileIndex();
+	}
 }
 
-#define SAVE 1
+bool Game::mayScanForTarget(const ObjectBase* pObject) {
+	if((pObject->getLastDamageCycle() != NONE) && (gameCycleCount - pObject->getLastDamageCycle() < TARGETSEARCH_PRIORITYTIME)) {
+		// we are under fire => do not wait for our slot
+		return true;
+	}
 
-#if SAVE
-#define SAVEPERF					if (!pTile->isExplored(pLocalHouse->getHouseID())) continue;
-#else
-#define SAVEPERF
-#endif
+	if(((gameCycleCount + pObject->getObjectID()) % TARGETSEARCH_INTERVAL != 0) || (numTargetSearches >= TARGETSEARCH_BUDGET)) {
+		return false;
+	}
 
-void Game::drawScreen()
+	numTargetSearches++;
+	return true;
+}
+
+#define SAVE 1
+
+void Game::collectVisibleTiles()
 {
-	/* clear whole screen */
-	SDL_FillRect(screen, NULL, 0);
+	visibleTiles.clear();
+	for(int i = 0; i < NUM_DRAWLAYERS; i++) {
+		drawLayerBuckets[i].clear();
+	}
 
     Coord TopLeftTile = screenborder->getTopLeftTile();
     Coord BottomRightTile = screenborder->getBottomRightTile();
@@ -360,206 +499,162 @@ void Game::drawScreen()
     BottomRightTile.x = std::min(currentGameMap->getSizeX()-1, BottomRightTile.x + 1);
     BottomRightTile.y = std::min(currentGameMap->getSizeY()-1, BottomRightTile.y + 1);
 
-    Coord currentTile;
-
-    /* draw ground */
-	for(currentTile.y = TopLeftTile.y; currentTile.y <= BottomRightTile.y; currentTile.y++) {
-		for(currentTile.x = TopLeftTile.x; currentTile.x <= BottomRightTile.x; currentTile.x++) {
+	visibleTopLeftTile = TopLeftTile;
+	visibleBottomRightTile = BottomRightTile;
 
-			if (currentGameMap->tileExists(currentTile))	{
-				Tile* pTile = currentGameMap->getTile(currentTile);
-				SAVEPERF
-				pTile->blitGround( screenborder->world2screenX(currentTile.x*TILESIZE),
-                                  screenborder->world2screenY(currentTile.y*TILESIZE));
-			}
-		}
-	}
+	int houseID = pLocalHouse->getHouseID();
 
-    /* draw structures */
-	for(currentTile.y = TopLeftTile.y; currentTile.y <= BottomRightTile.y; currentTile.y++) {
-		for(currentTile.x = TopLeftTile.x; currentTile.x <= BottomRightTile.x; currentTile.x++) {
+	for(int y = TopLeftTile.y; y <= BottomRightTile.y; y++) {
+		for(int x = TopLeftTile.x; x <= BottomRightTile.x; x++) {
+			Tile* pTile = currentGameMap->getTile(x, y);
 
-			if (currentGameMap->tileExists(currentTile))	{
-				Tile* pTile = currentGameMap->getTile(currentTile);
-				SAVEPERF
-				pTile->blitStructures( screenborder->world2screenX(currentTile.x*TILESIZE),
-                                      screenborder->world2screenY(currentTile.y*TILESIZE));
-			}
-		}
-	}
+			VisibleTile visibleTile;
+			visibleTile.pTile = pTile;
+			visibleTile.screenX = screenborder->world2screenX(x*TILESIZE);
+			visibleTile.screenY = screenborder->world2screenY(y*TILESIZE);
+			visibleTile.bExplored = pTile->isExplored(houseID);
+			visibleTile.bFogged = visibleTile.bExplored && pTile->isFogged(houseID);
 
-    /* draw underground units */
-	for(currentTile.y = TopLeftTile.y; currentTile.y <= BottomRightTile.y; currentTile.y++) {
-		for(currentTile.x = TopLeftTile.x; currentTile.x <= BottomRightTile.x; currentTile.x++) {
+			Uint32 index = visibleTiles.size();
+			visibleTiles.push_back(visibleTile);
 
-			if (currentGameMap->tileExists(currentTile))	{
-				Tile* pTile = currentGameMap->getTile(currentTile);
-				SAVEPERF
-				pTile->blitUndergroundUnits( screenborder->world2screenX(currentTile.x*TILESIZE),
-                                            screenborder->world2screenY(currentTile.y*TILESIZE));
-			}
-		}
-	}
+#if SAVE
+			// unexplored tiles are covered by the shroud anyway
+			if(visibleTile.bExplored)
+#endif
+			{
+				if(pTile->hasANonInfantryGroundObject()) {
+					drawLayerBuckets[DrawLayer_Structures].push_back(index);
+					drawLayerBuckets[DrawLayer_NonInfantryGroundUnits].push_back(index);
+				}
 
-    /* draw dead objects */
-	for(currentTile.y = TopLeftTile.y; currentTile.y <= BottomRightTile.y; currentTile.y++) {
-		for(currentTile.x = TopLeftTile.x; currentTile.x <= BottomRightTile.x; currentTile.x++) {
+				if(pTile->hasAnUndergroundUnit()) {
+					drawLayerBuckets[DrawLayer_UndergroundUnits].push_back(index);
+				}
 
-			if (currentGameMap->tileExists(currentTile))	{
-				Tile* pTile = currentGameMap->getTile(currentTile);
-				SAVEPERF
-				pTile->blitDeadUnits( screenborder->world2screenX(currentTile.x*TILESIZE),
-                                     screenborder->world2screenY(currentTile.y*TILESIZE));
-			}
-		}
-	}
+				if(pTile->hasDeadUnits()) {
+					drawLayerBuckets[DrawLayer_DeadUnits].push_back(index);
+				}
 
-    /* draw infantry */
-	for(currentTile.y = TopLeftTile.y; currentTile.y <= BottomRightTile.y; currentTile.y++) {
-		for(currentTile.x = TopLeftTile.x; currentTile.x <= BottomRightTile.x; currentTile.x++) {
+				if(pTile->hasInfantry()) {
+					drawLayerBuckets[DrawLayer_Infantry].push_back(index);
+				}
 
-			if (currentGameMap->tileExists(currentTile))	{
-				Tile* pTile = currentGameMap->getTile(currentTile);
-				SAVEPERF
-				pTile->blitInfantry( screenborder->world2screenX(currentTile.x*TILESIZE),
-                                    screenborder->world2screenY(currentTile.y*TILESIZE));
+				if(pTile->hasAnAirUnit()) {
+					drawLayerBuckets[DrawLayer_AirUnits].push_back(index);
+				}
 			}
-		}
-	}
 
-    /* draw non-infantry ground units */
-	for(currentTile.y = TopLeftTile.y; currentTile.y <= BottomRightTile.y; currentTile.y++) {
-		for(currentTile.x = TopLeftTile.x; currentTile.x <= BottomRightTile.x; currentTile.x++) {
+			if((debug || visibleTile.bExplored) && pTile->hasAnObject()) {
+				drawLayerBuckets[DrawLayer_SelectionRects].push_back(index);
+			}
 
-			if (currentGameMap->tileExists(currentTile))	{
-				Tile* pTile = currentGameMap->getTile(currentTile);
-				SAVEPERF
-				pTile->blitNonInfantryGroundUnits( screenborder->world2screenX(currentTile.x*TILESIZE),
-                                                  screenborder->world2screenY(currentTile.y*TILESIZE));
+			if(debug == false) {
+				drawLayerBuckets[DrawLayer_Fog].push_back(index);
 			}
 		}
 	}
+}
 
-	/* draw bullets */
-    for(RobustList<Bullet*>::const_iterator iter = bulletList.begin(); iter != bulletList.end(); ++iter) {
-        Bullet* pBullet = *iter;
-        pBullet->blitToScreen();
+void Game::drawLayer(DRAWLAYER layer)
+{
+	if(layer == DrawLayer_Ground) {
+		// the ground comes from the terrain cache; count the tiles that had to be redrawn into it
+		TerrainCache& terrainCache = currentGameMap->getTerrainCache();
+		terrainCache.draw(screen, visibleTopLeftTile, visibleBottomRightTile);
+		numLayerDraws[layer] = terrainCache.getNumRedrawnTiles();
+		return;
 	}
 
+	const std::vector<Uint32>& bucket = drawLayerBuckets[layer];
+	numLayerDraws[layer] = bucket.size();
 
-	/* draw explosions */
-	for(RobustList<Explosion*>::const_iterator iter = explosionList.begin(); iter != explosionList.end(); ++iter) {
-        (*iter)->blitToScreen();
-	}
+	int houseID = pLocalHouse->getHouseID();
+	int zoomedTileSize = world2zoomedWorld(TILESIZE);
+	bool bFogOfWar = gameInitSettings.getGameOptions().fogOfWar;
 
-    /* draw air units */
-	for(currentTile.y = TopLeftTile.y; currentTile.y <= BottomRightTile.y; currentTile.y++) {
-		for(currentTile.x = TopLeftTile.x; currentTile.x <= BottomRightTile.x; currentTile.x++) {
+	for(std::vector<Uint32>::const_iterator iter = bucket.begin(); iter != bucket.end(); ++iter) {
+		const VisibleTile& visibleTile = visibleTiles[*iter];
+		Tile* pTile = visibleTile.pTile;
 
-			if (currentGameMap->tileExists(currentTile))	{
-				Tile* pTile = currentGameMap->getTile(currentTile);
-				SAVEPERF
-				pTile->blitAirUnits(   screenborder->world2screenX(currentTile.x*TILESIZE),
-                                      screenborder->world2screenY(currentTile.y*TILESIZE));
-			}
-		}
-	}
+		switch(layer) {
+			case DrawLayer_Structures:              pTile->blitStructures(visibleTile.screenX, visibleTile.screenY);               break;
+			case DrawLayer_UndergroundUnits:        pTile->blitUndergroundUnits(visibleTile.screenX, visibleTile.screenY);         break;
+			case DrawLayer_DeadUnits:               pTile->blitDeadUnits(visibleTile.screenX, visibleTile.screenY);                break;
+			case DrawLayer_Infantry:                pTile->blitInfantry(visibleTile.screenX, visibleTile.screenY);                 break;
+			case DrawLayer_NonInfantryGroundUnits:  pTile->blitNonInfantryGroundUnits(visibleTile.screenX, visibleTile.screenY);   break;
+			case DrawLayer_AirUnits:                pTile->blitAirUnits(visibleTile.screenX, visibleTile.screenY);                 break;
+			case DrawLayer_SelectionRects:          pTile->blitSelectionRects(visibleTile.screenX, visibleTile.screenY);           break;
 
-    /* draw selection rectangles */
-	for(currentTile.y = TopLeftTile.y; currentTile.y <= BottomRightTile.y; currentTile.y++) {
-		for(currentTile.x = TopLeftTile.x; currentTile.x <= BottomRightTile.x; currentTile.x++) {
+			case DrawLayer_Fog: {
+				if(visibleTile.bExplored) {
+					int hideTile = pTile->getHideTile(houseID);
 
-			if (currentGameMap->tileExists(currentTile))	{
-				Tile* pTile = currentGameMap->getTile(currentTile);
-
-				if(debug || pTile->isExplored(pLocalHouse->getHouseID())) {
-					pTile->blitSelectionRects(   screenborder->world2screenX(currentTile.x*TILESIZE),
-                                                screenborder->world2screenY(currentTile.y*TILESIZE));
-				}
-			}
-		}
-	}
+					if(hideTile != 0) {
+						SDL_Surface** hiddenSurf = pGFXManager->getObjPic(ObjPic_Terrain_Hidden);
 
+						SDL_Rect source = { hideTile*zoomedTileSize, 0, zoomedTileSize, zoomedTileSize };
+						SDL_Rect drawLocation = { visibleTile.screenX, visibleTile.screenY, zoomedTileSize, zoomedTileSize };
+						SDL_BlitSurface(hiddenSurf[currentZoomlevel], &source, screen, &drawLocation);
+					}
 
-//////////////////////////////draw unexplored/shade
+					if(bFogOfWar == true) {
+						int fogTile = visibleTile.bFogged ? Terrain_HiddenFull : pTile->getFogTile(houseID);
 
-	if(debug == false) {
-	    int zoomedTileSize = world2zoomedWorld(TILESIZE);
-		for(int x = screenborder->getTopLeftTile().x - 1; x <= screenborder->getBottomRightTile().x + 1; x++) {
-			for (int y = screenborder->getTopLeftTile().y - 1; y <= screenborder->getBottomRightTile().y + 1; y++) {
+						if(fogTile != 0) {
+							SDL_Rect source = { fogTile*zoomedTileSize, 0, zoomedTileSize, zoomedTileSize };
+							SDL_Rect drawLocation = { visibleTile.screenX, visibleTile.screenY, zoomedTileSize, zoomedTileSize };
+							SDL_BlitSurface(pGFXManager->getFog40Mask(currentZoomlevel), &source, screen, &drawLocation);
+						}
+					}
+				} else {
+#if !SAVE
+					SDL_Surface** hiddenSurf = pGFXManager->getObjPic(ObjPic_Terrain_Hidden);
+					SDL_Rect source = { zoomedTileSize*15, 0, zoomedTileSize, zoomedTileSize };
+					SDL_Rect drawLocation = { visibleTile.screenX, visibleTile.screenY, zoomedTileSize, zoomedTileSize };
+					SDL_BlitSurface(hiddenSurf[currentZoomlevel], &source, screen, &drawLocation);
+#endif
+				}
+			} break;
 
-				if((x >= 0) && (x < currentGameMap->getSizeX()) && (y >= 0) && (y < currentGameMap->getSizeY())) {
-					Tile* pTile = currentGameMap->getTile(x, y);
+			default: {
+			} break;
+		}
+	}
+}
 
-					if(pTile->isExplored(pLocalHouse->getHouseID())) {
-					    int hideTile = pTile->getHideTile(pLocalHouse->getHouseID());
+void Game::drawScreen()
+{
+	/* clear whole screen */
+	SDL_FillRect(screen, NULL, 0);
 
-						if(hideTile != 0) {
-						    SDL_Surface** hiddenSurf = pGFXManager->getObjPic(ObjPic_Terrain_Hidden);
+	collectVisibleTiles();
 
-						    SDL_Rect source = { hideTile*zoomedTileSize, 0, zoomedTileSize, zoomedTileSize };
-						    SDL_Rect drawLocation = {   screenborder->world2screenX(x*TILESIZE), screenborder->world2screenY(y*TILESIZE),
-                                                        zoomedTileSize, zoomedTileSize };
-							SDL_BlitSurface(hiddenSurf[currentZoomlevel], &source, screen, &drawLocation);
-						}
+	drawLayer(DrawLayer_Ground);
+	drawLayer(DrawLayer_Structures);
+	drawLayer(DrawLayer_UndergroundUnits);
+	drawLayer(DrawLayer_DeadUnits);
+	drawLayer(DrawLayer_Infantry);
+	drawLayer(DrawLayer_NonInfantryGroundUnits);
 
-						if(gameInitSettings.getGameOptions().fogOfWar == true) {
-                            int fogTile = pTile->getFogTile(pLocalHouse->getHouseID());
+	/* draw bullets */
+    for(DenseList<Bullet*>::const_iterator iter = bulletList.begin(); iter != bulletList.end(); ++iter) {
+        Bullet* pBullet = *iter;
+        pBullet->blitToScreen();
+	}
 
-                            if(pTile->isFogged(pLocalHouse->getHouseID()) == true) {
-                                fogTile = Terrain_HiddenFull;
-                            }
 
-                            if(fogTile != 0) {
-                                SDL_Rect source = { fogTile*zoomedTileSize, 0,
-                                                    zoomedTileSize, zoomedTileSize };
-                                SDL_Rect drawLocation = {   screenborder->world2screenX(x*TILESIZE), screenborder->world2screenY(y*TILESIZE),
-                                                            zoomedTileSize, zoomedTileSize };
-
-                                SDL_Rect mini = {0, 0, 1, 1};
-                                SDL_Rect drawLoc = {drawLocation.x, drawLocation.y, 0, 0};
-
-                                SDL_Surface** hiddenSurf = pGFXManager->getObjPic(ObjPic_Terrain_Hidden);
-                                SDL_Surface* fogSurf = pGFXManager->getTransparent40Surface();
-
-                                SDL_LockSurface(hiddenSurf[currentZoomlevel]);
-                                for(int i=0;i<zoomedTileSize; i++) {
-                                    for(int j=0;j<zoomedTileSize; j++) {
-                                        if(getPixel(hiddenSurf[currentZoomlevel],source.x+i,source.y+j) == 12) {
-                                            drawLoc.x = drawLocation.x + i;
-                                            drawLoc.y = drawLocation.y + j;
-                                            SDL_BlitSurface(fogSurf,&mini,screen,&drawLoc);
-                                        }
-                                    }
-                                }
-                                SDL_UnlockSurface(hiddenSurf[currentZoomlevel]);
-                            }
-						}
-					} else {
-#if !SAVE
-					    if(!debug) {
-					        SDL_Surface** hiddenSurf = pGFXManager->getObjPic(ObjPic_Terrain_Hidden);
-					        SDL_Rect source = { world2zoomedWorld(TILESIZE)*15, 0, zoomedTileSize, zoomedTileSize };
-					        SDL_Rect drawLocation = {   screenborder->world2screenX(x*TILESIZE), screenborder->world2screenY(y*TILESIZE),
-                                                        zoomedTileSize, zoomedTileSize };
-                            SDL_BlitSurface(hiddenSurf[currentZoomlevel], &source, screen, &drawLocation);
+	/* draw explosions */
+	for(DenseList<Explosion*>::const_iterator iter = explosionList.begin(); iter != explosionList.end(); ++iter) {
+        (*iter)->blitToScreen();
+	}
 
+	drawLayer(DrawLayer_AirUnits);
+	drawLayer(DrawLayer_SelectionRects);
 
+//////////////////////////////draw unexplored/shade
 
-					    }
-#endif
-					}
-				} else {
-                    /* we are outside the map => draw complete hidden
-                    SDL_Surface** hiddenSurf = pGFXManager->getObjPic(ObjPic_Terrain_Hidden);
-                    SDL_Rect source = { world2zoomedWorld(TILESIZE)*15, 0, zoomedTileSize, zoomedTileSize };
-                    SDL_Rect drawLocation = {   screenborder->world2screenX(x*TILESIZE), screenborder->world2screenY(y*TILESIZE),
-                                                zoomedTileSize, zoomedTileSize };
-                    SDL_BlitSurface(hiddenSurf[currentZoomlevel], &source, screen, &drawLocation);*/
-				}
-			}
-		}
-	}
+	drawLayer(DrawLayer_Fog);
 
 
 /////////////draw findTarget positions
@@ -943,10 +1038,9 @@ void Game::drawScreen()
 
 	// draw chat message currently typed
 	if(chatMode) {
-        surface = pFontManager->createSurfaceWithText("Chat: " + typingChatMessage + (((SDL_GetTicks() / 150) % 2 == 0) ? "_" : ""), COLOR_WHITE, FONT_STD12);
+        surface = pFontManager->getTextSurface("Chat: " + typingChatMessage + (((SDL_GetTicks() / 150) % 2 == 0) ? "_" : ""), COLOR_WHITE, FONT_STD12);
         SDL_Rect drawLocation = { 20, screen->h - 40, surface->w, surface->h };
         SDL_BlitSurface(surface, NULL, screen, &drawLocation);
-        SDL_FreeSurface(surface);
 	}
 
 	if(bShowFPS) {
@@ -986,6 +1080,98 @@ void Game::drawScreen()
 		SDL_BlitSurface(fpsSurface, NULL, screen, &drawLocation);
 		SDL_FreeSurface(fpsSurface);
 
+		snprintf(temp,50,"tiles updated: %d/%d", currentGameMap->getNumUpdatedTiles(), currentGameMap->getSizeX()*currentGameMap->getSizeY());
+		SDL_Surface* statsSurface = pFontManager->createSurfaceWithText(temp, COLOR_WHITE, FONT_STD12);
+		SDL_Rect statsLocation = { x, fy, statsSurface->w, statsSurface->h };
+		SDL_BlitSurface(statsSurface, NULL, screen, &statsLocation);
+		statsLocation.y += statsSurface->h;
+		SDL_FreeSurface(statsSurface);
+
+		snprintf(temp,50,"radar cells repainted: %d", pInterface->getRadarView().getNumRepaintedCells());
+		statsSurface = pFontManager->createSurfaceWithText(temp, COLOR_WHITE, FONT_STD12);
+		statsLocation.w = statsSurface->w;
+		statsLocation.h = statsSurface->h;
+		SDL_BlitSurface(statsSurface, NULL, screen, &statsLocation);
+		statsLocation.y += statsSurface->h;
+		SDL_FreeSurface(statsSurface);
+
+		char layerStats[128];
+		snprintf(layerStats, sizeof(layerStats), "layer draws (gnd/str/ugd/dead/inf/veh/air/sel/fog): %d/%d/%d/%d/%d/%d/%d/%d/%d",
+					numLayerDraws[DrawLayer_Ground], numLayerDraws[DrawLayer_Structures], numLayerDraws[DrawLayer_UndergroundUnits],
+					numLayerDraws[DrawLayer_DeadUnits], numLayerDraws[DrawLayer_Infantry], numLayerDraws[DrawLayer_NonInfantryGroundUnits],
+					numLayerDraws[DrawLayer_AirUnits], numLayerDraws[DrawLayer_SelectionRects], numLayerDraws[DrawLayer_Fog]);
+		statsSurface = pFontManager->createSurfaceWithText(layerStats, COLOR_WHITE, FONT_STD12);
+		statsLocation.w = statsSurface->w;
+		statsLocation.h = statsSurface->h;
+		SDL_BlitSurface(statsSurface, NULL, screen, &statsLocation);
+		statsLocation.y += statsSurface->h;
+		SDL_FreeSurface(statsSurface);
+
+		snprintf(temp,50,"pools: bullets %d/%d, explosions %d/%d",
+					(int) Bullet::getPool().getNumLive(), (int) Bullet::getPool().getCapacity(),
+					(int) Explosion::getPool().getNumLive(), (int) Explosion::getPool().getCapacity());
+		statsSurface = pFontManager->createSurfaceWithText(temp, COLOR_WHITE, FONT_STD12);
+		statsLocation.w = statsSurface->w;
+		statsLocation.h = statsSurface->h;
+		SDL_BlitSurface(statsSurface, NULL, screen, &statsLocation);
+		statsLocation.y += statsSurface->h;
+		SDL_FreeSurface(statsSurface);
+
+		snprintf(temp,50,"allocated: %d bullets, %d explosions", (int) Bullet::getPool().getNumAllocations(), (int) Explosion::getPool().getNumAllocations());
+		statsSurface = pFontManager->createSurfaceWithText(temp, COLOR_WHITE, FONT_STD12);
+		statsLocation.w = statsSurface->w;
+		statsLocation.h = statsSurface->h;
+		SDL_BlitSurface(statsSurface, NULL, screen, &statsLocation);
+		statsLocation.y += statsSurface->h;
+		SDL_FreeSurface(statsSurface);
+
+		if(lastSaveSnapshotTime > 0) {
+			snprintf(temp,50,"last save snapshot: %d.%03d ms", (int) (lastSaveSnapshotTime / 1000), (int) (lastSaveSnapshotTime % 1000));
+			statsSurface = pFontManager->createSurfaceWithText(temp, COLOR_WHITE, FONT_STD12);
+			statsLocation.w = statsSurface->w;
+			statsLocation.h = statsSurface->h;
+			SDL_BlitSurface(statsSurface, NULL, screen, &statsLocation);
+			statsLocation.y += statsSurface->h;
+			SDL_FreeSurface(statsSurface);
+		}
+
+		snprintf(temp,50,"text cache: %u hits, %u misses", pFontManager->getTextCacheHits(), pFontManager->getTextCacheMisses());
+		statsSurface = pFontManager->createSurfaceWithText(temp, COLOR_WHITE, FONT_STD12);
+		statsLocation.w = statsSurface->w;
+		statsLocation.h = statsSurface->h;
+		SDL_BlitSurface(statsSurface, NULL, screen, &statsLocation);
+		statsLocation.y += statsSurface->h;
+		SDL_FreeSurface(statsSurface);
+
+		for(int i = 0; i < NUM_HOUSES; i++) {
+			if(house[i] == NULL) {
+				continue;
+			}
+
+			std::list<std::shared_ptr<Player> >::const_iterator playerIter;
+			for(playerIter = house[i]->getPlayerList().begin(); playerIter != house[i]->getPlayerList().end(); ++playerIter) {
+				const AIPlayer* pAIPlayer = dynamic_cast<const AIPlayer*>(playerIter->get());
+				if(pAIPlayer != NULL) {
+					snprintf(temp,50,"AI %.12s: %d us (max: %d us)", pAIPlayer->getPlayername().c_str(), pAIPlayer->getLastUpdateTime(), pAIPlayer->getMaxUpdateTime());
+					statsSurface = pFontManager->createSurfaceWithText(temp, COLOR_WHITE, FONT_STD12);
+					statsLocation.w = statsSurface->w;
+					statsLocation.h = statsSurface->h;
+					SDL_BlitSurface(statsSurface, NULL, screen, &statsLocation);
+					statsLocation.y += statsSurface->h;
+					SDL_FreeSurface(statsSurface);
+				}
+			}
+		}
+
+		if(pNetworkManager != NULL) {
+			snprintf(temp,50,"network: %d B/s out, %d B/s in", pNetworkManager->getBytesSentPerSecond(), pNetworkManager->getBytesReceivedPerSecond());
+			statsSurface = pFontManager->createSurfaceWithText(temp, COLOR_WHITE, FONT_STD12);
+			statsLocation.w = statsSurface->w;
+			statsLocation.h = statsSurface->h;
+			SDL_BlitSurface(statsSurface, NULL, screen, &statsLocation);
+			SDL_FreeSurface(statsSurface);
+		}
+
 
 	}
 
@@ -994,10 +1180,10 @@ void Game::drawScreen()
 		int     seconds = getGameTime() / 1000;
 		snprintf(temp,50," %.2d:%.2d:%.2d", seconds / 3600, (seconds % 3600)/60, (seconds % 60) );*/
 
-		SDL_Surface* timeSurface = pFontManager->createSurfaceWithText(currentGame->getGameTimeString().c_str(), COLOR_WHITE, FONT_STD12);
+		// the text only changes once per second, so the cached surface is reused in all other frames
+		SDL_Surface* timeSurface = pFontManager->getTextSurface(currentGame->getGameTimeString(), COLOR_WHITE, FONT_STD12);
         SDL_Rect drawLocation = { 0, screen->h - timeSurface->h, timeSurface->w, timeSurface->h };
 		SDL_BlitSurface(timeSurface, NULL, screen, &drawLocation);
-		SDL_FreeSurface(timeSurface);
 	}
 
 	if(finished) {
@@ -1009,10 +1195,9 @@ void Game::drawScreen()
             message = _("You Have Failed Your Mission.");
         }
 
-		surface = pFontManager->createSurfaceWithText(message.c_str(), COLOR_WHITE, FONT_STD24);
+		surface = pFontManager->getTextSurface(message, COLOR_WHITE, FONT_STD24);
         SDL_Rect drawLocation = { sideBarPos.x/2 - surface->w/2, topBarPos.h + (screen->h-topBarPos.h)/2 - surface->h/2, surface->w, surface->h };
 		SDL_BlitSurface(surface, NULL, screen, &drawLocation);
-		SDL_FreeSurface(surface);
 	}
 
 	if(pWaitingForOtherPlayers != NULL) {
@@ -1640,7 +1825,7 @@ void Game::setupView()
 	//setup start location/view
 	i = j = count = 0;
 
-    RobustList<UnitBase*>::const_iterator unitIterator;
+    DenseList<UnitBase*>::const_iterator unitIterator;
 	for(unitIterator = unitList.begin(); unitIterator != unitList.end(); ++unitIterator) {
 		UnitBase* pUnit = *unitIterator;
 		if(pUnit->getOwner() == pLocalHouse) {
@@ -1650,7 +1835,7 @@ void Game::setupView()
 		}
 	}
 
-    RobustList<StructureBase*>::const_iterator structureIterator;
+    DenseList<StructureBase*>::const_iterator structureIterator;
 	for(structureIterator = structureList.begin(); structureIterator != structureList.end(); ++structureIterator) {
 		StructureBase* pStructure = *structureIterator;
 		if(pStructure->getOwner() == pLocalHouse) {
@@ -1714,9 +1899,14 @@ void Game::runMainLoop() {
 		fnkdat("replay/auto.rpl", tmp, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
 		std::string replayname(tmp);
 
-		OFileStream* pStream = new OFileStream();
-		pStream->open(replayname);
-		gameInitSettings.save(*pStream);
+		OFileStream* pFileStream = new OFileStream();
+		pFileStream->open(replayname);
+		pFileStream->writeUint32(SAVEMAGIC);
+		pFileStream->writeUint32(SAVEGAMEVERSION);
+		gameInitSettings.save(*pFileStream);
+
+		// the commands are stored in compressed blocks
+		OCompressedStream* pStream = new OCompressedStream(pFileStream, settings.general.compressSaveGames, true);
 
         // when this game was loaded we have to save the old commands to the replay file first
 		cmdManager.save(*pStream);
@@ -1728,7 +1918,26 @@ void Game::runMainLoop() {
 		pStream->flush();
 	}
 
+	// the first autosave is done one interval after the start (or the load) of the game
+	lastAutosaveCycle = gameCycleCount;
+
 	if(pNetworkManager != NULL) {
+        // a loaded game continues at gameCycleCount; the first command lists of the other players start there
+        for(int i = 0; i < NUM_HOUSES; i++) {
+            if(house[i] == NULL) {
+                continue;
+            }
+
+            std::list<std::shared_ptr<Player> >::const_iterator playerIter;
+            for(playerIter = house[i]->getPlayerList().begin(); playerIter != house[i]->getPlayerList().end(); ++playerIter) {
+                HumanPlayer* pHumanPlayer = dynamic_cast<HumanPlayer*>(playerIter->get());
+                if(pHumanPlayer != NULL) {
+                    pHumanPlayer->nextExpectedCommandsCycle = std::max(pHumanPlayer->nextExpectedCommandsCycle, gameCycleCount);
+                }
+            }
+        }
+        pNetworkManager->setFirstCommandCycle(gameCycleCount);
+
         pNetworkManager->setOnReceiveChatMessage(std::bind(&ChatManager::addChatMessage, &(pInterface->getChatManager()), std::placeholders::_1, std::placeholders::_2));
         pNetworkManager->setOnReceiveCommandList(std::bind(&CommandManager::addCommandList, &cmdManager, std::placeholders::_1, std::placeholders::_2));
         pNetworkManager->setOnReceiveSelectionList(std::bind(&Game::onReceiveSelectionList, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
@@ -1883,6 +2092,8 @@ void Game::runMainLoop() {
 
             cmdManager.update();
 
+            saveGameWriter.update();
+
 
             if(gameCycleCount <= skipToGameCycle) {
 
@@ -1901,6 +2112,10 @@ void Game::runMainLoop() {
             }
 
             if(!bWaitForNetwork && !bPause)	{
+                if(bReplay) {
+                    recordReplayCheckpoint();
+                }
+
                 pInterface->getRadarView().update();
                 cmdManager.executeCommands(gameCycleCount);
 
@@ -1932,6 +2147,14 @@ void Game::runMainLoop() {
                 }
 
                 gameCycleCount++;
+
+                if((bReplay == false) && (finished == false) && (settings.general.autosaveInterval > 0)
+                    && (gameCycleCount >= lastAutosaveCycle + MILLI2CYCLES(settings.general.autosaveInterval*60*1000))) {
+                    char tmp[FILENAME_MAX];
+                    fnkdat((pNetworkManager != NULL) ? "mpsave/autosave.dls" : "save/autosave.dls", tmp, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
+                    saveGame(tmp, true);
+                    lastAutosaveCycle = gameCycleCount;
+                }
             }
 
 
@@ -1948,6 +2171,7 @@ void Game::runMainLoop() {
     palette.applyToSurface(screen,SDL_PHYSPAL,1,palette.getSDLPalette()->ncolors-1);
     // XXX : memcheck reports a source and destination overlap in memcpy
     SDL_SetGamma(1,1,1);
+    pFontManager->clearTextCache();
 
 	// Game is finished
 
@@ -1959,9 +2183,14 @@ void Game::runMainLoop() {
 		fnkdat(std::string("replay/" + mapnameBase + ".rpl").c_str(), tmp, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
 		std::string replayname(tmp);
 
-		OFileStream* pStream = new OFileStream();
-		pStream->open(replayname);
-		gameInitSettings.save(*pStream);
+		OFileStream* pFileStream = new OFileStream();
+		pFileStream->open(replayname);
+		pFileStream->writeUint32(SAVEMAGIC);
+		pFileStream->writeUint32(SAVEGAMEVERSION);
+		gameInitSettings.save(*pFileStream);
+
+		// the commands are stored in compressed blocks
+		OCompressedStream* pStream = new OCompressedStream(pFileStream, settings.general.compressSaveGames, true);
 		cmdManager.save(*pStream);
         delete pStream;
 	}
@@ -1976,6 +2205,113 @@ void Game::runMainLoop() {
 }
 
 
+void Game::runHeadless() {
+	printf("Starting headless game...\n");
+	fflush(stdout);
+
+	// the interface is not drawn but some game code expects it to exist
+	if(pInterface == NULL) {
+        pInterface = new GameInterface();
+	}
+
+    gameState = BEGUN;
+    setNumberOfDays(nbofdays);
+
+	finishedLevel = false;
+
+	// Check if a player has lost
+	for(int j = 0; j < NUM_HOUSES; j++) {
+		if(house[j] != NULL) {
+			if(!house[j]->isAlive()) {
+				house[j]->lose(true);
+			}
+		}
+	}
+
+	cmdManager.setReadOnly(true);
+
+	// the replay does not tell when the recorded game ended, so run a bit longer than its last command
+	Uint32 lastGameCycle = cmdManager.getLastCommandCycle() + HEADLESS_EXTRACYCLES;
+
+	Uint64 startTime = getMicroseconds();
+
+	while(!bQuitGame && !finished && (gameCycleCount <= lastGameCycle)) {
+		if(bCheckReplay) {
+			recordReplayCheckpoint();
+		}
+
+		simulateHeadlessCycle();
+	}
+
+	Uint64 totalTime = getMicroseconds() - startTime;
+
+	if(bCheckReplay) {
+		// the end of the straight run is the last reference; take it before the damage salvo changes the world
+		ReplayCheckpoint lastCheckpoint;
+		lastCheckpoint.cycle = gameCycleCount;
+		saveReplayCheckpoint(lastCheckpoint.data);
+		replayCheckpoints.push_back(lastCheckpoint);
+	}
+
+	if(bBenchmark) {
+		printBenchmarkResults(totalTime);
+		benchmarkDamageSalvo();
+	}
+
+	printf("Headless game finished after %d cycles (%s)!\n", gameCycleCount, finished ? (won ? "won" : "lost") : "end of replay");
+	fflush(stdout);
+
+	if(bCheckReplay) {
+		if(checkReplayCheckpoints() == false) {
+			fprintf(stderr,"Game::runHeadless(): Seeking in the replay does not reproduce the replay!\n");
+			exit(EXIT_FAILURE);
+		}
+
+		printf("All replay checkpoints were reproduced!\n");
+		fflush(stdout);
+	}
+
+    gameState = DEINITIALIZE;
+}
+
+void Game::simulateHeadlessCycle() {
+	Uint64 phaseStart = bBenchmark ? getMicroseconds() : 0;
+
+	cmdManager.executeCommands(gameCycleCount);
+
+	endBenchmarkPhase(BenchmarkPhase_Commands, phaseStart);
+
+	for (int i = 0; i < NUM_HOUSES; i++) {
+		if (house[i] != NULL) {
+			house[i]->update();
+		}
+	}
+
+	endBenchmarkPhase(BenchmarkPhase_Houses, phaseStart);
+
+	triggerManager.trigger(gameCycleCount);
+
+	endBenchmarkPhase(BenchmarkPhase_Triggers, phaseStart);
+
+	processObjects();
+
+	gameCycleCount++;
+}
+
+void Game::pauseGame()
+{
+    if(bPause != true) {
+        bPause = true;
+        palette.invertPalette();
+        palette.applyToSurface(screen,SDL_PHYSPAL,1,palette.getSDLPalette()->ncolors-1);
+        //	XXX memcheck reports a source and destination overlap in memcpy
+        SDL_SetGamma(1,1,1);
+        // cached texts and terrain chunks still use the old palette
+        pFontManager->clearTextCache();
+        currentGameMap->getTerrainCache().clear();
+    }
+}
+
 void Game::resumeGame()
 {
 	bMenu = false;
@@ -1984,6 +2320,8 @@ void Game::resumeGame()
         palette.invertPalette();
         palette.applyToSurface(screen,SDL_PHYSPAL,1,palette.getSDLPalette()->ncolors-1);
         SDL_SetGamma(1,1,1);
+        pFontManager->clearTextCache();
+        currentGameMap->getTerrainCache().clear();
 	}
 }
 
@@ -2118,7 +2456,7 @@ bool Game::loadSaveGame(std::string filename) {
     return ret;
 }
 
-bool Game::loadSaveGame(InputStream& stream) {
+bool Game::loadSaveGame(InputStream& stream, bool bLoadCommands) {
 	gameState = LOADING;
 
 	Uint32 magicNum = stream.readUint32();
@@ -2142,38 +2480,44 @@ bool Game::loadSaveGame(InputStream& stream) {
 	// read gameInitSettings
 	gameInitSettings = GameInitSettings(stream);
 
+	// multiplayer savegames (and checkpoints of multiplayer replays) do not contain the local player, the selection and the screenborder
+	bool bMultiplayerSave = (gameInitSettings.getGameType() == GAMETYPE_CUSTOM_MULTIPLAYER);
+
     // read the actual house setup choosen at the beginning of the game
     Uint32 numHouseInfo = stream.readUint32();
 	for(Uint32 i=0;i<numHouseInfo;i++) {
         houseInfoListSetup.push_back(GameInitSettings::HouseInfo(stream));
 	}
 
+	// the rest of the savegame is stored in compressed blocks
+	ICompressedStream bodyStream(&stream);
+
 	//read map size
-	short mapSizeX = stream.readUint32();
-	short mapSizeY = stream.readUint32();
+	short mapSizeX = bodyStream.readUint32();
+	short mapSizeY = bodyStream.readUint32();
 
 	//create the new map
 	currentGameMap = new Map(mapSizeX, mapSizeY);
 
 	//read GameCycleCount & day info
-	gameCycleCount = stream.readUint32();
-	setNumberOfDays(stream.readUint32());
-	setDayPhase((Phase)stream.readSint8());
+	gameCycleCount = bodyStream.readUint32();
+	setNumberOfDays(bodyStream.readUint32());
+	setDayPhase((Phase)bodyStream.readSint8());
 
 	// read some settings
-	gameType = (GAMETYPE) stream.readSint8();
-	techLevel = stream.readUint8();
-	gamespeed = stream.readUint32();
-	randomGen.setSeed(stream.readUint32());
+	gameType = (GAMETYPE) bodyStream.readSint8();
+	techLevel = bodyStream.readUint8();
+	gamespeed = bodyStream.readUint32();
+	randomGen.setSeed(bodyStream.readUint32());
 
     // read in the unit/structure data
-    objectData.load(stream);
+    objectData.load(bodyStream);
 
 	//load the house(s) info
 	for(int i=0; i<NUM_HOUSES; i++) {
-		if (stream.readBool() == true) {
+		if (bodyStream.readBool() == true) {
 		    //house in game
-	        house[i] = new House(stream);
+	        house[i] = new House(bodyStream);
 		}
 	}
 
@@ -2222,43 +2566,47 @@ bool Game::loadSaveGame(InputStream& stream) {
                 }
             }
         }
+	} else if(bMultiplayerSave) {
+	    // a checkpoint of a multiplayer replay; the local player is set up by restoreReplayCheckpoint()
 	} else {
 	    // it is stored in the savegame, so set it up
-        Uint8 localPlayerID = stream.readUint8();
+        Uint8 localPlayerID = bodyStream.readUint8();
         pLocalPlayer = dynamic_cast<HumanPlayer*>(getPlayerByID(localPlayerID));
         pLocalHouse = house[pLocalPlayer->getHouse()->getHouseID()];
 	}
 
-	debug = stream.readBool();
-    bCheatsEnabled = stream.readBool();
+	debug = bodyStream.readBool();
+    bCheatsEnabled = bodyStream.readBool();
 
-	winFlags = stream.readUint32();
-	loseFlags = stream.readUint32();
+	winFlags = bodyStream.readUint32();
+	loseFlags = bodyStream.readUint32();
 
-	currentGameMap->load(stream);
+	currentGameMap->load(bodyStream);
 
 	//load the structures and units
-	objectManager.load(stream);
+	objectManager.load(bodyStream);
 
-	int numBullets = stream.readUint32();
+	int numBullets = bodyStream.readUint32();
 	for(int i = 0; i < numBullets; i++) {
-		bulletList.push_back(new Bullet(stream));
+		bulletList.push_back(new Bullet(bodyStream));
 	}
 
-    int numExplosions = stream.readUint32();
+    int numExplosions = bodyStream.readUint32();
 	for(int i = 0; i < numExplosions; i++) {
-		explosionList.push_back(new Explosion(stream));
+		explosionList.push_back(new Explosion(bodyStream));
 	}
 
-    if(bMultiplayerLoad) {
+    if(bMultiplayerSave) {
         screenborder->adjustScreenBorderToMapsize(currentGameMap->getSizeX(), currentGameMap->getSizeY());
 
-        screenborder->setNewScreenCenter(pLocalHouse->getCenterOfMainBase()*TILESIZE);
+        if(bMultiplayerLoad) {
+            screenborder->setNewScreenCenter(pLocalHouse->getCenterOfMainBase()*TILESIZE);
+        }
 
     } else {
         //load selection list
-        selectedList = stream.readUint32List();
-        selectedListCoord = stream.readUint32CoordPairList();
+        selectedList = bodyStream.readUint32List();
+        selectedListCoord = bodyStream.readUint32CoordPairList();
 
    	 /*for(std::list<std::pair<Uint32,Coord>>::iterator iter2  = selectedListCoord.begin()  ;  iter2 != selectedListCoord.end(); ++iter2) {
    		 fprintf(stdout,"Game::loadSaveGame first:%d second:%d,%d\n",iter2->first, iter2->second.x, iter2->second.y);
@@ -2266,17 +2614,19 @@ bool Game::loadSaveGame(InputStream& stream) {
 
         //load the screenborder info
         screenborder->adjustScreenBorderToMapsize(currentGameMap->getSizeX(), currentGameMap->getSizeY());
-        screenborder->load(stream);
+        screenborder->load(bodyStream);
     }
 
     // assign a groupleader
     groupLeader = findGroupLeader();
 
     // load triggers
-    triggerManager.load(stream);
+    triggerManager.load(bodyStream);
 
     // CommandManager is at the very end of the file. DO NOT CHANGE THIS!
-	cmdManager.load(stream);
+    if(bLoadCommands) {
+        cmdManager.load(bodyStream);
+    }
 
 	finished = false;
 
@@ -2284,8 +2634,25 @@ bool Game::loadSaveGame(InputStream& stream) {
 }
 
 
-bool Game::saveGame(std::string filename)
+bool Game::saveGame(std::string filename, bool bInBackground)
 {
+	if(bInBackground) {
+		// take a snapshot in memory at this cycle boundary; writing and compressing it is done by another thread
+		Uint64 startTime = getMicroseconds();
+
+		OMemoryStream headerStream;
+		headerStream.open();
+		saveGameHeader(headerStream);
+
+		OMemoryStream bodyStream;
+		bodyStream.open();
+		saveGameBody(bodyStream);
+
+		lastSaveSnapshotTime = getMicroseconds() - startTime;
+
+		return saveGameWriter.startSave(filename, headerStream, bodyStream, settings.general.compressSaveGames);
+	}
+
 	OFileStream fs;
 
 	if(fs.open(filename) == false) {
@@ -2294,93 +2661,211 @@ bool Game::saveGame(std::string filename)
 		return false;
 	}
 
-	fs.writeUint32(SAVEMAGIC);
+	saveGameHeader(fs);
+
+	// the rest of the savegame is stored in compressed blocks
+	OCompressedStream stream(&fs, settings.general.compressSaveGames);
 
-	fs.writeUint32(SAVEGAMEVERSION);
+	saveGameBody(stream);
 
-	fs.writeString(VERSIONSTRING);
+	stream.flush();
+
+	fs.close();
+
+	return true;
+}
+
+void Game::saveGameHeader(OutputStream& stream)
+{
+	stream.writeUint32(SAVEMAGIC);
+
+	stream.writeUint32(SAVEGAMEVERSION);
+
+	stream.writeString(VERSIONSTRING);
 
 	// write gameInitSettings
-	gameInitSettings.save(fs);
+	gameInitSettings.save(stream);
 
-    fs.writeUint32(houseInfoListSetup.size());
+    stream.writeUint32(houseInfoListSetup.size());
 	GameInitSettings::HouseInfoList::const_iterator iter;
 	for(iter = houseInfoListSetup.begin(); iter != houseInfoListSetup.end(); ++iter) {
-        iter->save(fs);
+        iter->save(stream);
 	}
+}
 
+void Game::saveGameBody(OutputStream& stream, bool bSaveCommands)
+{
 	//write the map size
-	fs.writeUint32(currentGameMap->getSizeX());
-	fs.writeUint32(currentGameMap->getSizeY());
+	stream.writeUint32(currentGameMap->getSizeX());
+	stream.writeUint32(currentGameMap->getSizeY());
 
 	// write GameCycleCount & day info
-	fs.writeUint32(gameCycleCount);
-	fs.writeUint32(getNumberOfDays());
-	fs.writeSint8(getDayPhase());
+	stream.writeUint32(gameCycleCount);
+	stream.writeUint32(getNumberOfDays());
+	stream.writeSint8(getDayPhase());
 
 	// write some settings
-	fs.writeSint8(gameType);
-	fs.writeUint8(techLevel);
-    fs.writeUint32(gamespeed);
-	fs.writeUint32(randomGen.getSeed());
+	stream.writeSint8(gameType);
+	stream.writeUint8(techLevel);
+    stream.writeUint32(gamespeed);
+	stream.writeUint32(randomGen.getSeed());
 
     // write out the unit/structure data
-    objectData.save(fs);
+    objectData.save(stream);
 
 	//write the house(s) info
 	for(int i=0; i<NUM_HOUSES; i++) {
-		fs.writeBool(house[i] != NULL);
+		stream.writeBool(house[i] != NULL);
 
 		if(house[i] != NULL) {
-			house[i]->save(fs);
+			house[i]->save(stream);
 		}
 	}
 
     if(gameInitSettings.getGameType() != GAMETYPE_CUSTOM_MULTIPLAYER) {
-        fs.writeUint8(pLocalPlayer->getPlayerID());
+        stream.writeUint8(pLocalPlayer->getPlayerID());
     }
 
-	fs.writeBool(debug);
-	fs.writeBool(bCheatsEnabled);
+	stream.writeBool(debug);
+	stream.writeBool(bCheatsEnabled);
 
-	fs.writeUint32(winFlags);
-    fs.writeUint32(loseFlags);
+	stream.writeUint32(winFlags);
+    stream.writeUint32(loseFlags);
 
-	currentGameMap->save(fs);
+	currentGameMap->save(stream);
 
 	// save the structures and units
-	objectManager.save(fs);
+	objectManager.save(stream);
 
-	fs.writeUint32(bulletList.size());
-	for(RobustList<Bullet*>::const_iterator iter = bulletList.begin(); iter != bulletList.end(); ++iter) {
-		(*iter)->save(fs);
+	stream.writeUint32(bulletList.size());
+	for(DenseList<Bullet*>::const_iterator iter = bulletList.begin(); iter != bulletList.end(); ++iter) {
+		(*iter)->save(stream);
 	}
 
-	fs.writeUint32(explosionList.size());
-	for(RobustList<Explosion*>::const_iterator iter = explosionList.begin(); iter != explosionList.end(); ++iter) {
-		(*iter)->save(fs);
+	stream.writeUint32(explosionList.size());
+	for(DenseList<Explosion*>::const_iterator iter = explosionList.begin(); iter != explosionList.end(); ++iter) {
+		(*iter)->save(stream);
 	}
 
     if(gameInitSettings.getGameType() != GAMETYPE_CUSTOM_MULTIPLAYER) {
         // save selection lists
 
         // write out selected units list
-        fs.writeUint32List(selectedList);
-        fs.writeUint32CoordPairList(selectedListCoord);
+        stream.writeUint32List(selectedList);
+        stream.writeUint32CoordPairList(selectedListCoord);
 
         // write the screenborder info
-        screenborder->save(fs);
+        screenborder->save(stream);
     }
 
     // save triggers
-	triggerManager.save(fs);
+	triggerManager.save(stream);
 
     // CommandManager is at the very end of the file. DO NOT CHANGE THIS!
-	cmdManager.save(fs);
+    if(bSaveCommands) {
+        cmdManager.save(stream);
+    }
+}
 
-	fs.close();
 
-	return true;
+void Game::seekReplay(Uint32 targetCycle) {
+    if(bReplay == false) {
+        return;
+    }
+
+    // find the last checkpoint before targetCycle
+    const ReplayCheckpoint* pCheckpoint = NULL;
+    std::vector<ReplayCheckpoint>::const_iterator iter;
+    for(iter = replayCheckpoints.begin(); (iter != replayCheckpoints.end()) && (iter->cycle <= targetCycle); ++iter) {
+        pCheckpoint = &(*iter);
+    }
+
+    if((pCheckpoint != NULL) && ((targetCycle < gameCycleCount) || (pCheckpoint->cycle > gameCycleCount))) {
+        restoreReplayCheckpoint(*pCheckpoint);
+    }
+
+    // simulate the remaining game cycles
+    skipToGameCycle = targetCycle;
+}
+
+void Game::recordReplayCheckpoint() {
+    if(!replayCheckpoints.empty() && (gameCycleCount < replayCheckpoints.back().cycle + REPLAY_CHECKPOINTINTERVAL)) {
+        return;
+    }
+
+    ReplayCheckpoint checkpoint;
+    checkpoint.cycle = gameCycleCount;
+    saveReplayCheckpoint(checkpoint.data);
+    replayCheckpoints.push_back(checkpoint);
+}
+
+void Game::saveReplayCheckpoint(std::string& data) {
+    // the commands are still held by the command manager
+    OMemoryStream stream;
+    stream.open();
+    saveGameHeader(stream);
+
+    OCompressedStream bodyStream(&stream);
+    saveGameBody(bodyStream, false);
+    bodyStream.flush();
+
+    data.assign(stream.getData(), stream.getDataLength());
+}
+
+bool Game::checkReplayCheckpoints() {
+    printf("Checking %d replay checkpoints...\n", (int) replayCheckpoints.size() - 1);
+    fflush(stdout);
+
+    bool bReproduced = true;
+    for(size_t i = 0; i + 1 < replayCheckpoints.size(); i++) {
+        restoreReplayCheckpoint(replayCheckpoints[i]);
+
+        while(gameCycleCount < replayCheckpoints[i+1].cycle) {
+            simulateHeadlessCycle();
+        }
+
+        std::string data;
+        saveReplayCheckpoint(data);
+        if(data != replayCheckpoints[i+1].data) {
+            fprintf(stderr,"Game::checkReplayCheckpoints(): Simulating from game cycle %d to game cycle %d after restoring a checkpoint differs from playing straight through!\n", replayCheckpoints[i].cycle, replayCheckpoints[i+1].cycle);
+            bReproduced = false;
+        }
+    }
+
+    return bReproduced;
+}
+
+void Game::restoreReplayCheckpoint(const ReplayCheckpoint& checkpoint) {
+    // keep the view of the player watching the replay
+    Coord oldCenterCoord = screenborder->getCurrentCenter();
+    Uint8 localPlayerID = pLocalPlayer->getPlayerID();
+    GAMESTATETYPE oldGameState = gameState;
+
+    currentCursorMode = CursorMode_Normal;
+
+    destroyWorld();
+    pLocalHouse = NULL;
+    pLocalPlayer = NULL;
+
+    IMemoryStream stream(checkpoint.data.c_str(), checkpoint.data.size());
+    if(loadSaveGame(stream, false) == false) {
+        fprintf(stderr,"Game::restoreReplayCheckpoint(): Cannot restore the checkpoint at game cycle %d!\n", checkpoint.cycle);
+        exit(EXIT_FAILURE);
+    }
+
+    if(pLocalPlayer == NULL) {
+        pLocalPlayer = dynamic_cast<HumanPlayer*>(getPlayerByID(localPlayerID));
+        pLocalHouse = house[pLocalPlayer->getHouse()->getHouseID()];
+    }
+
+    gameState = oldGameState;
+
+    // the replay continues with the commands of the checkpoint's game cycle
+    cmdManager.seekLoadedCommands(gameCycleCount);
+
+    screenborder->setNewScreenCenter(oldCenterCoord);
+    pInterface->getRadarView().setRadarMode(pLocalHouse->hasRadarOn());
+    pInterface->updateObjectInterface();
 }
 
 
@@ -2639,7 +3124,7 @@ void Game::handleChatInput(SDL_KeyboardEvent& keyboardEvent) {
 				if (gameType != GAMETYPE_CUSTOM_MULTIPLAYER) {
 					pInterface->getChatManager().addInfoMessage("SuperWeapon INSANE recharge rate !!!");
 
-				    for(RobustList<StructureBase*>::iterator iter = structureList.begin(); iter != structureList.end(); ++iter) {
+				    for(DenseList<StructureBase*>::iterator iter = structureList.begin(); iter != structureList.end(); ++iter) {
 				        StructureBase* tempStructure = *iter;
 				        if (tempStructure->getItemID() == Structure_Palace) {
 				        	Palace* pPalace = dynamic_cast<Palace*>(tempStructure);
@@ -2992,18 +3477,36 @@ void Game::handleKeyInput(SDL_KeyboardEvent& keyboardEvent) {
 
         case SDLK_F5: {
             // skip a 30 seconds
-            if(gameType != GAMETYPE_CUSTOM_MULTIPLAYER || bReplay) {
+            if(bReplay) {
+                seekReplay(gameCycleCount + (30*1000)/GAMESPEED_DEFAULT);
+            } else if(gameType != GAMETYPE_CUSTOM_MULTIPLAYER) {
                 skipToGameCycle = gameCycleCount + (30*1000)/GAMESPEED_DEFAULT;
             }
         } break;
 
         case SDLK_F6: {
             // skip 2 minutes
-            if(gameType != GAMETYPE_CUSTOM_MULTIPLAYER || bReplay) {
+            if(bReplay) {
+                seekReplay(gameCycleCount + (120*1000)/GAMESPEED_DEFAULT);
+            } else if(gameType != GAMETYPE_CUSTOM_MULTIPLAYER) {
                 skipToGameCycle = gameCycleCount + (120*1000)/GAMESPEED_DEFAULT;
             }
         } break;
 
+        case SDLK_F7: {
+            // go back 30 seconds in a replay
+            if(bReplay) {
+                seekReplay(std::max((int) gameCycleCount - (30*1000)/GAMESPEED_DEFAULT, 0));
+            }
+        } break;
+
+        case SDLK_F8: {
+            // go back 2 minutes in a replay
+            if(bReplay) {
+                seekReplay(std::max((int) gameCycleCount - (120*1000)/GAMESPEED_DEFAULT, 0));
+            }
+        } break;
+
         case SDLK_F10: {
             soundPlayer->toggleSound();
         } break;
@@ -96,6 +96,8 @@ GameInitSettings::GameInitSettings(InputStream& stream) {
 	gameOptions.killedSandwormsDropSpice = stream.readBool();
 	gameOptions.daynight = stream.readBool();
 	gameOptions.dayscale = stream.readUint8();
+	gameOptions.hierarchicalPathfinding = stream.readBool();
+	gameOptions.flowFieldPathfinding = stream.readBool();
 
 	Uint32 numHouseInfo = stream.readUint32();
 	for(Uint32 i=0;i<numHouseInfo;i++) {
@@ -129,6 +131,8 @@ void GameInitSettings::save(OutputStream& stream) const {
 	stream.writeBool(gameOptions.killedSandwormsDropSpice);
 	stream.writeBool(gameOptions.daynight);
 	stream.writeUint8(gameOptions.dayscale);
+	stream.writeBool(gameOptions.hierarchicalPathfinding);
+	stream.writeBool(gameOptions.flowFieldPathfinding);
 
 
 	stream.writeUint32(houseInfoList.size());
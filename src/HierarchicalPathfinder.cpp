@@ -0,0 +1,414 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <HierarchicalPathfinder.h>
+
+#include <globals.h>
+
+#include <AStarSearch.h>
+#include <Map.h>
+#include <Tile.h>
+#include <units/UnitBase.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
+typedef std::pair<float, int> CostIndexPair;
+typedef std::priority_queue<CostIndexPair, std::vector<CostIndexPair>, std::greater<CostIndexPair> > CostIndexQueue;
+
+static const float INFINITE_COST = std::numeric_limits<float>::infinity();
+
+HierarchicalPathfinder::HierarchicalPathfinder(Map* pMap)
+ : pMap(pMap) {
+    numClustersX = (pMap->getSizeX() + HPA_CLUSTERSIZE - 1) / HPA_CLUSTERSIZE;
+    numClustersY = (pMap->getSizeY() + HPA_CLUSTERSIZE - 1) / HPA_CLUSTERSIZE;
+}
+
+HierarchicalPathfinder::~HierarchicalPathfinder() {
+}
+
+HierarchicalPathfinder::MOVECLASS HierarchicalPathfinder::getMoveClass(const UnitBase* pUnit) {
+    if(pUnit->isAFlyingUnit()) {
+        return MoveClass_Invalid;
+    } else if(pUnit->getItemID() == Unit_Sandworm) {
+        return MoveClass_Sand;
+    } else if(pUnit->isInfantry()) {
+        return MoveClass_Infantry;
+    } else {
+        return MoveClass_Ground;
+    }
+}
+
+void HierarchicalPathfinder::tileChanged(const Coord& pos) {
+    if(!pMap->tileExists(pos)) {
+        return;
+    }
+
+    int clusterX = pos.x / HPA_CLUSTERSIZE;
+    int clusterY = pos.y / HPA_CLUSTERSIZE;
+    int localX = pos.x % HPA_CLUSTERSIZE;
+    int localY = pos.y % HPA_CLUSTERSIZE;
+
+    for(int i = 0; i < NUM_MOVECLASSES; i++) {
+        Layer& layer = layers[i];
+        if(layer.bInitialized == false) {
+            continue;
+        }
+
+        layer.clusters[clusterY*numClustersX + clusterX].bDirty = true;
+
+        // tiles on the border also change the transitions of the neighbour cluster
+        if((localX == 0) && (clusterX > 0)) {
+            layer.clusters[clusterY*numClustersX + clusterX - 1].bDirty = true;
+        }
+        if((localX == HPA_CLUSTERSIZE - 1) && (clusterX < numClustersX - 1)) {
+            layer.clusters[clusterY*numClustersX + clusterX + 1].bDirty = true;
+        }
+        if((localY == 0) && (clusterY > 0)) {
+            layer.clusters[(clusterY-1)*numClustersX + clusterX].bDirty = true;
+        }
+        if((localY == HPA_CLUSTERSIZE - 1) && (clusterY < numClustersY - 1)) {
+            layer.clusters[(clusterY+1)*numClustersX + clusterX].bDirty = true;
+        }
+    }
+}
+
+bool HierarchicalPathfinder::searchPath(UnitBase* pUnit, const Coord& start, const Coord& destination, std::list<Coord>& path) {
+    path.clear();
+
+    MOVECLASS moveClass = getMoveClass(pUnit);
+    if(moveClass == MoveClass_Invalid) {
+        return false;
+    }
+
+    if(!pMap->tileExists(start) || !pMap->tileExists(destination) || (blockDistance(start, destination) < HPA_MINDISTANCE)) {
+        return false;
+    }
+
+    int startCluster = getClusterIndex(start);
+    int goalCluster = getClusterIndex(destination);
+    if((startCluster == goalCluster) || !isPassable(moveClass, start.x, start.y) || !isPassable(moveClass, destination.x, destination.y)) {
+        return false;
+    }
+
+    updateLayer(moveClass);
+    Layer& layer = layers[moveClass];
+
+    // costs from the start to all tiles of the start cluster and from all tiles of the goal cluster to the goal
+    std::vector<float> startDistances;
+    std::vector<float> goalDistances;
+    calculateClusterDistances(moveClass, startCluster, start, startDistances);
+    calculateClusterDistances(moveClass, goalCluster, destination, goalDistances);
+
+    // number the nodes of all clusters consecutively; the goal gets the last number
+    std::vector<int> firstNode(layer.clusters.size());
+    int numNodes = 0;
+    for(size_t i = 0; i < layer.clusters.size(); i++) {
+        firstNode[i] = numNodes;
+        numNodes += layer.clusters[i].nodes.size();
+    }
+    const int goalNode = numNodes;
+
+    std::vector<float> g(numNodes + 1, INFINITE_COST);
+    std::vector<int> parent(numNodes + 1, -1);
+    std::vector<bool> closed(numNodes + 1, false);
+    std::vector<int> nodeCluster(numNodes + 1, -1);
+    CostIndexQueue openList;
+
+    const int startX = (startCluster % numClustersX) * HPA_CLUSTERSIZE;
+    const int startY = (startCluster / numClustersX) * HPA_CLUSTERSIZE;
+    const Cluster& firstCluster = layer.clusters[startCluster];
+    for(size_t i = 0; i < firstCluster.nodes.size(); i++) {
+        const Coord& node = firstCluster.nodes[i];
+        float cost = startDistances[(node.y - startY) * HPA_CLUSTERSIZE + (node.x - startX)];
+        if(cost < INFINITE_COST) {
+            int id = firstNode[startCluster] + i;
+            g[id] = cost;
+            nodeCluster[id] = startCluster;
+            openList.push(CostIndexPair(cost + blockDistance(node, destination), id));
+        }
+    }
+
+    const int goalX = (goalCluster % numClustersX) * HPA_CLUSTERSIZE;
+    const int goalY = (goalCluster / numClustersX) * HPA_CLUSTERSIZE;
+
+    while(openList.empty() == false) {
+        int currentNode = openList.top().second;
+        openList.pop();
+
+        if(closed[currentNode]) {
+            continue;
+        }
+        closed[currentNode] = true;
+
+        if(currentNode == goalNode) {
+            break;
+        }
+
+        int currentClusterIndex = nodeCluster[currentNode];
+        const Cluster& currentCluster = layer.clusters[currentClusterIndex];
+        int localNode = currentNode - firstNode[currentClusterIndex];
+        const Coord& currentCoord = currentCluster.nodes[localNode];
+        int numClusterNodes = currentCluster.nodes.size();
+
+        // edges inside the cluster
+        for(int i = 0; i < numClusterNodes; i++) {
+            float cost = currentCluster.distances[localNode*numClusterNodes + i];
+            int nextNode = firstNode[currentClusterIndex] + i;
+            if((cost < INFINITE_COST) && (closed[nextNode] == false) && (g[currentNode] + cost < g[nextNode])) {
+                g[nextNode] = g[currentNode] + cost;
+                parent[nextNode] = currentNode;
+                nodeCluster[nextNode] = currentClusterIndex;
+                openList.push(CostIndexPair(g[nextNode] + blockDistance(currentCluster.nodes[i], destination), nextNode));
+            }
+        }
+
+        // edge to the goal
+        if(currentClusterIndex == goalCluster) {
+            float cost = goalDistances[(currentCoord.y - goalY) * HPA_CLUSTERSIZE + (currentCoord.x - goalX)];
+            if((cost < INFINITE_COST) && (g[currentNode] + cost < g[goalNode])) {
+                g[goalNode] = g[currentNode] + cost;
+                parent[goalNode] = currentNode;
+                openList.push(CostIndexPair(g[goalNode], goalNode));
+            }
+        }
+
+        // edges into the neighbour clusters
+        const std::vector<Coord>& exits = currentCluster.exits[localNode];
+        for(size_t i = 0; i < exits.size(); i++) {
+            const Coord& exit = exits[i];
+            int exitClusterIndex = getClusterIndex(exit);
+            int exitLocalNode = layer.nodeIndex[exit.x + exit.y*pMap->getSizeX()];
+            if(exitLocalNode < 0) {
+                continue;
+            }
+
+            int nextNode = firstNode[exitClusterIndex] + exitLocalNode;
+            float cost = getStepCost(moveClass, exit.x, exit.y, false);
+            if((closed[nextNode] == false) && (g[currentNode] + cost < g[nextNode])) {
+                g[nextNode] = g[currentNode] + cost;
+                parent[nextNode] = currentNode;
+                nodeCluster[nextNode] = exitClusterIndex;
+                openList.push(CostIndexPair(g[nextNode] + blockDistance(exit, destination), nextNode));
+            }
+        }
+    }
+
+    if(closed[goalNode] == false) {
+        return false;
+    }
+
+    std::vector<Coord> waypoints;
+    waypoints.push_back(destination);
+    for(int node = parent[goalNode]; node != -1; node = parent[node]) {
+        waypoints.push_back(layer.clusters[nodeCluster[node]].nodes[node - firstNode[nodeCluster[node]]]);
+    }
+    std::reverse(waypoints.begin(), waypoints.end());
+
+    // refine the first waypoints into a tile path; the unit searches again when it has walked it
+    Coord currentCoord = start;
+    int numRefined = 0;
+    for(size_t i = 0; (i < waypoints.size()) && (numRefined < HPA_REFINEDWAYPOINTS); i++) {
+        const Coord& waypoint = waypoints[i];
+
+        // skip entry nodes directly next to the following exit node
+        if((i + 1 < waypoints.size()) && (blockDistance(waypoint, waypoints[i+1]) < 1.5f) && (getClusterIndex(waypoint) == getClusterIndex(currentCoord))) {
+            continue;
+        }
+
+        if(waypoint == currentCoord) {
+            continue;
+        }
+
+        AStarSearch pathfinder(pMap, pUnit, currentCoord, waypoint);
+        std::list<Coord> segment = pathfinder.getFoundPath();
+        if(segment.empty()) {
+            break;
+        }
+
+        path.splice(path.end(), segment);
+        numRefined++;
+
+        if(path.back() != waypoint) {
+            // blocked by units; take what we have
+            break;
+        }
+        currentCoord = waypoint;
+    }
+
+    return (path.empty() == false);
+}
+
+bool HierarchicalPathfinder::isPassable(MOVECLASS moveClass, int x, int y) const {
+    const Tile* pTile = pMap->getTile(x,y);
+
+    switch(moveClass) {
+        case MoveClass_Ground:      return (!pTile->isMountain() && !pTile->hasAStructure());
+        case MoveClass_Infantry:    return !pTile->hasAStructure();
+        case MoveClass_Sand:        return !pTile->isRock();
+        default:                    return false;
+    }
+}
+
+float HierarchicalPathfinder::getStepCost(MOVECLASS moveClass, int x, int y, bool bDiagonal) const {
+    float difficulty = (moveClass == MoveClass_Sand) ? 1.0f : pMap->getTile(x,y)->getDifficulty();
+    return bDiagonal ? DIAGONALCOST*difficulty : difficulty;
+}
+
+void HierarchicalPathfinder::updateLayer(MOVECLASS moveClass) {
+    Layer& layer = layers[moveClass];
+
+    if(layer.bInitialized == false) {
+        layer.clusters.assign(numClustersX*numClustersY, Cluster());
+        layer.nodeIndex.assign(pMap->getSizeX()*pMap->getSizeY(), -1);
+        layer.bInitialized = true;
+    }
+
+    for(size_t i = 0; i < layer.clusters.size(); i++) {
+        if(layer.clusters[i].bDirty) {
+            rebuildCluster(moveClass, i);
+        }
+    }
+}
+
+void HierarchicalPathfinder::rebuildCluster(MOVECLASS moveClass, int clusterIndex) {
+    Layer& layer = layers[moveClass];
+    Cluster& cluster = layer.clusters[clusterIndex];
+
+    for(size_t i = 0; i < cluster.nodes.size(); i++) {
+        layer.nodeIndex[cluster.nodes[i].x + cluster.nodes[i].y*pMap->getSizeX()] = -1;
+    }
+    cluster.nodes.clear();
+    cluster.exits.clear();
+    cluster.distances.clear();
+
+    int x1 = (clusterIndex % numClustersX) * HPA_CLUSTERSIZE;
+    int y1 = (clusterIndex / numClustersX) * HPA_CLUSTERSIZE;
+    int x2 = std::min(x1 + HPA_CLUSTERSIZE, pMap->getSizeX()) - 1;
+    int y2 = std::min(y1 + HPA_CLUSTERSIZE, pMap->getSizeY()) - 1;
+    int width = x2 - x1 + 1;
+    int height = y2 - y1 + 1;
+
+    if(y1 > 0) {
+        addBorderTransitions(moveClass, clusterIndex, Coord(x1,y1), Coord(1,0), Coord(0,-1), width);
+    }
+    if(y2 < pMap->getSizeY() - 1) {
+        addBorderTransitions(moveClass, clusterIndex, Coord(x1,y2), Coord(1,0), Coord(0,1), width);
+    }
+    if(x1 > 0) {
+        addBorderTransitions(moveClass, clusterIndex, Coord(x1,y1), Coord(0,1), Coord(-1,0), height);
+    }
+    if(x2 < pMap->getSizeX() - 1) {
+        addBorderTransitions(moveClass, clusterIndex, Coord(x2,y1), Coord(0,1), Coord(1,0), height);
+    }
+
+    int numNodes = cluster.nodes.size();
+    cluster.distances.assign(numNodes*numNodes, INFINITE_COST);
+
+    std::vector<float> tileDistances;
+    for(int i = 0; i < numNodes; i++) {
+        calculateClusterDistances(moveClass, clusterIndex, cluster.nodes[i], tileDistances);
+        for(int j = 0; j < numNodes; j++) {
+            const Coord& node = cluster.nodes[j];
+            cluster.distances[i*numNodes + j] = tileDistances[(node.y - y1) * HPA_CLUSTERSIZE + (node.x - x1)];
+        }
+    }
+
+    cluster.bDirty = false;
+}
+
+void HierarchicalPathfinder::addBorderTransitions(MOVECLASS moveClass, int clusterIndex, const Coord& first, const Coord& step, const Coord& outside, int length) {
+    // both clusters of a border find exactly the same entrances, so their transitions match up
+    int runStart = -1;
+    for(int i = 0; i <= length; i++) {
+        Coord pos = first + step*i;
+        bool bOpen = (i < length) && isPassable(moveClass, pos.x, pos.y) && isPassable(moveClass, pos.x + outside.x, pos.y + outside.y);
+
+        if(bOpen) {
+            if(runStart < 0) {
+                runStart = i;
+            }
+        } else if(runStart >= 0) {
+            int runEnd = i - 1;
+            if(runEnd - runStart + 1 > HPA_MAXENTRANCEWIDTH) {
+                addTransition(moveClass, clusterIndex, first + step*runStart, first + step*runStart + outside);
+                addTransition(moveClass, clusterIndex, first + step*runEnd, first + step*runEnd + outside);
+            } else {
+                int middle = (runStart + runEnd) / 2;
+                addTransition(moveClass, clusterIndex, first + step*middle, first + step*middle + outside);
+            }
+            runStart = -1;
+        }
+    }
+}
+
+void HierarchicalPathfinder::addTransition(MOVECLASS moveClass, int clusterIndex, const Coord& node, const Coord& exit) {
+    Layer& layer = layers[moveClass];
+    Cluster& cluster = layer.clusters[clusterIndex];
+
+    Sint16& index = layer.nodeIndex[node.x + node.y*pMap->getSizeX()];
+    if(index < 0) {
+        index = cluster.nodes.size();
+        cluster.nodes.push_back(node);
+        cluster.exits.push_back(std::vector<Coord>());
+    }
+
+    cluster.exits[index].push_back(exit);
+}
+
+void HierarchicalPathfinder::calculateClusterDistances(MOVECLASS moveClass, int clusterIndex, const Coord& source, std::vector<float>& distances) const {
+    int x1 = (clusterIndex % numClustersX) * HPA_CLUSTERSIZE;
+    int y1 = (clusterIndex / numClustersX) * HPA_CLUSTERSIZE;
+    int x2 = std::min(x1 + HPA_CLUSTERSIZE, pMap->getSizeX()) - 1;
+    int y2 = std::min(y1 + HPA_CLUSTERSIZE, pMap->getSizeY()) - 1;
+
+    distances.assign(HPA_CLUSTERSIZE*HPA_CLUSTERSIZE, INFINITE_COST);
+
+    // dijkstra restricted to the cluster
+    CostIndexQueue openList;
+    distances[(source.y - y1) * HPA_CLUSTERSIZE + (source.x - x1)] = 0.0f;
+    openList.push(CostIndexPair(0.0f, (source.y - y1) * HPA_CLUSTERSIZE + (source.x - x1)));
+
+    while(openList.empty() == false) {
+        float cost = openList.top().first;
+        int localIndex = openList.top().second;
+        openList.pop();
+
+        if(cost > distances[localIndex]) {
+            continue;
+        }
+
+        int x = x1 + localIndex % HPA_CLUSTERSIZE;
+        int y = y1 + localIndex / HPA_CLUSTERSIZE;
+
+        for(int angle = 0; angle < NUM_ANGLES; angle++) {
+            Coord next = pMap->getMapPos(angle, Coord(x,y));
+            if((next.x < x1) || (next.x > x2) || (next.y < y1) || (next.y > y2) || !isPassable(moveClass, next.x, next.y)) {
+                continue;
+            }
+
+            float nextCost = cost + getStepCost(moveClass, next.x, next.y, (next.x != x) && (next.y != y));
+            int nextIndex = (next.y - y1) * HPA_CLUSTERSIZE + (next.x - x1);
+            if(nextCost < distances[nextIndex]) {
+                distances[nextIndex] = nextCost;
+                openList.push(CostIndexPair(nextCost, nextIndex));
+            }
+        }
+    }
+}
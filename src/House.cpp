@@ -270,7 +270,7 @@ void House::printStat() const {
 
 
 void House::updateBuildLists() {
-    RobustList<StructureBase*>::const_iterator iter;
+    DenseList<StructureBase*>::const_iterator iter;
     for(iter = structureList.begin(); iter != structureList.end(); ++iter) {
 		StructureBase* tempStructure = *iter;
         if(tempStructure->isABuilder() && (tempStructure->getOwner() == this)) {
@@ -695,7 +695,7 @@ StructureBase* House::placeStructure(Uint32 builderID, int itemID, int xPos, int
 
                 if(itemID == Structure_Palace) {
                     // cancel all other palaces
-                    for(RobustList<StructureBase*>::iterator iter = structureList.begin(); iter != structureList.end(); ++iter) {
+                    for(DenseList<StructureBase*>::iterator iter = structureList.begin(); iter != structureList.end(); ++iter) {
                         if((*iter)->getOwner() == this && (*iter)->getItemID() == Structure_ConstructionYard) {
                             ConstructionYard* pConstructionYard = (ConstructionYard*) *iter;
 
@@ -789,7 +789,7 @@ Coord House::getCenterOfMainBase() const {
     Coord center;
     int numStructures = 0;
 
-    RobustList<StructureBase*>::const_iterator iter;
+    DenseList<StructureBase*>::const_iterator iter;
     for(iter = structureList.begin(); iter != structureList.end(); ++iter) {
         StructureBase* tempStructure = *iter;
 
@@ -813,7 +813,7 @@ Coord House::getStrongestUnitPosition() const {
     Coord position = Coord::Invalid();
     Sint32 highestCost = 0;
 
-    RobustList<UnitBase*>::const_iterator iter;
+    DenseList<UnitBase*>::const_iterator iter;
     for(iter = unitList.begin(); iter != unitList.end(); ++iter) {
         UnitBase* tempUnit = *iter;
 
@@ -836,7 +836,7 @@ Coord House::getStrongestUnitPosition() const {
 double House::getArmyValue() const {
     double totalCost = 0;
     Uint32 itemID;
-    RobustList<UnitBase*>::const_iterator iter;
+    DenseList<UnitBase*>::const_iterator iter;
     for(iter = unitList.begin(); iter != unitList.end(); ++iter) {
         UnitBase* tempUnit = *iter;
         itemID = tempUnit->getItemID();
@@ -860,7 +860,7 @@ double House::getArmyMobility() const {
     double totalTurn = 0;
     double unitMobVal = 0;
     Uint32 itemID;
-    RobustList<UnitBase*>::const_iterator iter;
+    DenseList<UnitBase*>::const_iterator iter;
     for(iter = unitList.begin(); iter != unitList.end(); ++iter) {
         UnitBase* tempUnit = *iter;
         itemID = tempUnit->getItemID();
@@ -881,7 +881,7 @@ ConstructionYard* House::findConstYard() {
     float	closestYardDistance = std::numeric_limits<float>::infinity();;
     ConstructionYard* bestYard = NULL;
 
-    RobustList<StructureBase*>::const_iterator iter;
+    DenseList<StructureBase*>::const_iterator iter;
     for(iter = structureList.begin(); iter != structureList.end(); ++iter) {
         StructureBase* tempStructure = *iter;
 
@@ -911,7 +911,7 @@ void House::decrementHarvesters() {
             float	closestDistance = INFINITY;
             StructureBase *closestRefinery = NULL;
 
-            RobustList<StructureBase*>::const_iterator iter;
+            DenseList<StructureBase*>::const_iterator iter;
             for(iter = structureList.begin(); iter != structureList.end(); ++iter) {
                 StructureBase* tempStructure = *iter;
 
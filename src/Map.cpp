@@ -31,14 +31,66 @@
 #include <structures/StructureBase.h>
 
 #include <limits.h>
-#include <stack>
+#include <algorithm>
+#include <functional>
 #include <set>
 
 #include <AStarSearch.h>
 #include <misc/strictmath.h>
 
+#define AFFECTEDOBJECTS_CAPACITY    128     ///< number of object IDs an AffectedObjects buffer holds without using the heap
+
+/**
+    The IDs of the objects hit by one impact. Up to AFFECTEDOBJECTS_CAPACITY IDs are kept on the stack; only bigger
+    crowds (e.g. lots of stacked air units) fall back to the heap.
+*/
+class AffectedObjects {
+public:
+    AffectedObjects() : numIDs(0) {
+    }
+
+    /**
+        Adds all IDs of list.
+        \param  list    the object IDs of one tile
+    */
+    void add(const std::list<Uint32>& list) {
+        for(std::list<Uint32>::const_iterator iter = list.begin(); iter != list.end(); ++iter) {
+            if(numIDs == AFFECTEDOBJECTS_CAPACITY && overflowIDs.empty()) {
+                overflowIDs.assign(ids, ids + numIDs);
+            }
+
+            if(overflowIDs.empty()) {
+                ids[numIDs] = *iter;
+            } else {
+                overflowIDs.push_back(*iter);
+            }
+            numIDs++;
+        }
+    }
+
+    /**
+        Sorts the IDs and removes the duplicates (structures are on more than one tile). The objects are damaged in the order of
+        their IDs, so the result does not depend on the order of the tile lists.
+    */
+    void sortAndRemoveDuplicates() {
+        Uint32* pIDs = getIDs();
+        std::sort(pIDs, pIDs + numIDs);
+        numIDs = std::unique(pIDs, pIDs + numIDs) - pIDs;
+    }
+
+    const Uint32* begin() const { return overflowIDs.empty() ? ids : &overflowIDs[0]; }
+    const Uint32* end() const { return begin() + numIDs; }
+
+private:
+    Uint32* getIDs() { return overflowIDs.empty() ? ids : &overflowIDs[0]; }
+
+    Uint32 ids[AFFECTEDOBJECTS_CAPACITY];   ///< the IDs as long as they fit
+    std::vector<Uint32> overflowIDs;        ///< all IDs if there are more than AFFECTEDOBJECTS_CAPACITY
+    int numIDs;                             ///< the number of IDs
+};
+
 Map::Map(int xSize, int ySize)
- : sizeX(xSize), sizeY(ySize), tiles(NULL), lastSinglySelectedObject(NULL) {
+ : sizeX(xSize), sizeY(ySize), tiles(NULL), lastSinglySelectedObject(NULL), pHierarchicalPathfinder(NULL), flowFieldCache(this), reachabilityIndex(this), spatialIndex(this), numUpdatedTiles(0), terrainCache(this) {
 
 	tiles = new Tile[sizeX*sizeY];
 
@@ -48,10 +100,21 @@ Map::Map(int xSize, int ySize)
 			tiles[i+j*sizeX].location.y = j;
 		}
 	}
+
+	// all tiles count as seen in cycle 0; as they share the same timeout the vectors are valid heaps
+	if(currentGame->getGameInitSettings().getGameOptions().fogOfWar == true) {
+		for(int houseID = 0; houseID < NUM_HOUSES; houseID++) {
+			fogTimeouts[houseID].reserve(sizeX*sizeY);
+			for(int i = 0; i < sizeX*sizeY; i++) {
+				fogTimeouts[houseID].push_back(FogTimeout(FOGTIMEOUT, i));
+			}
+		}
+	}
 }
 
 
 Map::~Map() {
+	delete pHierarchicalPathfinder;
 	delete[] tiles;
 }
 
@@ -59,11 +122,51 @@ void Map::load(InputStream& stream) {
 	sizeX = stream.readSint32();
 	sizeY = stream.readSint32();
 
+	delete pHierarchicalPathfinder;
+	pHierarchicalPathfinder = NULL;
+	flowFieldCache.clear();
+	reachabilityIndex.clear();
+
+	objectTileIndex.clear();
+	spatialIndex.clear();
+	activeTiles.clear();
+	radarDirtyTiles.clear();
+	terrainCache.clear();
+
+	bool bFogOfWar = currentGame->getGameInitSettings().getGameOptions().fogOfWar;
+	Uint32 currentCycle = currentGame->getGameCycleCount();
+	for(int houseID = 0; houseID < NUM_HOUSES; houseID++) {
+		fogTimeouts[houseID].clear();
+	}
+
 	for (int i = 0; i < sizeX; i++) {
 		for (int j = 0; j < sizeY; j++) {
-			getTile(i,j)->load(stream);
-			getTile(i,j)->location.x = i;
-			getTile(i,j)->location.y = j;
+			Tile* pTile = getTile(i,j);
+			pTile->load(stream);
+			pTile->location.x = i;
+			pTile->location.y = j;
+
+			// the object lists of the tile are loaded directly, so rebuild the index for them
+			const std::list<Uint32>* lists[] = {	&pTile->getAirUnitList(), &pTile->getInfantryList(),
+													&pTile->getUndergroundUnitList(), &pTile->getNonInfantryGroundObjectList() };
+			for(int k = 0; k < 4; k++) {
+				for(std::list<Uint32>::const_iterator iter = lists[k]->begin(); iter != lists[k]->end(); ++iter) {
+					addToObjectTileIndex(*iter, pTile->location);
+				}
+			}
+
+			pTile->bActive = false;
+			if(pTile->needsUpdate()) {
+				activateTile(pTile);
+			}
+
+			if(bFogOfWar) {
+				for(int houseID = 0; houseID < NUM_HOUSES; houseID++) {
+					if(pTile->updateFogTimeout(houseID, currentCycle) == false) {
+						addFogTimeout(pTile, houseID);
+					}
+				}
+			}
 		}
 	}
 }
@@ -80,36 +183,13 @@ void Map::save(OutputStream& stream) const {
 }
 
 void Map::createSandRegions() {
-	std::stack<Tile*> tileQueue;
-	std::vector<bool> visited(sizeX * sizeY);
-
-	for(int i = 0; i < sizeX; i++) {
-		for(int j = 0; j < sizeY; j++)	{
-			getTile(i,j)->setSandRegion(NONE);
-		}
-	}
+	// the sand regions are the connected areas of the sand layer of the reachability index
+	reachabilityIndex.clear();
 
-    int	region = 0;
 	for(int i = 0; i < sizeX; i++) {
 		for(int j = 0; j < sizeY; j++) {
-			if(!getTile(i,j)->isRock() && !visited[j*sizeX+i]) {
-				tileQueue.push(getTile(i,j));
-
-				while(!tileQueue.empty()) {
-					Tile* pTile = tileQueue.top();
-					tileQueue.pop();
-
-					pTile->setSandRegion(region);
-					for(int angle = 0; angle < NUM_ANGLES; angle++) {
-						Coord pos = getMapPos(angle, pTile->location);
-						if(tileExists(pos) && !getTile(pos)->isRock() && !visited[pos.y*sizeX + pos.x]) {
-							tileQueue.push(getTile(pos));
-							visited[pos.y*sizeX + pos.x] = true;
-						}
-					}
-				}
-				region++;
-			}
+			Sint32 region = reachabilityIndex.getComponentID(ReachabilityIndex::MoveClass_Sand, Coord(i,j));
+			getTile(i,j)->setSandRegion((region == INVALID) ? NONE : region);
 		}
 	}
 }
@@ -117,26 +197,36 @@ void Map::createSandRegions() {
 void Map::damage(Uint32 damagerID, House* damagerOwner, const Coord& realPos, Uint32 bulletID, float damage, int damageRadius, bool air) {
 	Coord location = Coord(realPos.x/TILESIZE, realPos.y/TILESIZE);
 
-    std::set<Uint32>	affectedAirUnits;
-    std::set<Uint32>    affectedGroundAndUndergroundUnits;
+    AffectedObjects affectedAirUnits;
+    AffectedObjects affectedGroundAndUndergroundUnits;
 
 	for(int i = location.x-2; i <= location.x+2; i++) {
 		for(int j = location.y-2; j <= location.y+2; j++) {
 			if(tileExists(i, j)) {
 			    Tile* pTile = getTile(i,j);
 
-                affectedAirUnits.insert(pTile->getAirUnitList().begin(), pTile->getAirUnitList().end());
-                affectedGroundAndUndergroundUnits.insert(pTile->getInfantryList().begin(), pTile->getInfantryList().end());
-                affectedGroundAndUndergroundUnits.insert(pTile->getUndergroundUnitList().begin(), pTile->getUndergroundUnitList().end());
-                affectedGroundAndUndergroundUnits.insert(pTile->getNonInfantryGroundObjectList().begin(), pTile->getNonInfantryGroundObjectList().end());
+                // only the lists that are looked at below are collected
+                if((air == true) && (bulletID != Bullet_Sandworm)) {
+                    affectedAirUnits.add(pTile->getAirUnitList());
+                } else {
+                    affectedGroundAndUndergroundUnits.add(pTile->getInfantryList());
+                    affectedGroundAndUndergroundUnits.add(pTile->getUndergroundUnitList());
+                    affectedGroundAndUndergroundUnits.add(pTile->getNonInfantryGroundObjectList());
+                }
 			}
 		}
 	}
 
+    affectedAirUnits.sortAndRemoveDuplicates();
+    affectedGroundAndUndergroundUnits.sortAndRemoveDuplicates();
+
     if(bulletID == Bullet_Sandworm) {
-        std::set<Uint32>::const_iterator iter;
-        for(iter = affectedGroundAndUndergroundUnits.begin(); iter != affectedGroundAndUndergroundUnits.end() ;++iter) {
+        for(const Uint32* iter = affectedGroundAndUndergroundUnits.begin(); iter != affectedGroundAndUndergroundUnits.end(); ++iter) {
             ObjectBase* pObject = currentGame->getObjectManager().getObject(*iter);
+            if(pObject == NULL) {
+                continue;
+            }
+
             if((pObject->getItemID() != Unit_Sandworm) && (pObject->isAGroundUnit() || pObject->isInfantry()) && (pObject->getLocation() == location)) {
                 pObject->setVisible(VIS_ALL, false);
                 pObject->handleDamage( lroundf(damage), damagerID, damagerOwner);
@@ -147,13 +237,14 @@ void Map::damage(Uint32 damagerID, House* damagerOwner, const Coord& realPos, Ui
         if(air == true) {
             // air damage
             if((bulletID == Bullet_DRocket) || bulletID == Bullet_GasCloud || (bulletID == Bullet_Rocket) || (bulletID == Bullet_TurretRocket)|| (bulletID == Bullet_SmallRocket) || (bulletID == Bullet_LargeRocket)) {
-                std::set<Uint32>::const_iterator iter;
-                for(iter = affectedAirUnits.begin(); iter != affectedAirUnits.end() ;++iter) {
-                    AirUnit* pAirUnit = dynamic_cast<AirUnit*>(currentGame->getObjectManager().getObject(*iter));
+                for(const Uint32* iter = affectedAirUnits.begin(); iter != affectedAirUnits.end(); ++iter) {
+                    ObjectBase* pObject = currentGame->getObjectManager().getObject(*iter);
 
-                    if(pAirUnit == NULL)
+                    if((pObject == NULL) || !pObject->isAFlyingUnit())
                         continue;
 
+                    AirUnit* pAirUnit = static_cast<AirUnit*>(pObject);
+
 
                     Coord centerPoint = pAirUnit->getCenterPoint();
                     int distance = lroundf(distanceFrom(centerPoint, realPos));
@@ -176,12 +267,15 @@ void Map::damage(Uint32 damagerID, House* damagerOwner, const Coord& realPos, Ui
             }
         } else {
             // non air damage
-            std::set<Uint32>::const_iterator iter;
-            for(iter = affectedGroundAndUndergroundUnits.begin(); iter != affectedGroundAndUndergroundUnits.end() ;++iter) {
+            for(const Uint32* iter = affectedGroundAndUndergroundUnits.begin(); iter != affectedGroundAndUndergroundUnits.end(); ++iter) {
                 ObjectBase* pObject = currentGame->getObjectManager().getObject(*iter);
 
+                if(pObject == NULL) {
+                    continue;
+                }
+
                 if(pObject->isAStructure()) {
-                    StructureBase* pStructure = dynamic_cast<StructureBase*>(pObject);
+                    StructureBase* pStructure = static_cast<StructureBase*>(pObject);
 
                     Coord topLeftCorner = pStructure->getLocation()*TILESIZE;
                     Coord bottomRightCorner = topLeftCorner + pStructure->getStructureSize()*TILESIZE;
@@ -199,7 +293,7 @@ void Map::damage(Uint32 damagerID, House* damagerOwner, const Coord& realPos, Ui
 
 
                 } else if(pObject->isAUnit()) {
-                    UnitBase* pUnit = dynamic_cast<UnitBase*>(pObject);
+                    UnitBase* pUnit = static_cast<UnitBase*>(pObject);
 
                     Coord centerPoint = pUnit->getCenterPoint();
                     int distance = lroundf(distanceFrom(centerPoint, realPos));
@@ -521,11 +615,220 @@ Coord Map::findClosestEdgePoint(const Coord& origin, const Coord& buildingSize)
 
 
 void Map::removeObjectFromMap(Uint32 objectID) {
+	std::unordered_map<Uint32, std::vector<Coord> >::iterator iter = objectTileIndex.find(objectID);
+	if(iter == objectTileIndex.end()) {
+		return;
+	}
+
+	// unassigning modifies the index, so work on a copy
+	std::vector<Coord> assignedTiles;
+	assignedTiles.swap(iter->second);
+	objectTileIndex.erase(iter);
+
+	for(std::vector<Coord>::const_iterator tileIter = assignedTiles.begin(); tileIter != assignedTiles.end(); ++tileIter) {
+		spatialIndex.objectUnassigned(objectID, *tileIter);
+		markRadarDirty(*tileIter);
+		getTile(*tileIter)->unassignObject(objectID);
+	}
+}
+
+void Map::addToObjectTileIndex(Uint32 objectID, const Coord& pos) {
+	objectTileIndex[objectID].push_back(pos);
+	spatialIndex.objectAssigned(objectID, pos);
+	markRadarDirty(pos);
+}
+
+void Map::removeFromObjectTileIndex(Uint32 objectID, const Coord& pos) {
+	std::unordered_map<Uint32, std::vector<Coord> >::iterator iter = objectTileIndex.find(objectID);
+	if(iter == objectTileIndex.end()) {
+		return;
+	}
+
+	std::vector<Coord>& assignedTiles = iter->second;
+	std::vector<Coord>::iterator tileIter = std::find(assignedTiles.begin(), assignedTiles.end(), pos);
+	if(tileIter != assignedTiles.end()) {
+		*tileIter = assignedTiles.back();
+		assignedTiles.pop_back();
+		spatialIndex.objectUnassigned(objectID, pos);
+		markRadarDirty(pos);
+	}
+
+	if(assignedTiles.empty()) {
+		objectTileIndex.erase(iter);
+	}
+}
+
+void Map::activateTile(Tile* pTile) {
+	pTile->bActive = true;
+	activeTiles.push_back(pTile);
+}
+
+void Map::updateActiveTiles() {
+	numUpdatedTiles = activeTiles.size();
+
+	// the tiles are independent of each other, so the order of the updates does not matter
+	size_t numRemaining = 0;
+	for(size_t i = 0; i < activeTiles.size(); i++) {
+		Tile* pTile = activeTiles[i];
+		pTile->update();
+
+		if(pTile->needsUpdate()) {
+			activeTiles[numRemaining++] = pTile;
+		} else {
+			pTile->bActive = false;
+		}
+	}
+	activeTiles.resize(numRemaining);
+}
+
+void Map::markRadarDirty(const Coord& pos) {
+	Tile* pTile = getTile(pos);
+	if(pTile->bRadarDirty == false) {
+		pTile->bRadarDirty = true;
+		radarDirtyTiles.push_back(pTile);
+	}
+}
+
+void Map::markObjectRadarDirty(Uint32 objectID) {
+	std::unordered_map<Uint32, std::vector<Coord> >::const_iterator iter = objectTileIndex.find(objectID);
+	if(iter == objectTileIndex.end()) {
+		return;
+	}
+
+	for(std::vector<Coord>::const_iterator tileIter = iter->second.begin(); tileIter != iter->second.end(); ++tileIter) {
+		markRadarDirty(*tileIter);
+	}
+}
+
+void Map::clearRadarDirtyTiles() {
+	for(std::vector<Tile*>::const_iterator iter = radarDirtyTiles.begin(); iter != radarDirtyTiles.end(); ++iter) {
+		(*iter)->bRadarDirty = false;
+	}
+	radarDirtyTiles.clear();
+}
+
+void Map::markTerrainDirty(const Coord& pos, int radius) {
+	for(int y = pos.y - radius; y <= pos.y + radius; y++) {
+		for(int x = pos.x - radius; x <= pos.x + radius; x++) {
+			terrainCache.tileChanged(Coord(x,y));
+		}
+	}
+}
+
+void Map::invalidateTerrainTiles(const Coord& pos) {
+	getTile(pos)->invalidateTerrainTile();
+	terrainCache.tileChanged(pos);
+	for(int angle = 0; angle < NUM_ANGLES; angle += 2) {
+		Coord neighbour = getMapPos(angle, pos);
+		if(tileExists(neighbour)) {
+			getTile(neighbour)->invalidateTerrainTile();
+			terrainCache.tileChanged(neighbour);
+		}
+	}
+}
+
+void Map::invalidateHideTiles(const Coord& pos, int houseID) {
+	for(int angle = 0; angle < NUM_ANGLES; angle += 2) {
+		Coord neighbour = getMapPos(angle, pos);
+		if(tileExists(neighbour)) {
+			getTile(neighbour)->invalidateHideTile(houseID);
+		}
+	}
+}
+
+void Map::invalidateFogTiles(const Coord& pos, int houseID) {
+	for(int angle = 0; angle < NUM_ANGLES; angle += 2) {
+		Coord neighbour = getMapPos(angle, pos);
+		if(tileExists(neighbour)) {
+			getTile(neighbour)->invalidateFogTile(houseID);
+		}
+	}
+}
+
+void Map::addFogTimeout(Tile* pTile, int houseID) {
+	std::vector<FogTimeout>& heap = fogTimeouts[houseID];
+	heap.push_back(FogTimeout(pTile->getLastAccess(houseID) + FOGTIMEOUT, pTile - tiles));
+	std::push_heap(heap.begin(), heap.end(), std::greater<FogTimeout>());
+}
+
+void Map::updateFogTimeouts() {
+	Uint32 currentCycle = currentGame->getGameCycleCount();
+
+	for(int houseID = 0; houseID < NUM_HOUSES; houseID++) {
+		std::vector<FogTimeout>& heap = fogTimeouts[houseID];
+
+		while(!heap.empty() && (heap.front().cycle <= currentCycle)) {
+			Tile* pTile = &tiles[heap.front().tileIndex];
+			std::pop_heap(heap.begin(), heap.end(), std::greater<FogTimeout>());
+			heap.pop_back();
+
+			// the tile might have been seen again since the timeout was registered
+			if(pTile->updateFogTimeout(houseID, currentCycle) == false) {
+				addFogTimeout(pTile, houseID);
+			}
+		}
+	}
+}
+
+static bool coordLess(const Coord& c1, const Coord& c2) {
+	return (c1.y < c2.y) || ((c1.y == c2.y) && (c1.x < c2.x));
+}
+
+bool Map::checkObjectTileIndex() const {
+	// count every assignment of the tile lists
+	std::unordered_map<Uint32, std::vector<Coord> > tileLists;
 	for(int y = 0; y < sizeY ; y++) {
 		for(int x = 0 ; x < sizeX ; x++) {
-			getTile(x,y)->unassignObject(objectID);
+			const Tile* pTile = getTile(x,y);
+			const std::list<Uint32>* lists[] = {	&pTile->getAirUnitList(), &pTile->getInfantryList(),
+													&pTile->getUndergroundUnitList(), &pTile->getNonInfantryGroundObjectList() };
+
+			for(int i = 0; i < 4; i++) {
+				for(std::list<Uint32>::const_iterator iter = lists[i]->begin(); iter != lists[i]->end(); ++iter) {
+					tileLists[*iter].push_back(Coord(x,y));
+				}
+			}
 		}
 	}
+
+	bool bConsistent = true;
+
+	std::unordered_map<Uint32, std::vector<Coord> >::const_iterator iter;
+	for(iter = tileLists.begin(); iter != tileLists.end(); ++iter) {
+		std::unordered_map<Uint32, std::vector<Coord> >::const_iterator indexIter = objectTileIndex.find(iter->first);
+
+		std::vector<Coord> indexTiles;
+		if(indexIter != objectTileIndex.end()) {
+			indexTiles = indexIter->second;
+		}
+		std::vector<Coord> listTiles = iter->second;
+
+		std::sort(indexTiles.begin(), indexTiles.end(), coordLess);
+		std::sort(listTiles.begin(), listTiles.end(), coordLess);
+
+		if(indexTiles != listTiles) {
+			fprintf(stderr, "Map::checkObjectTileIndex(): Object %d is assigned to %d tiles but the index contains %d tiles!\n", iter->first, (int) listTiles.size(), (int) indexTiles.size());
+			bConsistent = false;
+		}
+	}
+
+	for(iter = objectTileIndex.begin(); iter != objectTileIndex.end(); ++iter) {
+		if(tileLists.find(iter->first) == tileLists.end()) {
+			fprintf(stderr, "Map::checkObjectTileIndex(): Object %d is in the index but not assigned to any tile!\n", iter->first);
+			bConsistent = false;
+		}
+	}
+
+	return bConsistent;
+}
+
+void Map::tilePassabilityChanged(const Coord& pos) {
+	if(pHierarchicalPathfinder != NULL) {
+		pHierarchicalPathfinder->tileChanged(pos);
+	}
+
+	flowFieldCache.clear();
+	reachabilityIndex.tileChanged(pos);
 }
 
 
@@ -377,6 +377,8 @@ void OptionsMenu::saveConfiguration2File() {
     myINIFile.setBoolValue("Game Options","Killed Sandworms Drop Spice",settings.gameOptions.killedSandwormsDropSpice);
     myINIFile.setBoolValue("Game Options","Day Night Cycle",settings.gameOptions.daynight);
     myINIFile.setIntValue("Game Options","Day Night Scale",settings.gameOptions.dayscale);
+    myINIFile.setBoolValue("Game Options","Hierarchical Pathfinding",settings.gameOptions.hierarchicalPathfinding);
+    myINIFile.setBoolValue("Game Options","Flow Field Pathfinding",settings.gameOptions.flowFieldPathfinding);
 
     myINIFile.setIntValue("Network","ServerPort",settings.network.serverPort);
     myINIFile.setStringValue("Network","MetaServer",settings.network.metaServer);
@@ -28,9 +28,11 @@
 #include <string.h>
 
 #include <algorithm>
+#include <limits.h>
 
 NetworkManager::NetworkManager(int port, std::string metaserver)
- : host(NULL), bIsServer(false), bLANServer(false), pGameInitSettings(NULL), numPlayers(0), maxPlayers(0), connectPeer(NULL), pLANGameFinderAndAnnouncer(NULL), pMetaServerClient(NULL)
+ : host(NULL), bIsServer(false), bLANServer(false), pGameInitSettings(NULL), numPlayers(0), maxPlayers(0), connectPeer(NULL), pLANGameFinderAndAnnouncer(NULL), pMetaServerClient(NULL),
+   lastBandwidthMeasurement(0), bytesSentPerSecond(0), bytesReceivedPerSecond(0)
 {
 	if(enet_initialize() != 0) {
         throw std::runtime_error("NetworkManager: An error occurred while initializing ENet.");
@@ -169,6 +171,17 @@ void NetworkManager::update()
 		pMetaServerClient->update();
 	}
 
+	// ENet counts all bytes sent and received by the host; we reset the counters every second
+	Uint32 now = SDL_GetTicks();
+	if(now - lastBandwidthMeasurement >= 1000) {
+		Uint32 elapsed = now - lastBandwidthMeasurement;
+		bytesSentPerSecond = (Uint32) (((Uint64) host->totalSentData * 1000) / elapsed);
+		bytesReceivedPerSecond = (Uint32) (((Uint64) host->totalReceivedData * 1000) / elapsed);
+		host->totalSentData = 0;
+		host->totalReceivedData = 0;
+		lastBandwidthMeasurement = now;
+	}
+
 	if(bIsServer) {
 		// Check for timeout of one client
 		if(awaitingConnectionList.empty() == false) {
@@ -602,9 +615,17 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
 			case NETWORKPACKET_COMMANDLIST: {
 			    PeerData* peerData = (PeerData*) peer->data;
 
+			    Uint32 acknowledgedCycle = packetStream.readUint32();
 			    CommandList commandList(packetStream);
 
+			    peerData->acknowledgedCycle = std::max(peerData->acknowledgedCycle, acknowledgedCycle);
+
 				if(pOnReceiveCommandList) {
+				    // only acknowledge commands that were really passed on (not the ones arriving before the game is running)
+                    if(commandList.firstCycle <= peerData->receivedCycle) {
+                        peerData->receivedCycle = std::max(peerData->receivedCycle, commandList.endCycle);
+                    }
+
                     pOnReceiveCommandList(peerData->name, commandList);
 				}
 			} break;
@@ -712,11 +733,39 @@ void NetworkManager::sendStartGame(unsigned int timeLeft) {
 }
 
 void NetworkManager::sendCommandList(const CommandList& commandList) {
-	ENetPacketOStream packetStream(ENET_PACKET_FLAG_UNSEQUENCED);
-	packetStream.writeUint32(NETWORKPACKET_COMMANDLIST);
-	commandList.save(packetStream);
+	std::list<ENetPeer*>::iterator iter;
+	for(iter = peerList.begin(); iter != peerList.end(); ++iter) {
+        PeerData* peerData = (PeerData*) (*iter)->data;
+
+        // acknowledge what we got from this peer and only send what it has not acknowledged yet
+        ENetPacketOStream packetStream(ENET_PACKET_FLAG_UNSEQUENCED);
+        packetStream.writeUint32(NETWORKPACKET_COMMANDLIST);
+        packetStream.writeUint32(peerData->receivedCycle);
+        commandList.save(packetStream, peerData->acknowledgedCycle);
+
+        sendPacketToPeer(*iter, packetStream, 1);
+	}
+}
+
+Uint32 NetworkManager::getMinAcknowledgedCycle() const {
+    Uint32 minAcknowledgedCycle = UINT_MAX;
+
+	std::list<ENetPeer*>::const_iterator iter;
+	for(iter = peerList.begin(); iter != peerList.end(); ++iter) {
+        PeerData* peerData = (PeerData*) (*iter)->data;
+        minAcknowledgedCycle = std::min(minAcknowledgedCycle, peerData->acknowledgedCycle);
+	}
 
-    sendPacketToAllConnectedPeers(packetStream, 1);
+	return (minAcknowledgedCycle == UINT_MAX) ? 0 : minAcknowledgedCycle;
+}
+
+void NetworkManager::setFirstCommandCycle(Uint32 cycle) {
+	std::list<ENetPeer*>::iterator iter;
+	for(iter = peerList.begin(); iter != peerList.end(); ++iter) {
+        PeerData* peerData = (PeerData*) (*iter)->data;
+        peerData->acknowledgedCycle = std::max(peerData->acknowledgedCycle, cycle);
+        peerData->receivedCycle = std::max(peerData->receivedCycle, cycle);
+	}
 }
 
 void NetworkManager::sendSelectedList(const std::list<Uint32>& selectedList, int groupListIndex) {
@@ -69,6 +69,8 @@
 #include <units/Trike.h>
 #include <units/Trooper.h>
 
+#include <algorithm>
+
 ObjectBase::ObjectBase(House* newOwner) : originalHouseID(newOwner->getHouseID()), owner(newOwner) {
     ObjectBase::init();
 
@@ -98,6 +100,7 @@ ObjectBase::ObjectBase(House* newOwner) : originalHouseID(newOwner->getHouseID()
     setOldFellow(NULL);
 	targetFriendly = false;
 	attackMode = GUARD;
+	lastDamageCycle = NONE;
 
 	setVisible(VIS_ALL, false);
 }
@@ -139,6 +142,7 @@ ObjectBase::ObjectBase(InputStream& stream) {
 	fellow.load(stream);
 	targetFriendly = stream.readBool();
 	attackMode = (ATTACKMODE) stream.readUint32();
+	lastDamageCycle = stream.readUint32();
 
     stream.readBools(&visible[0], &visible[1], &visible[2], &visible[3], &visible[4], &visible[5]);
 }
@@ -200,6 +204,7 @@ void ObjectBase::save(OutputStream& stream) const {
     fellow.save(stream);
 	stream.writeBool(targetFriendly);
     stream.writeUint32(attackMode);
+	stream.writeUint32(lastDamageCycle);
 
     stream.writeBools(visible[0], visible[1], visible[2], visible[3], visible[4], visible[5]);
 }
@@ -224,6 +229,10 @@ int ObjectBase::getMaxHealth() const {
 
 void ObjectBase::handleDamage(int damage, Uint32 damagerID, House* damagerOwner) {
     if(damage >= 0) {
+        if(damage > 0) {
+            lastDamageCycle = currentGame->getGameCycleCount();
+        }
+
         float newHealth = getHealth();
 
         newHealth -= damage;
@@ -357,6 +366,12 @@ void ObjectBase::setOldTarget(const ObjectBase* oldTarget) {
 }
 
 
+void ObjectBase::setOwner(House* no) {
+	owner = no;
+	currentGameMap->getSpatialIndex().objectOwnerChanged(getObjectID());
+	currentGameMap->markObjectRadarDirty(getObjectID());
+}
+
 void ObjectBase::setTarget(const ObjectBase* newTarget) {
 	target.pointTo(const_cast<ObjectBase*>(newTarget));
 	targetFriendly = (target && (target.getObjPointer()->getOwner()->getTeam() == owner->getTeam()) && (getItemID() != Unit_Sandworm) && (target.getObjPointer()->getItemID() != Unit_Sandworm));
@@ -427,35 +442,76 @@ Coord ObjectBase::getClosestPoint(const Coord& point) const {
 	return location;
 }
 
+/**
+    Returns the maximum weapon range of all units and structures. An object that attacks us cannot be further away.
+*/
+static int getMaxWeaponRange() {
+	int maxWeaponRange = 0;
+	for(int itemID = 0; itemID < Num_ItemID; itemID++) {
+		for(int houseID = 0; houseID < NUM_HOUSES; houseID++) {
+			maxWeaponRange = std::max(maxWeaponRange, (int) currentGame->objectData.data[itemID][houseID].weaponrange);
+		}
+	}
+	return maxWeaponRange;
+}
+
+/**
+    Orders objects by their object id. The candidates of a ring are sorted with it before they are scanned, because the
+    order of the objects in the cells of the spatial index depends on the history of the index (e.g. whether the game
+    was loaded) and ties and the first found attacker must not.
+*/
+static bool objectIDLess(const ObjectBase* pObject1, const ObjectBase* pObject2) {
+	return pObject1->getObjectID() < pObject2->getObjectID();
+}
+
+/// ornithopters prefer some unit types; the distance to these units is lowered by this value
+#define PRIORITYTARGET_BONUS	400.0f
+
 const StructureBase* ObjectBase::findClosestTargetStructure() const {
 
 	StructureBase	*closestStructure = NULL;
 	float			closestDistance = INFINITY;
+	int				maxAttackerDistance = getMaxWeaponRange();
 
-    RobustList<StructureBase*>::const_iterator iter;
-    for(iter = structureList.begin(); iter != structureList.end(); ++iter) {
-        StructureBase* tempStructure = *iter;
+	std::vector<ObjectBase*> candidates;
 
-        if(canAttack(tempStructure)) {
-			Coord closestPoint = tempStructure->getClosestPoint(getLocation());
-			float structureDistance = blockDistance(getLocation(), closestPoint);
-			bool attacker_mask = tempStructure->isActive() && tempStructure->hasATarget() && tempStructure->getTarget() != NULL
-					&& tempStructure->getTarget() ==  this && tempStructure->canAttack(this) && tempStructure->targetInWeaponRange() ;
-			bool attacker_mask2 = tempStructure->isActive() && tempStructure->hasAOldTarget() && tempStructure->getOldTarget() != NULL
-					&& tempStructure->getOldTarget() ==  this && tempStructure->canAttack(this) && tempStructure->oldtargetInWeaponRange() ;
+	// search the cells around us ring by ring until neither a closer structure nor an attacker can be found anymore
+	for(int ring = 0; (SpatialIndex::getRingMinDistance(ring) < closestDistance) || (SpatialIndex::getRingMinDistance(ring) <= maxAttackerDistance); ring++) {
+		candidates.clear();
+		if(currentGameMap->getSpatialIndex().getObjectsInRing(location, ring, SPATIALINDEX_ALLHOUSES, candidates) == false) {
+			break;
+		}
+		std::sort(candidates.begin(), candidates.end(), objectIDLess);
 
-			if (attacker_mask || attacker_mask2)
-				return tempStructure;
+		std::vector<ObjectBase*>::const_iterator iter;
+		for(iter = candidates.begin(); iter != candidates.end(); ++iter) {
+			if(!(*iter)->isAStructure()) {
+				continue;
+			}
 
-			if(tempStructure->getItemID() == Structure_Wall) {
-					structureDistance += 20000000.0f; //so that walls are targeted very last
-            }
+			StructureBase* tempStructure = static_cast<StructureBase*>(*iter);
 
-            if(structureDistance < closestDistance)	{
-                closestDistance = structureDistance;
-                closestStructure = tempStructure;
-            }
-        }
+			if(canAttack(tempStructure)) {
+				Coord closestPoint = tempStructure->getClosestPoint(getLocation());
+				float structureDistance = blockDistance(getLocation(), closestPoint);
+				bool attacker_mask = tempStructure->isActive() && tempStructure->hasATarget() && tempStructure->getTarget() != NULL
+						&& tempStructure->getTarget() ==  this && tempStructure->canAttack(this) && tempStructure->targetInWeaponRange() ;
+				bool attacker_mask2 = tempStructure->isActive() && tempStructure->hasAOldTarget() && tempStructure->getOldTarget() != NULL
+						&& tempStructure->getOldTarget() ==  this && tempStructure->canAttack(this) && tempStructure->oldtargetInWeaponRange() ;
+
+				if (attacker_mask || attacker_mask2)
+					return tempStructure;
+
+				if(tempStructure->getItemID() == Structure_Wall) {
+						structureDistance += 20000000.0f; //so that walls are targeted very last
+				}
+
+				if(structureDistance < closestDistance)	{
+					closestDistance = structureDistance;
+					closestStructure = tempStructure;
+				}
+			}
+		}
 	}
 
 	return closestStructure;
@@ -464,39 +520,56 @@ const StructureBase* ObjectBase::findClosestTargetStructure() const {
 const UnitBase* ObjectBase::findClosestTargetUnit() const {
 	UnitBase	*closestUnit = NULL;
 	float		closestDistance = INFINITY;
+	int			maxAttackerDistance = getMaxWeaponRange();
+	float		maxPriorityBonus = (itemID == Unit_Ornithopter) ? PRIORITYTARGET_BONUS : 0.0f;
+
+	std::vector<ObjectBase*> candidates;
+
+	// search the cells around us ring by ring until neither a closer unit (a priority target counts closer) nor an attacker can be found anymore
+	for(int ring = 0; (SpatialIndex::getRingMinDistance(ring) - maxPriorityBonus < closestDistance) || (SpatialIndex::getRingMinDistance(ring) <= maxAttackerDistance); ring++) {
+		candidates.clear();
+		if(currentGameMap->getSpatialIndex().getObjectsInRing(location, ring, SPATIALINDEX_ALLHOUSES, candidates) == false) {
+			break;
+		}
+		std::sort(candidates.begin(), candidates.end(), objectIDLess);
 
-    RobustList<UnitBase*>::const_iterator iter;
-    for(iter = unitList.begin(); iter != unitList.end(); ++iter) {
-        UnitBase* tempUnit = *iter;
-
-		if(canAttack(tempUnit)) {
-			Coord closestPoint = tempUnit->getClosestPoint(getLocation());
-			float unitDistance = blockDistance(getLocation(), closestPoint);
-			Uint32 titemID = tempUnit->getItemID();
-			bool priority_mask = (itemID == Unit_Ornithopter && tempUnit->isActive()) && (titemID == Unit_MCV || titemID == Unit_Ornithopter || titemID == Unit_Harvester || titemID == Unit_Launcher || titemID == Unit_Troopers) ;
-			bool attacker_mask = tempUnit->isActive() && !tempUnit->isDestoyed() && tempUnit->hasATarget() && tempUnit->getTarget() != NULL &&
-					tempUnit->getTarget() ==  this && tempUnit->canAttack(this) && tempUnit->targetInWeaponRange() ;
-			bool attacker_mask2 = tempUnit->isActive() && !tempUnit->isDestoyed() && tempUnit->hasAOldTarget() && tempUnit->getOldTarget() != NULL &&
-								tempUnit->getOldTarget() ==  this && tempUnit->canAttack(this) && tempUnit->oldtargetInWeaponRange() ;
-
-			if (attacker_mask || attacker_mask2)
-				return tempUnit;
-														// FIXME : carryall should be regular target hard to shoot but regular,
-														//instead unit should abandon this target if in danger
-			if(tempUnit->getItemID() == Unit_Sandworm || tempUnit->getItemID() == Unit_Carryall) {
-				unitDistance += 4000.0f; //so that worms are targeted last
+		std::vector<ObjectBase*>::const_iterator iter;
+		for(iter = candidates.begin(); iter != candidates.end(); ++iter) {
+			if(!(*iter)->isAUnit()) {
+				continue;
 			}
 
-			if(unitDistance < closestDistance) {
+			UnitBase* tempUnit = static_cast<UnitBase*>(*iter);
+
+			if(canAttack(tempUnit)) {
+				Coord closestPoint = tempUnit->getClosestPoint(getLocation());
+				float unitDistance = blockDistance(getLocation(), closestPoint);
+				Uint32 titemID = tempUnit->getItemID();
+				bool priority_mask = (itemID == Unit_Ornithopter && tempUnit->isActive()) && (titemID == Unit_MCV || titemID == Unit_Ornithopter || titemID == Unit_Harvester || titemID == Unit_Launcher || titemID == Unit_Troopers) ;
+				bool attacker_mask = tempUnit->isActive() && !tempUnit->isDestoyed() && tempUnit->hasATarget() && tempUnit->getTarget() != NULL &&
+						tempUnit->getTarget() ==  this && tempUnit->canAttack(this) && tempUnit->targetInWeaponRange() ;
+				bool attacker_mask2 = tempUnit->isActive() && !tempUnit->isDestoyed() && tempUnit->hasAOldTarget() && tempUnit->getOldTarget() != NULL &&
+									tempUnit->getOldTarget() ==  this && tempUnit->canAttack(this) && tempUnit->oldtargetInWeaponRange() ;
+
+				if (attacker_mask || attacker_mask2)
+					return tempUnit;
+															// FIXME : carryall should be regular target hard to shoot but regular,
+															//instead unit should abandon this target if in danger
+				if(tempUnit->getItemID() == Unit_Sandworm || tempUnit->getItemID() == Unit_Carryall) {
+					unitDistance += 4000.0f; //so that worms are targeted last
+				}
+
 				if (priority_mask) {
-					unitDistance -= 400.0f;
+					unitDistance -= PRIORITYTARGET_BONUS;
 					if (unitDistance == 0) unitDistance = 0.1;
 				}
-                closestDistance = unitDistance;
-				closestUnit = tempUnit;
 
-            }
-        }
+				if(unitDistance < closestDistance) {
+					closestDistance = unitDistance;
+					closestUnit = tempUnit;
+				}
+			}
+		}
 	}
 
 	return closestUnit;
@@ -511,59 +584,88 @@ const ObjectBase* ObjectBase::findClosestTarget() const {
 
 	ObjectBase	*closestObject = NULL;
 	float			closestDistance = INFINITY;
+	int				maxAttackerDistance = getMaxWeaponRange();
 
-    RobustList<StructureBase*>::const_iterator iter1;
-    for(iter1 = structureList.begin(); iter1 != structureList.end(); ++iter1) {
-        StructureBase* tempStructure = *iter1;
-
-        if(canAttack(tempStructure)) {
-			Coord closestPoint = tempStructure->getClosestPoint(getLocation());
-			float structureDistance = blockDistance(getLocation(), closestPoint);
-			bool attacker_mask = tempStructure->isActive() && tempStructure->hasATarget() && tempStructure->getTarget() != NULL &&
-					tempStructure->getTarget() ==  this && tempStructure->canAttack(this) && tempStructure->targetInWeaponRange() ;
-			bool attacker_mask2 = tempStructure->isActive() && tempStructure->hasAOldTarget() && tempStructure->getOldTarget() != NULL
-								&& tempStructure->getOldTarget() ==  this && tempStructure->canAttack(this) && tempStructure->oldtargetInWeaponRange() ;
-
-			if (attacker_mask || attacker_mask2 )
-				return tempStructure;
+	std::vector<ObjectBase*> candidates;
 
-			if(tempStructure->getItemID() == Structure_Wall) {
-					structureDistance += 20000000.0f; //so that walls are targeted very last
-            }
+	// search the cells around us ring by ring until neither a closer object nor an attacker can be found anymore
+	for(int ring = 0; (SpatialIndex::getRingMinDistance(ring) < closestDistance) || (SpatialIndex::getRingMinDistance(ring) <= maxAttackerDistance); ring++) {
+		candidates.clear();
+		if(currentGameMap->getSpatialIndex().getObjectsInRing(location, ring, SPATIALINDEX_ALLHOUSES, candidates) == false) {
+			break;
+		}
+		std::sort(candidates.begin(), candidates.end(), objectIDLess);
+
+		std::vector<ObjectBase*>::const_iterator iter;
+		for(iter = candidates.begin(); iter != candidates.end(); ++iter) {
+			if((*iter)->isAStructure()) {
+				StructureBase* tempStructure = static_cast<StructureBase*>(*iter);
+
+				if(canAttack(tempStructure)) {
+					Coord closestPoint = tempStructure->getClosestPoint(getLocation());
+					float structureDistance = blockDistance(getLocation(), closestPoint);
+					bool attacker_mask = tempStructure->isActive() && tempStructure->hasATarget() && tempStructure->getTarget() != NULL &&
+							tempStructure->getTarget() ==  this && tempStructure->canAttack(this) && tempStructure->targetInWeaponRange() ;
+					bool attacker_mask2 = tempStructure->isActive() && tempStructure->hasAOldTarget() && tempStructure->getOldTarget() != NULL
+										&& tempStructure->getOldTarget() ==  this && tempStructure->canAttack(this) && tempStructure->oldtargetInWeaponRange() ;
+
+					if (attacker_mask || attacker_mask2 )
+						return tempStructure;
+
+					if(tempStructure->getItemID() == Structure_Wall) {
+							structureDistance += 20000000.0f; //so that walls are targeted very last
+					}
 
-            if(structureDistance < closestDistance)	{
-                closestDistance = structureDistance;
-                closestObject = tempStructure;
-            }
-        }
+					if(structureDistance < closestDistance)	{
+						closestDistance = structureDistance;
+						closestObject = tempStructure;
+					}
+				}
+			} else if((*iter)->isAUnit()) {
+				UnitBase* tempUnit = static_cast<UnitBase*>(*iter);
+
+				if(canAttack(tempUnit)) {
+					Coord closestPoint = tempUnit->getClosestPoint(getLocation());
+					float unitDistance = blockDistance(getLocation(), closestPoint);
+					bool attacker_mask = tempUnit->isActive() && !tempUnit->isDestoyed() && tempUnit->hasATarget() && tempUnit->getTarget() != NULL &&
+							tempUnit->getTarget() ==  this && tempUnit->canAttack(this) && tempUnit->targetInWeaponRange() ;
+					bool attacker_mask2 = tempUnit->isActive() && tempUnit->hasAOldTarget() && tempUnit->getOldTarget() != NULL &&
+													tempUnit->getOldTarget() ==  this && tempUnit->canAttack(this) && tempUnit->oldtargetInWeaponRange() ;
+
+					if (attacker_mask || attacker_mask2 )
+						return tempUnit;
+
+					if(unitDistance < closestDistance) {
+						closestDistance = unitDistance;
+						closestObject = tempUnit;
+					}
+				}
+			}
+		}
 	}
 
-    RobustList<UnitBase*>::const_iterator iter2;
-    for(iter2 = unitList.begin(); iter2 != unitList.end(); ++iter2) {
-        UnitBase* tempUnit = *iter2;
+	return closestObject;
+}
 
-		if(canAttack(tempUnit)) {
-			Coord closestPoint = tempUnit->getClosestPoint(getLocation());
-			float unitDistance = blockDistance(getLocation(), closestPoint);
-			bool attacker_mask = tempUnit->isActive() && !tempUnit->isDestoyed() && tempUnit->hasATarget() && tempUnit->getTarget() != NULL &&
-					tempUnit->getTarget() ==  this && tempUnit->canAttack(this) && tempUnit->targetInWeaponRange() ;
-			bool attacker_mask2 = tempUnit->isActive() && tempUnit->hasAOldTarget() && tempUnit->getOldTarget() != NULL &&
-											tempUnit->getOldTarget() ==  this && tempUnit->canAttack(this) && tempUnit->oldtargetInWeaponRange() ;
+/// An object found by ObjectBase::findTarget() together with the tile it was found on
+struct TargetCandidate {
+	TargetCandidate(const Coord& pos, ObjectBase* pObject) : pos(pos), pObject(pObject) { };
 
-			if (attacker_mask || attacker_mask2 )
-				return tempUnit;
+	Coord		pos;
+	ObjectBase*	pObject;
+};
 
-			if(unitDistance < closestDistance) {
-                closestDistance = unitDistance;
-				closestObject = tempUnit;
-            }
-        }
+/// Orders the candidates in the order the scan area used to be searched tile by tile (column by column)
+static bool targetCandidateLess(const TargetCandidate& c1, const TargetCandidate& c2) {
+	if(c1.pos.x != c2.pos.x) {
+		return c1.pos.x < c2.pos.x;
+	} else if(c1.pos.y != c2.pos.y) {
+		return c1.pos.y < c2.pos.y;
+	} else {
+		return c1.pObject->getObjectID() < c2.pObject->getObjectID();
 	}
-
-	return closestObject;
 }
 
-
 const ObjectBase* ObjectBase::findTarget() const {
  	ObjectBase	*tempTarget, *closestTarget2, *closestTarget;
 
@@ -602,12 +704,7 @@ const ObjectBase* ObjectBase::findTarget() const {
 
         case HUNT: {
             // check whole map
-        	// TODO Optimize this : keep a cache of relative distance from caller object
-           /* const ObjectBase* closestUnit = findClosestTargetUnit();
-            if (closestUnit == NULL)
-            	 return findClosestTarget();
-            else return closestUnit;*/
-        	checkRange =  currentGameMap->getSizeX();
+        	checkRange = std::max(currentGameMap->getSizeX(), currentGameMap->getSizeY());
         } break;
 
         case STOP:
@@ -616,72 +713,71 @@ const ObjectBase* ObjectBase::findTarget() const {
         } break;
     }
 
-	int xCheck = xPos - checkRange;
+	// the height of the area is taken from lookDist; beyond its end the area is a square of checkRange
+	int checkRangeY = std::max(checkRange, lookDist[0]);
 
-	if(xCheck < 0) {
-		xCheck = 0;
-	}
+	std::vector<ObjectBase*> objects;
+	currentGameMap->getSpatialIndex().getObjectsInRect(xPos - checkRange, yPos - checkRangeY, xPos + checkRange, yPos + checkRangeY, SPATIALINDEX_ALLHOUSES, objects);
 
-	while((xCheck < currentGameMap->getSizeX()) && ((xCheck - xPos) <= checkRange)) {
-		int yCheck = (yPos - lookDist[abs(xCheck - xPos)]);
+	std::vector<TargetCandidate> candidates;
+	candidates.reserve(objects.size());
+	for(std::vector<ObjectBase*>::const_iterator iter = objects.begin(); iter != objects.end(); ++iter) {
+		Coord closestPoint = (*iter)->getClosestPoint(location);
+		int xDist = abs(closestPoint.x - xPos);
+		int yDist = abs(closestPoint.y - yPos);
 
-		if(yCheck < 0) {
-			yCheck = 0;
+		if((xDist <= checkRange) && (yDist <= ((xDist < 11) ? lookDist[xDist] : checkRange))) {
+			candidates.push_back(TargetCandidate(closestPoint, *iter));
 		}
+	}
 
-		while((yCheck < currentGameMap->getSizeY()) && ((yCheck - yPos) <=  lookDist[abs(xCheck - xPos)])) {
-
-
-			if(currentGameMap->getTile(xCheck,yCheck)->hasAnObject()) {
-				tempTarget = currentGameMap->getTile(xCheck,yCheck)->getObject();
-				  if (canAttack(tempTarget))
-				  {
-					float targetDistance = blockDistance(location, tempTarget->getLocation());
-					tTID = tempTarget->getItemID();
-
-				//	prevent_wall = ( (tTID != Structure_Wall) );
-				//	no_caryall = ( (tTID != Unit_Carryall) );
+	std::sort(candidates.begin(), candidates.end(), targetCandidateLess);
 
+	for(std::vector<TargetCandidate>::const_iterator iter = candidates.begin(); iter != candidates.end(); ++iter) {
+		tempTarget = iter->pObject;
+		  if (canAttack(tempTarget))
+		  {
+			float targetDistance = blockDistance(location, tempTarget->getLocation());
+			tTID = tempTarget->getItemID();
 
-					if (tTID == Structure_Wall || tTID == Unit_Carryall )
-						targetDistance *= 10;
+		//	prevent_wall = ( (tTID != Structure_Wall) );
+		//	no_caryall = ( (tTID != Unit_Carryall) );
 
-					bool fre_inf = (tempTarget->isInfantry() && tempTarget->getOriginalHouseID() == HOUSE_FREMEN);
 
-					if( isAUnit() ) {
-						if  ( itemID != Unit_Sandworm || (itemID == Unit_Sandworm && ((UnitBase*)tempTarget)->isMoving() && !fre_inf)) {
-							agg_Distance += targetDistance ;
-							avg_Distance = (float)agg_Distance / ++count;
+			if (tTID == Structure_Wall || tTID == Unit_Carryall )
+				targetDistance *= 10;
 
-							// Retaliate on personnel attacker first
-							if ( (tempTarget->getTarget() == this && targetDistance <= avg_Distance)) {
-									closestTarget = tempTarget;
-									closestDistance = targetDistance;
-									// This vengence is in plain sight, target is found, period
-									if (targetDistance <= getWeaponRange())
-										return closestTarget;
-							}
+			bool fre_inf = (tempTarget->isInfantry() && tempTarget->getOriginalHouseID() == HOUSE_FREMEN);
 
-							if (targetDistance < closestDistance) {
-								closestTarget = tempTarget;
-								closestDistance = targetDistance;
-							}
-						}
-					} else {
+			if( isAUnit() ) {
+				if  ( itemID != Unit_Sandworm || (itemID == Unit_Sandworm && ((UnitBase*)tempTarget)->isMoving() && !fre_inf)) {
+					agg_Distance += targetDistance ;
+					avg_Distance = (float)agg_Distance / ++count;
 
-						float targetDistance = blockDistance(location, tempTarget->getLocation());
-						if (targetDistance < closestDistance) {
+					// Retaliate on personnel attacker first
+					if ( (tempTarget->getTarget() == this && targetDistance <= avg_Distance)) {
 							closestTarget = tempTarget;
 							closestDistance = targetDistance;
-						}
+							// This vengence is in plain sight, target is found, period
+							if (targetDistance <= getWeaponRange())
+								return closestTarget;
 					}
 
-				} /* canAttack(tempTarget) */
+					if (targetDistance < closestDistance) {
+						closestTarget = tempTarget;
+						closestDistance = targetDistance;
+					}
+				}
+			} else {
 
+				float targetDistance = blockDistance(location, tempTarget->getLocation());
+				if (targetDistance < closestDistance) {
+					closestTarget = tempTarget;
+					closestDistance = targetDistance;
+				}
 			}
-			yCheck++;
-		}
-		xCheck++;
+
+		} /* canAttack(tempTarget) */
 	}
 
 
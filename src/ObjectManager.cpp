@@ -21,25 +21,68 @@
 
 #include <Game.h>
 #include <ObjectBase.h>
+#include <structures/StructureBase.h>
+#include <units/UnitBase.h>
 
 void ObjectManager::save(OutputStream& stream) const {
-    stream.writeUint32(nextFreeObjectID);
+    stream.writeUint32(slots.size());
+    for(size_t i = 0; i < slots.size(); i++) {
+        stream.writeUint16(slots[i].generation);
+    }
+
+    stream.writeUint32(freeSlots.size());
+    std::deque<Uint32>::const_iterator freeIter;
+    for(freeIter = freeSlots.begin(); freeIter != freeSlots.end(); ++freeIter) {
+        stream.writeUint32(*freeIter);
+    }
 
-    stream.writeUint32(objectMap.size());
-    ObjectMap::const_iterator iter;
-    for(iter = objectMap.begin(); iter != objectMap.end(); ++iter) {
-        stream.writeUint32(iter->second->getObjectID());
-        currentGame->saveObject(stream, iter->second);
+    // objects are saved in the order of structureList and unitList; loading them in this order adds them to these
+    // lists in the same order again, so a loaded game updates its objects in the same order as the saved one
+    Uint32 numListedObjects = 0;
+    for(DenseList<StructureBase*>::const_iterator iter = structureList.begin(); iter != structureList.end(); ++iter) {
+        numListedObjects++;
+    }
+    for(DenseList<UnitBase*>::const_iterator iter = unitList.begin(); iter != unitList.end(); ++iter) {
+        numListedObjects++;
     }
+
+    if(numListedObjects != numObjects) {
+        fprintf(stderr,"ObjectManager::save(): %d objects are in the object lists but %d objects are managed!\n",numListedObjects,numObjects);
+    }
+
+    stream.writeUint32(numListedObjects);
+    for(DenseList<StructureBase*>::const_iterator iter = structureList.begin(); iter != structureList.end(); ++iter) {
+        saveObject(stream, *iter);
+    }
+    for(DenseList<UnitBase*>::const_iterator iter = unitList.begin(); iter != unitList.end(); ++iter) {
+        saveObject(stream, *iter);
+    }
+}
+
+void ObjectManager::saveObject(OutputStream& stream, ObjectBase* pObject) const {
+    stream.writeUint32(pObject->getObjectID());
+    currentGame->saveObject(stream, pObject);
 }
 
 void ObjectManager::load(InputStream& stream) {
-    nextFreeObjectID = stream.readUint32();
+    Uint32 numSlots = stream.readUint32();
+    slots.clear();
+    slots.resize(numSlots);
+    for(Uint32 i = 0; i < numSlots; i++) {
+        slots[i].generation = stream.readUint16();
+    }
+
+    Uint32 numFreeSlots = stream.readUint32();
+    freeSlots.clear();
+    for(Uint32 i = 0; i < numFreeSlots; i++) {
+        freeSlots.push_back(stream.readUint32());
+    }
 
-    Uint32 numObjects = stream.readUint32();
-    fprintf(stderr,"ObjectManager::load(): %i objects to load \n",numObjects);
+    numObjects = 0;
+    Uint32 numSavedObjects = stream.readUint32();
+    fprintf(stderr,"ObjectManager::load(): %i objects to load \n",numSavedObjects);
 
-    for(Uint32 i=0;i<numObjects;i++) {
+    for(Uint32 i=0;i<numSavedObjects;i++) {
         Uint32 objectID = stream.readUint32();
 
         ObjectBase* pObject = currentGame->loadObject(stream,objectID);
@@ -48,20 +91,49 @@ void ObjectManager::load(InputStream& stream) {
 				fprintf(stderr,"ObjectManager::load(): The loaded object has a different ID than expected (%d!=%d)!\n",objectID,pObject->getObjectID());
 			}
 
-			objectMap.insert( std::pair<Uint32,ObjectBase*>(objectID, pObject) );
+			Uint32 slotIndex = objectID & OBJECTID_SLOTMASK;
+			if((slotIndex < slots.size()) && (slots[slotIndex].pObject == NULL)) {
+                slots[slotIndex].pObject = pObject;
+                numObjects++;
+			} else {
+                fprintf(stderr,"ObjectManager::load(): Invalid or duplicate object ID %d!\n",objectID);
+			}
         }
     }
 }
 
 Uint32 ObjectManager::addObject(ObjectBase* pObject) {
-    std::pair<ObjectMap::iterator,bool> insertPosition;
+    Uint32 slotIndex;
 
-    insertPosition = objectMap.insert( std::pair<Uint32,ObjectBase*>(nextFreeObjectID, pObject) );
-
-    if(insertPosition.second == false) {
-        // there is already such an object in the list
-        return NONE;
+    if(freeSlots.empty() == false) {
+        slotIndex = freeSlots.front();
+        freeSlots.pop_front();
+    } else if(slots.size() <= OBJECTID_SLOTMASK) {
+        slotIndex = slots.size();
+        slots.push_back(Slot());
     } else {
-        return nextFreeObjectID++;  // Caution: Old value is returned but value is incremented afterwards
+        // all slots are in use
+        return NONE;
     }
+
+    slots[slotIndex].pObject = pObject;
+    numObjects++;
+
+    return (slots[slotIndex].generation << OBJECTID_SLOTBITS) | slotIndex;
+}
+
+bool ObjectManager::removeObject(Uint32 objectID) {
+    Uint32 slotIndex = objectID & OBJECTID_SLOTMASK;
+
+    if(getObject(objectID) == NULL) {
+        return false;
+    }
+
+    Slot& slot = slots[slotIndex];
+    slot.pObject = NULL;
+    slot.generation = (slot.generation >= OBJECTID_MAXGENERATION) ? 0 : (slot.generation + 1);
+    freeSlots.push_back(slotIndex);
+    numObjects--;
+
+    return true;
 }
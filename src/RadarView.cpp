@@ -34,7 +34,8 @@
 
 
 RadarView::RadarView()
- : RadarViewBase(), currentRadarMode(Mode_RadarOff), animFrame(NUM_STATIC_FRAMES - 1), animCounter(NUM_STATIC_FRAME_TIME)
+ : RadarViewBase(), currentRadarMode(Mode_RadarOff), animFrame(NUM_STATIC_FRAMES - 1), animCounter(NUM_STATIC_FRAME_TIME),
+   bFullRepaint(true), bLastRadarOn(false), bLastDebug(false), numRepaintedCells(0)
 {
     radarStaticAnimation = pGFXManager->getUIGraphic(UI_RadarAnimation);
 
@@ -175,6 +176,7 @@ void RadarView::update() {
 
 void RadarView:: switchRadarMode(bool bOn) {
     soundPlayer->playSound(RadarNoise);
+    bFullRepaint = true;
 
     if(bOn == true) {
         soundPlayer->playVoice(RadarActivated,pLocalHouse->getHouseID());
@@ -187,29 +189,53 @@ void RadarView:: switchRadarMode(bool bOn) {
 
 void RadarView::updateRadarSurface(int mapSizeX, int mapSizeY, int scale, int offsetX, int offsetY) {
 
+    bool bRadarOn = pLocalHouse->hasRadarOn();
+    if((bRadarOn != bLastRadarOn) || (debug != bLastDebug)) {
+        bFullRepaint = true;
+    }
+
     // Lock radarSurface for direct access to the pixels
     if(!SDL_MUSTLOCK(radarSurface) || (SDL_LockSurface(radarSurface) == 0)) {
-        for(int x = 0; x <  mapSizeX; x++) {
-            for(int y = 0; y <  mapSizeY; y++) {
+        if(bFullRepaint) {
+            for(int x = 0; x <  mapSizeX; x++) {
+                for(int y = 0; y <  mapSizeY; y++) {
+                    updateRadarCell(currentGameMap->getTile(x,y), bRadarOn, scale, offsetX, offsetY);
+                }
+            }
+            numRepaintedCells = mapSizeX*mapSizeY;
+
+            bFullRepaint = false;
+            bLastRadarOn = bRadarOn;
+            bLastDebug = debug;
+        } else {
+            // only the cells of tiles that changed since the last draw
+            const std::vector<Tile*>& dirtyTiles = currentGameMap->getRadarDirtyTiles();
+            for(std::vector<Tile*>::const_iterator iter = dirtyTiles.begin(); iter != dirtyTiles.end(); ++iter) {
+                updateRadarCell(*iter, bRadarOn, scale, offsetX, offsetY);
+            }
+            numRepaintedCells = dirtyTiles.size();
+        }
 
-                Tile* pTile = currentGameMap->getTile(x,y);
+        currentGameMap->clearRadarDirtyTiles();
 
-                /* Selecting the right color is handled in Tile::getRadarColor() */
-                Uint32 color = pTile->getRadarColor(pLocalHouse, pLocalHouse->hasRadarOn());
+        if(SDL_MUSTLOCK(radarSurface)) {
+            SDL_UnlockSurface(radarSurface);
+        }
+    }
+}
 
-                for(int j = 0; j < scale; j++) {
-                    Uint8* p = (Uint8 *) radarSurface->pixels + (offsetY + scale*y + j) * radarSurface->pitch + (offsetX + scale*x);
+void RadarView::updateRadarCell(Tile* pTile, bool bRadar, int scale, int offsetX, int offsetY) {
+    const Coord& location = pTile->getLocation();
 
-                    for(int i = 0; i < scale; i++, p++) {
-                        // Do not use putPixel here to avoid overhead
-                        *p = color;
-                    }
-                }
-            }
-        }
+    /* Selecting the right color is handled in Tile::getRadarColor() */
+    Uint32 color = pTile->getRadarColor(pLocalHouse, bRadar);
+
+    for(int j = 0; j < scale; j++) {
+        Uint8* p = (Uint8 *) radarSurface->pixels + (offsetY + scale*location.y + j) * radarSurface->pitch + (offsetX + scale*location.x);
 
-        if(SDL_MUSTLOCK(screen)) {
-            SDL_UnlockSurface(screen);
+        for(int i = 0; i < scale; i++, p++) {
+            // Do not use putPixel here to avoid overhead
+            *p = color;
         }
     }
 }
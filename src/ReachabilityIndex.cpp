@@ -0,0 +1,335 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReachabilityIndex.h>
+
+#include <globals.h>
+
+#include <Map.h>
+#include <Tile.h>
+#include <units/UnitBase.h>
+
+#include <algorithm>
+#include <stack>
+#include <stdlib.h>
+#include <math.h>
+
+ReachabilityIndex::ReachabilityIndex(Map* pMap)
+ : pMap(pMap), sizeX(0), sizeY(0) {
+}
+
+ReachabilityIndex::~ReachabilityIndex() {
+}
+
+ReachabilityIndex::MOVECLASS ReachabilityIndex::getMoveClass(const UnitBase* pUnit) {
+    if(pUnit->isAFlyingUnit()) {
+        return MoveClass_Invalid;
+    } else if(pUnit->getItemID() == Unit_Sandworm) {
+        return MoveClass_Sand;
+    } else if(pUnit->isInfantry()) {
+        return MoveClass_Infantry;
+    } else {
+        return MoveClass_Ground;
+    }
+}
+
+bool ReachabilityIndex::isPassable(const Tile* pTile, MOVECLASS moveClass) {
+    switch(moveClass) {
+        case MoveClass_Ground:      return (!pTile->isMountain() && !pTile->hasAStructure());
+        case MoveClass_Infantry:    return !pTile->hasAStructure();
+        case MoveClass_Sand:        return !pTile->isRock();
+        default:                    return true;
+    }
+}
+
+bool ReachabilityIndex::isReachable(MOVECLASS moveClass, const Coord& start, const Coord& destination) {
+    if((moveClass == MoveClass_Invalid) || !pMap->tileExists(start) || !pMap->tileExists(destination)) {
+        return true;
+    }
+
+    updateLayer(moveClass);
+
+    Sint32 startComponent = getComponent(moveClass, start.x, start.y);
+    if(startComponent == INVALID) {
+        // we are standing on a blocked tile (e.g. leaving a structure)
+        return true;
+    }
+
+    Sint32 destinationComponent = getComponent(moveClass, destination.x, destination.y);
+    if(destinationComponent != INVALID) {
+        return (destinationComponent == startComponent);
+    }
+
+    // the destination is blocked itself (e.g. a structure to attack) => check if we can get next to it
+    for(int angle = 0; angle < NUM_ANGLES; angle++) {
+        Coord pos = pMap->getMapPos(angle, destination);
+        if(pMap->tileExists(pos) && (getComponent(moveClass, pos.x, pos.y) == startComponent)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Coord ReachabilityIndex::findClosestReachableTile(MOVECLASS moveClass, const Coord& start, const Coord& destination) {
+    if((moveClass == MoveClass_Invalid) || !pMap->tileExists(start) || !pMap->tileExists(destination)) {
+        return destination;
+    }
+
+    updateLayer(moveClass);
+
+    Sint32 startComponent = getComponent(moveClass, start.x, start.y);
+    if(startComponent == INVALID) {
+        return destination;
+    }
+
+    Coord closestTile = start;
+    float closestDistance = blockDistance(start, destination);
+    int maxRadius = std::max(sizeX, sizeY);
+    int searchRadius = maxRadius;
+
+    // search in growing squares around the destination; a tile found in square k may still be beaten by a tile
+    // in one of the next squares up to k*sqrt(2)
+    for(int radius = 1; (radius <= searchRadius) && (radius <= maxRadius); radius++) {
+        for(int y = destination.y - radius; y <= destination.y + radius; y++) {
+            for(int x = destination.x - radius; x <= destination.x + radius; x++) {
+                if((y != destination.y - radius) && (y != destination.y + radius) && (x != destination.x - radius) && (x != destination.x + radius)) {
+                    continue;
+                }
+
+                if(!pMap->tileExists(x,y) || (getComponent(moveClass, x, y) != startComponent)) {
+                    continue;
+                }
+
+                float distance = blockDistance(Coord(x,y), destination);
+                if(distance < closestDistance) {
+                    closestDistance = distance;
+                    closestTile = Coord(x,y);
+                    searchRadius = std::min(searchRadius, (int) ceil(radius * DIAGONALCOST));
+                }
+            }
+        }
+    }
+
+    return closestTile;
+}
+
+Sint32 ReachabilityIndex::getComponentID(MOVECLASS moveClass, const Coord& pos) {
+    if((moveClass == MoveClass_Invalid) || !pMap->tileExists(pos)) {
+        return INVALID;
+    }
+
+    updateLayer(moveClass);
+
+    return getComponent(moveClass, pos.x, pos.y);
+}
+
+void ReachabilityIndex::tileChanged(const Coord& pos) {
+    if(!pMap->tileExists(pos)) {
+        return;
+    }
+
+    const Tile* pTile = pMap->getTile(pos);
+
+    for(int i = 0; i < NUM_MOVECLASSES; i++) {
+        MOVECLASS moveClass = (MOVECLASS) i;
+        Layer& layer = layers[moveClass];
+        if(layer.bInitialized == false) {
+            continue;
+        }
+
+        Sint32& component = layer.components[pos.x + pos.y*sizeX];
+        bool bPassable = isPassable(pTile, moveClass);
+
+        if(bPassable && (component == INVALID)) {
+            tileBecamePassable(moveClass, pos);
+        } else if(!bPassable && (component != INVALID)) {
+            Sint32 oldComponent = component;
+            component = INVALID;
+            layer.componentSizes[oldComponent]--;
+            tileBecameBlocked(moveClass, pos, oldComponent);
+        }
+    }
+}
+
+void ReachabilityIndex::clear() {
+    for(int i = 0; i < NUM_MOVECLASSES; i++) {
+        layers[i].bInitialized = false;
+        layers[i].components.clear();
+        layers[i].componentSizes.clear();
+    }
+}
+
+void ReachabilityIndex::updateLayer(MOVECLASS moveClass) {
+    if((sizeX != pMap->getSizeX()) || (sizeY != pMap->getSizeY())) {
+        sizeX = pMap->getSizeX();
+        sizeY = pMap->getSizeY();
+        clear();
+    }
+
+    Layer& layer = layers[moveClass];
+
+    // component numbers are never reused, so renumber them from time to time
+    if((layer.bInitialized == false) || (layer.componentSizes.size() > (size_t) (sizeX*sizeY))) {
+        rebuildLayer(moveClass);
+    }
+}
+
+void ReachabilityIndex::rebuildLayer(MOVECLASS moveClass) {
+    Layer& layer = layers[moveClass];
+
+    layer.components.assign(sizeX*sizeY, INVALID);
+    layer.componentSizes.clear();
+    layer.bInitialized = true;
+
+    for(int y = 0; y < sizeY; y++) {
+        for(int x = 0; x < sizeX; x++) {
+            if((layer.components[x + y*sizeX] == INVALID) && isPassable(pMap->getTile(x,y), moveClass)) {
+                layer.componentSizes.push_back(0);
+                floodFill(moveClass, Coord(x,y), layer.componentSizes.size() - 1);
+            }
+        }
+    }
+}
+
+void ReachabilityIndex::floodFill(MOVECLASS moveClass, const Coord& start, Sint32 newComponent) {
+    Layer& layer = layers[moveClass];
+    Sint32 oldComponent = layer.components[start.x + start.y*sizeX];
+
+    std::stack<Coord> tileStack;
+    tileStack.push(start);
+    layer.components[start.x + start.y*sizeX] = newComponent;
+    layer.componentSizes[newComponent]++;
+    if(oldComponent != INVALID) {
+        layer.componentSizes[oldComponent]--;
+    }
+
+    while(!tileStack.empty()) {
+        Coord current = tileStack.top();
+        tileStack.pop();
+
+        for(int angle = 0; angle < NUM_ANGLES; angle++) {
+            Coord pos = pMap->getMapPos(angle, current);
+            if(!pMap->tileExists(pos)) {
+                continue;
+            }
+
+            Sint32& component = layer.components[pos.x + pos.y*sizeX];
+            if(component == newComponent) {
+                continue;
+            }
+
+            // when relabeling only the old component is followed; when building from scratch every passable tile
+            if((oldComponent != INVALID) ? (component == oldComponent) : ((component == INVALID) && isPassable(pMap->getTile(pos), moveClass))) {
+                if(component != INVALID) {
+                    layer.componentSizes[component]--;
+                }
+                component = newComponent;
+                layer.componentSizes[newComponent]++;
+                tileStack.push(pos);
+            }
+        }
+    }
+}
+
+void ReachabilityIndex::tileBecamePassable(MOVECLASS moveClass, const Coord& pos) {
+    Layer& layer = layers[moveClass];
+
+    // join the biggest neighbouring component and relabel all the other ones
+    Sint32 biggestComponent = INVALID;
+    for(int angle = 0; angle < NUM_ANGLES; angle++) {
+        Coord neighbour = pMap->getMapPos(angle, pos);
+        if(!pMap->tileExists(neighbour)) {
+            continue;
+        }
+
+        Sint32 component = getComponent(moveClass, neighbour.x, neighbour.y);
+        if((component != INVALID) && ((biggestComponent == INVALID) || (layer.componentSizes[component] > layer.componentSizes[biggestComponent]))) {
+            biggestComponent = component;
+        }
+    }
+
+    if(biggestComponent == INVALID) {
+        layer.componentSizes.push_back(1);
+        layer.components[pos.x + pos.y*sizeX] = layer.componentSizes.size() - 1;
+        return;
+    }
+
+    layer.components[pos.x + pos.y*sizeX] = biggestComponent;
+    layer.componentSizes[biggestComponent]++;
+
+    for(int angle = 0; angle < NUM_ANGLES; angle++) {
+        Coord neighbour = pMap->getMapPos(angle, pos);
+        if(pMap->tileExists(neighbour)) {
+            Sint32 component = getComponent(moveClass, neighbour.x, neighbour.y);
+            if((component != INVALID) && (component != biggestComponent)) {
+                floodFill(moveClass, neighbour, biggestComponent);
+            }
+        }
+    }
+}
+
+void ReachabilityIndex::tileBecameBlocked(MOVECLASS moveClass, const Coord& pos, Sint32 oldComponent) {
+    Layer& layer = layers[moveClass];
+
+    Coord neighbours[NUM_ANGLES];
+    int numNeighbours = 0;
+    for(int angle = 0; angle < NUM_ANGLES; angle++) {
+        Coord neighbour = pMap->getMapPos(angle, pos);
+        if(pMap->tileExists(neighbour) && (getComponent(moveClass, neighbour.x, neighbour.y) == oldComponent)) {
+            neighbours[numNeighbours++] = neighbour;
+        }
+    }
+
+    // if the remaining neighbours are still connected among themselves the component cannot have been split
+    int groups[NUM_ANGLES];
+    for(int i = 0; i < numNeighbours; i++) {
+        groups[i] = i;
+    }
+    for(int i = 0; i < numNeighbours; i++) {
+        for(int j = i+1; j < numNeighbours; j++) {
+            if((abs(neighbours[i].x - neighbours[j].x) <= 1) && (abs(neighbours[i].y - neighbours[j].y) <= 1)) {
+                int oldGroup = groups[j];
+                for(int k = 0; k < numNeighbours; k++) {
+                    if(groups[k] == oldGroup) {
+                        groups[k] = groups[i];
+                    }
+                }
+            }
+        }
+    }
+
+    bool bLocallyConnected = true;
+    for(int i = 1; i < numNeighbours; i++) {
+        if(groups[i] != groups[0]) {
+            bLocallyConnected = false;
+            break;
+        }
+    }
+
+    if(bLocallyConnected) {
+        return;
+    }
+
+    // the component might have been split; give every part reachable from a neighbour a new number
+    for(int i = 0; i < numNeighbours; i++) {
+        if(getComponent(moveClass, neighbours[i].x, neighbours[i].y) == oldComponent) {
+            layer.componentSizes.push_back(0);
+            floodFill(moveClass, neighbours[i], layer.componentSizes.size() - 1);
+        }
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <SaveGameWriter.h>
+
+#include <globals.h>
+
+#include <Game.h>
+
+#include <misc/OFileStream.h>
+#include <misc/OCompressedStream.h>
+
+#include <stdexcept>
+
+SaveGameWriter::SaveGameWriter()
+ : bFinished(false), bSuccess(false), bCompress(true), saveThread(NULL) {
+
+	sharedDataMutex = SDL_CreateMutex();
+	if(sharedDataMutex == NULL) {
+		throw std::runtime_error("Unable to create mutex");
+	}
+}
+
+SaveGameWriter::~SaveGameWriter() {
+	waitForSave();
+
+	SDL_DestroyMutex(sharedDataMutex);
+}
+
+bool SaveGameWriter::startSave(const std::string& filename, const OMemoryStream& headerStream, const OMemoryStream& bodyStream, bool bCompress) {
+	// only one save at a time
+	waitForSave();
+	update();
+
+	this->filename = filename;
+	headerData.assign(headerStream.getData(), headerStream.getDataLength());
+	bodyData.assign(bodyStream.getData(), bodyStream.getDataLength());
+	this->bCompress = bCompress;
+
+	SDL_LockMutex(sharedDataMutex);
+	bFinished = false;
+	bSuccess = false;
+	SDL_UnlockMutex(sharedDataMutex);
+
+	saveThread = SDL_CreateThread(saveThreadMain, (void*) this);
+	if(saveThread == NULL) {
+		// write it here instead
+		fprintf(stderr, "SaveGameWriter::startSave(): Unable to create thread; writing the save game synchronously!\n");
+		writeSaveGame();
+		update();
+	}
+
+	return true;
+}
+
+void SaveGameWriter::update() {
+	SDL_LockMutex(sharedDataMutex);
+	bool bTmpFinished = bFinished;
+	bool bTmpSuccess = bSuccess;
+	bFinished = false;
+	SDL_UnlockMutex(sharedDataMutex);
+
+	if(bTmpFinished == false) {
+		return;
+	}
+
+	if(saveThread != NULL) {
+		SDL_WaitThread(saveThread, NULL);
+		saveThread = NULL;
+	}
+
+	headerData.clear();
+	bodyData.clear();
+
+	if((bTmpSuccess == false) && (currentGame != NULL)) {
+		currentGame->addToNewsTicker(std::string("Game NOT saved: Cannot write \"") + filename + "\".");
+	}
+}
+
+void SaveGameWriter::waitForSave() {
+	if(saveThread != NULL) {
+		SDL_WaitThread(saveThread, NULL);
+		saveThread = NULL;
+	}
+}
+
+void SaveGameWriter::writeSaveGame() {
+	bool bTmpSuccess = false;
+
+	try {
+		OFileStream fs;
+
+		if(fs.open(filename) == false) {
+			perror("SaveGameWriter::writeSaveGame()");
+		} else {
+			fs.writeData(headerData.data(), headerData.size());
+
+			// the rest of the savegame is stored in compressed blocks
+			OCompressedStream stream(&fs, bCompress);
+			stream.writeData(bodyData.data(), bodyData.size());
+			stream.flush();
+
+			fs.close();
+
+			bTmpSuccess = true;
+		}
+	} catch(OutputStream::exception& e) {
+		fprintf(stderr, "SaveGameWriter::writeSaveGame(): %s\n", e.what());
+	}
+
+	SDL_LockMutex(sharedDataMutex);
+	bFinished = true;
+	bSuccess = bTmpSuccess;
+	SDL_UnlockMutex(sharedDataMutex);
+}
+
+int SaveGameWriter::saveThreadMain(void* data) {
+	SaveGameWriter* pSaveGameWriter = (SaveGameWriter*) data;
+
+	pSaveGameWriter->writeSaveGame();
+
+	return 0;
+}
@@ -0,0 +1,227 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <SpatialIndex.h>
+
+#include <globals.h>
+
+#include <Game.h>
+#include <House.h>
+#include <Map.h>
+#include <ObjectBase.h>
+#include <ObjectManager.h>
+
+#include <algorithm>
+#include <stdlib.h>
+
+static bool objectIDLess(const ObjectBase* pObject1, const ObjectBase* pObject2) {
+	return pObject1->getObjectID() < pObject2->getObjectID();
+}
+
+SpatialIndex::SpatialIndex(Map* pMap)
+ : pMap(pMap), numCellsX(0), numCellsY(0), bDirty(true), queryStamp(0) {
+}
+
+SpatialIndex::~SpatialIndex() {
+}
+
+void SpatialIndex::objectAssigned(Uint32 objectID, const Coord& pos) {
+	checkMapSize();
+	if(bDirty) {
+		return;
+	}
+
+	ObjectBase* pObject = currentGame->getObjectManager().getObject(objectID);
+	if((pObject == NULL) || (pObject->getOwner() == NULL)) {
+		// we cannot file this object under its house now
+		bDirty = true;
+		return;
+	}
+
+	std::unordered_map<Uint32, ObjectEntry>::iterator iter = objectEntries.find(objectID);
+	if(iter == objectEntries.end()) {
+		iter = objectEntries.insert(std::make_pair(objectID, ObjectEntry())).first;
+		iter->second.houseID = pObject->getOwner()->getHouseID();
+	}
+
+	iter->second.numTiles++;
+	addToCell(iter->second.houseID, objectID, pos);
+}
+
+void SpatialIndex::objectUnassigned(Uint32 objectID, const Coord& pos) {
+	checkMapSize();
+	if(bDirty) {
+		return;
+	}
+
+	std::unordered_map<Uint32, ObjectEntry>::iterator iter = objectEntries.find(objectID);
+	if((iter == objectEntries.end()) || !removeFromCell(iter->second.houseID, objectID, pos)) {
+		bDirty = true;
+		return;
+	}
+
+	if(--iter->second.numTiles == 0) {
+		objectEntries.erase(iter);
+	}
+}
+
+void SpatialIndex::objectOwnerChanged(Uint32 objectID) {
+	if(objectEntries.find(objectID) != objectEntries.end()) {
+		// owner changes are rare; simply refile everything on the next query
+		bDirty = true;
+	}
+}
+
+void SpatialIndex::clear() {
+	cells.clear();
+	objectEntries.clear();
+	bDirty = true;
+}
+
+void SpatialIndex::getObjectsInRect(int x1, int y1, int x2, int y2, Uint32 houseMask, std::vector<ObjectBase*>& objects) {
+	checkMapSize();
+	if(bDirty) {
+		rebuild();
+	}
+
+	x1 = std::max(x1, 0);
+	y1 = std::max(y1, 0);
+	x2 = std::min(x2, pMap->getSizeX() - 1);
+	y2 = std::min(y2, pMap->getSizeY() - 1);
+
+	queryStamp++;
+	size_t firstNewObject = objects.size();
+
+	for(int cellY = y1 / SPATIALINDEX_CELLSIZE; cellY <= y2 / SPATIALINDEX_CELLSIZE; cellY++) {
+		for(int cellX = x1 / SPATIALINDEX_CELLSIZE; cellX <= x2 / SPATIALINDEX_CELLSIZE; cellX++) {
+			collectCell(cellX, cellY, houseMask, objects);
+		}
+	}
+
+	std::sort(objects.begin() + firstNewObject, objects.end(), objectIDLess);
+}
+
+bool SpatialIndex::getObjectsInRing(const Coord& center, int ring, Uint32 houseMask, std::vector<ObjectBase*>& objects) {
+	checkMapSize();
+	if(bDirty) {
+		rebuild();
+	}
+
+	if(ring == 0) {
+		queryStamp++;
+	}
+
+	int centerCellX = center.x / SPATIALINDEX_CELLSIZE;
+	int centerCellY = center.y / SPATIALINDEX_CELLSIZE;
+
+	int maxRing = std::max(std::max(centerCellX, numCellsX - 1 - centerCellX), std::max(centerCellY, numCellsY - 1 - centerCellY));
+	if(ring > maxRing) {
+		return false;
+	}
+
+	size_t firstNewObject = objects.size();
+
+	for(int cellY = std::max(centerCellY - ring, 0); cellY <= std::min(centerCellY + ring, numCellsY - 1); cellY++) {
+		bool bEdgeRow = (abs(cellY - centerCellY) == ring);
+		for(int cellX = std::max(centerCellX - ring, 0); cellX <= std::min(centerCellX + ring, numCellsX - 1); cellX++) {
+			if(bEdgeRow || (abs(cellX - centerCellX) == ring)) {
+				collectCell(cellX, cellY, houseMask, objects);
+			}
+		}
+	}
+
+	std::sort(objects.begin() + firstNewObject, objects.end(), objectIDLess);
+
+	return true;
+}
+
+void SpatialIndex::checkMapSize() {
+	int newNumCellsX = (pMap->getSizeX() + SPATIALINDEX_CELLSIZE - 1) / SPATIALINDEX_CELLSIZE;
+	int newNumCellsY = (pMap->getSizeY() + SPATIALINDEX_CELLSIZE - 1) / SPATIALINDEX_CELLSIZE;
+
+	if((newNumCellsX != numCellsX) || (newNumCellsY != numCellsY)) {
+		numCellsX = newNumCellsX;
+		numCellsY = newNumCellsY;
+		clear();
+	}
+}
+
+void SpatialIndex::rebuild() {
+	cells.clear();
+	cells.resize(numCellsX*numCellsY);
+	objectEntries.clear();
+	bDirty = false;
+
+	const std::unordered_map<Uint32, std::vector<Coord> >& objectTileIndex = pMap->getObjectTileIndex();
+
+	std::unordered_map<Uint32, std::vector<Coord> >::const_iterator iter;
+	for(iter = objectTileIndex.begin(); iter != objectTileIndex.end(); ++iter) {
+		ObjectBase* pObject = currentGame->getObjectManager().getObject(iter->first);
+		if((pObject == NULL) || (pObject->getOwner() == NULL)) {
+			continue;
+		}
+
+		ObjectEntry& entry = objectEntries[iter->first];
+		entry.houseID = pObject->getOwner()->getHouseID();
+		entry.numTiles = iter->second.size();
+
+		for(std::vector<Coord>::const_iterator tileIter = iter->second.begin(); tileIter != iter->second.end(); ++tileIter) {
+			addToCell(entry.houseID, iter->first, *tileIter);
+		}
+	}
+}
+
+void SpatialIndex::addToCell(int houseID, Uint32 objectID, const Coord& pos) {
+	getCell(pos).objects[houseID].push_back(objectID);
+}
+
+bool SpatialIndex::removeFromCell(int houseID, Uint32 objectID, const Coord& pos) {
+	std::vector<Uint32>& cellObjects = getCell(pos).objects[houseID];
+
+	std::vector<Uint32>::iterator iter = std::find(cellObjects.begin(), cellObjects.end(), objectID);
+	if(iter == cellObjects.end()) {
+		return false;
+	}
+
+	*iter = cellObjects.back();
+	cellObjects.pop_back();
+	return true;
+}
+
+void SpatialIndex::collectCell(int cellX, int cellY, Uint32 houseMask, std::vector<ObjectBase*>& objects) {
+	Cell& cell = cells[cellX + cellY*numCellsX];
+
+	for(int houseID = 0; houseID < NUM_HOUSES; houseID++) {
+		if((houseMask & (1 << houseID)) == 0) {
+			continue;
+		}
+
+		std::vector<Uint32>::const_iterator iter;
+		for(iter = cell.objects[houseID].begin(); iter != cell.objects[houseID].end(); ++iter) {
+			ObjectEntry& entry = objectEntries[*iter];
+			if(entry.queryStamp == queryStamp) {
+				continue;
+			}
+			entry.queryStamp = queryStamp;
+
+			ObjectBase* pObject = currentGame->getObjectManager().getObject(*iter);
+			if(pObject != NULL) {
+				objects.push_back(pObject);
+			}
+		}
+	}
+}
@@ -0,0 +1,189 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <TerrainCache.h>
+
+#include <globals.h>
+
+#include <Map.h>
+#include <Tile.h>
+#include <House.h>
+#include <ScreenBorder.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+TerrainCache::TerrainCache(Map* pMap)
+ : pMap(pMap), numChunksX(0), numChunksY(0), zoomlevel(INVALID), bDebug(false), numCachedChunks(0), frameCounter(0), numRedrawnTiles(0) {
+}
+
+TerrainCache::~TerrainCache() {
+	clear();
+}
+
+void TerrainCache::tileChanged(const Coord& pos) {
+	if(chunks.empty() || !pMap->tileExists(pos)) {
+		return;
+	}
+
+	Chunk& chunk = chunks[(pos.x / TERRAINCACHE_CHUNKSIZE) + (pos.y / TERRAINCACHE_CHUNKSIZE)*numChunksX];
+	if(chunk.pSurface == NULL) {
+		// it will be drawn completely when it gets visible
+		return;
+	}
+
+	int index = (pos.x % TERRAINCACHE_CHUNKSIZE) + (pos.y % TERRAINCACHE_CHUNKSIZE)*TERRAINCACHE_CHUNKSIZE;
+	if(chunk.dirtyFlags[index] == false) {
+		chunk.dirtyFlags[index] = true;
+		chunk.dirtyTiles.push_back(pos);
+	}
+}
+
+void TerrainCache::clear() {
+	for(std::vector<Chunk>::iterator iter = chunks.begin(); iter != chunks.end(); ++iter) {
+		freeChunk(*iter);
+	}
+	chunks.clear();
+	numChunksX = 0;
+	numChunksY = 0;
+	numCachedChunks = 0;
+}
+
+void TerrainCache::draw(SDL_Surface* pScreen, const Coord& topLeftTile, const Coord& bottomRightTile) {
+	numRedrawnTiles = 0;
+	frameCounter++;
+
+	if((zoomlevel != currentZoomlevel) || (bDebug != debug)) {
+		clear();
+		zoomlevel = currentZoomlevel;
+		bDebug = debug;
+	}
+
+	if(chunks.empty()) {
+		numChunksX = (pMap->getSizeX() + TERRAINCACHE_CHUNKSIZE - 1) / TERRAINCACHE_CHUNKSIZE;
+		numChunksY = (pMap->getSizeY() + TERRAINCACHE_CHUNKSIZE - 1) / TERRAINCACHE_CHUNKSIZE;
+		chunks.resize(numChunksX*numChunksY);
+	}
+
+	int tileSize = world2zoomedWorld(TILESIZE);
+
+	for(int chunkY = topLeftTile.y / TERRAINCACHE_CHUNKSIZE; chunkY <= bottomRightTile.y / TERRAINCACHE_CHUNKSIZE; chunkY++) {
+		for(int chunkX = topLeftTile.x / TERRAINCACHE_CHUNKSIZE; chunkX <= bottomRightTile.x / TERRAINCACHE_CHUNKSIZE; chunkX++) {
+			Chunk& chunk = chunks[chunkX + chunkY*numChunksX];
+			Coord chunkOrigin(chunkX*TERRAINCACHE_CHUNKSIZE, chunkY*TERRAINCACHE_CHUNKSIZE);
+
+			if(chunk.pSurface == NULL) {
+				createChunk(chunk, chunkX, chunkY);
+			} else if(chunk.dirtyTiles.empty() == false) {
+				for(std::vector<Coord>::const_iterator iter = chunk.dirtyTiles.begin(); iter != chunk.dirtyTiles.end(); ++iter) {
+					// redraw the neighbours as well, their damage might reach into this tile
+					SDL_Rect clipRect = { (Sint16) ((iter->x - chunkOrigin.x)*tileSize), (Sint16) ((iter->y - chunkOrigin.y)*tileSize), (Uint16) tileSize, (Uint16) tileSize };
+					SDL_SetClipRect(chunk.pSurface, &clipRect);
+					SDL_FillRect(chunk.pSurface, &clipRect, 0);
+					drawTiles(chunk.pSurface, chunkOrigin, iter->x - 1, iter->y - 1, iter->x + 1, iter->y + 1);
+				}
+				SDL_SetClipRect(chunk.pSurface, NULL);
+
+				numRedrawnTiles += chunk.dirtyTiles.size();
+				chunk.dirtyTiles.clear();
+				std::fill(chunk.dirtyFlags.begin(), chunk.dirtyFlags.end(), false);
+			}
+
+			chunk.lastUsedFrame = frameCounter;
+
+			// only blit the visible part of this chunk
+			int x1 = std::max(topLeftTile.x, chunkOrigin.x);
+			int y1 = std::max(topLeftTile.y, chunkOrigin.y);
+			int x2 = std::min(bottomRightTile.x, chunkOrigin.x + TERRAINCACHE_CHUNKSIZE - 1);
+			int y2 = std::min(bottomRightTile.y, chunkOrigin.y + TERRAINCACHE_CHUNKSIZE - 1);
+
+			SDL_Rect source = { (Sint16) ((x1 - chunkOrigin.x)*tileSize), (Sint16) ((y1 - chunkOrigin.y)*tileSize), (Uint16) ((x2 - x1 + 1)*tileSize), (Uint16) ((y2 - y1 + 1)*tileSize) };
+			SDL_Rect dest = { (Sint16) screenborder->world2screenX(x1*TILESIZE), (Sint16) screenborder->world2screenY(y1*TILESIZE), source.w, source.h };
+			SDL_BlitSurface(chunk.pSurface, &source, pScreen, &dest);
+		}
+	}
+}
+
+void TerrainCache::createChunk(Chunk& chunk, int chunkX, int chunkY) {
+	if(numCachedChunks >= TERRAINCACHE_MAXCHUNKS) {
+		freeLeastRecentlyUsedChunk();
+	}
+
+	Coord chunkOrigin(chunkX*TERRAINCACHE_CHUNKSIZE, chunkY*TERRAINCACHE_CHUNKSIZE);
+	int numTilesX = std::min(TERRAINCACHE_CHUNKSIZE, pMap->getSizeX() - chunkOrigin.x);
+	int numTilesY = std::min(TERRAINCACHE_CHUNKSIZE, pMap->getSizeY() - chunkOrigin.y);
+	int tileSize = world2zoomedWorld(TILESIZE);
+
+	chunk.pSurface = SDL_CreateRGBSurface(SDL_SWSURFACE, numTilesX*tileSize, numTilesY*tileSize, 8, 0, 0, 0, 0);
+	if(chunk.pSurface == NULL) {
+		throw std::runtime_error("TerrainCache::createChunk(): Cannot create surface!");
+	}
+	palette.applyToSurface(chunk.pSurface);
+	SDL_FillRect(chunk.pSurface, NULL, 0);
+
+	chunk.dirtyTiles.clear();
+	chunk.dirtyFlags.assign(TERRAINCACHE_CHUNKSIZE*TERRAINCACHE_CHUNKSIZE, false);
+	numCachedChunks++;
+
+	// include the surrounding tiles as their damage might reach into this chunk
+	drawTiles(chunk.pSurface, chunkOrigin, chunkOrigin.x - 1, chunkOrigin.y - 1, chunkOrigin.x + numTilesX, chunkOrigin.y + numTilesY);
+	numRedrawnTiles += numTilesX*numTilesY;
+}
+
+void TerrainCache::freeChunk(Chunk& chunk) {
+	if(chunk.pSurface != NULL) {
+		SDL_FreeSurface(chunk.pSurface);
+		chunk.pSurface = NULL;
+		numCachedChunks--;
+	}
+	chunk.dirtyTiles.clear();
+	chunk.dirtyFlags.clear();
+}
+
+void TerrainCache::freeLeastRecentlyUsedChunk() {
+	Chunk* pOldestChunk = NULL;
+	for(std::vector<Chunk>::iterator iter = chunks.begin(); iter != chunks.end(); ++iter) {
+		if((iter->pSurface != NULL) && (iter->lastUsedFrame != frameCounter)
+			&& ((pOldestChunk == NULL) || (iter->lastUsedFrame < pOldestChunk->lastUsedFrame))) {
+			pOldestChunk = &(*iter);
+		}
+	}
+
+	// if all chunks are visible in this frame we keep them
+	if(pOldestChunk != NULL) {
+		freeChunk(*pOldestChunk);
+	}
+}
+
+void TerrainCache::drawTiles(SDL_Surface* pSurface, const Coord& chunkOrigin, int x1, int y1, int x2, int y2) {
+	int tileSize = world2zoomedWorld(TILESIZE);
+	int houseID = pLocalHouse->getHouseID();
+
+	for(int y = y1; y <= y2; y++) {
+		for(int x = x1; x <= x2; x++) {
+			if(!pMap->tileExists(x, y)) {
+				continue;
+			}
+
+			// unexplored tiles stay black
+			Tile* pTile = pMap->getTile(x, y);
+			if(pTile->isExplored(houseID)) {
+				pTile->blitGround(pSurface, (x - chunkOrigin.x)*tileSize, (y - chunkOrigin.y)*tileSize);
+			}
+		}
+	}
+}
@@ -42,8 +42,13 @@ Tile::Tile() {
 	for(int i = 0; i < NUM_HOUSES; i++) {
 		explored[i] = currentGame->getGameInitSettings().getGameOptions().startWithExploredMap;
 		lastAccess[i] = 0;
+		fogTimedOut[i] = false;
+		hideTile[i] = INVALID;
+		fogTile[i] = INVALID;
 	}
 
+	terrainTile = INVALID;
+
 	fogColor = COLOR_BLACK;
 
 	owner = INVALID;
@@ -59,6 +64,8 @@ Tile::Tile() {
 
 	location.x = 0;
 	location.y = 0;
+	bActive = false;
+	bRadarDirty = false;
 
 	destroyedStructureTile = DestroyedStructure_None;
 }
@@ -79,8 +86,12 @@ void Tile::load(InputStream& stream) {
         if(bLastAccess[i] == true) {
             lastAccess[i] = stream.readUint32();
         }
+        hideTile[i] = INVALID;
+        fogTile[i] = INVALID;
 	}
 
+	terrainTile = INVALID;
+
 	fogColor = stream.readUint32();
 
 	owner = stream.readSint32();
@@ -221,10 +232,12 @@ void Tile::save(OutputStream& stream) const {
 
 void Tile::assignAirUnit(Uint32 newObjectID) {
 	assignedAirUnitList.push_back(newObjectID);
+	currentGameMap->addToObjectTileIndex(newObjectID, location);
 }
 
 void Tile::assignNonInfantryGroundObject(Uint32 newObjectID) {
 	assignedNonInfantryGroundObjectList.push_back(newObjectID);
+	currentGameMap->addToObjectTileIndex(newObjectID, location);
 }
 
 int Tile::assignInfantry(Uint32 newObjectID, Sint8 currentPosition) {
@@ -260,57 +273,56 @@ int Tile::assignInfantry(Uint32 newObjectID, Sint8 currentPosition) {
 	}
 
 	assignedInfantryList.push_back(newObjectID);
+	currentGameMap->addToObjectTileIndex(newObjectID, location);
 	return i;
 }
 
 
 void Tile::assignUndergroundUnit(Uint32 newObjectID) {
 	assignedUndergroundUnitList.push_back(newObjectID);
+	currentGameMap->addToObjectTileIndex(newObjectID, location);
 }
 
-void Tile::blitGround(int xPos, int yPos) {
+void Tile::blitGround(SDL_Surface* pSurface, int xPos, int yPos) {
 	SDL_Rect	source = { getTerrainTile()*world2zoomedWorld(TILESIZE), 0, world2zoomedWorld(TILESIZE), world2zoomedWorld(TILESIZE) };
 	SDL_Rect    drawLocation = { xPos, yPos, world2zoomedWorld(TILESIZE), world2zoomedWorld(TILESIZE) };
 
-	if((hasANonInfantryGroundObject() == false) || (getNonInfantryGroundObject()->isAStructure() == false)) {
-
-		//draw terrain
-		if(destroyedStructureTile == DestroyedStructure_None || destroyedStructureTile == DestroyedStructure_Wall) {
-            SDL_BlitSurface(sprite[currentZoomlevel], &source, screen, &drawLocation);
-		}
-
-		if(destroyedStructureTile != DestroyedStructure_None) {
-		    SDL_Surface** pDestroyedStructureSurface = pGFXManager->getObjPic(ObjPic_DestroyedStructure);
-		    SDL_Rect source2 = { destroyedStructureTile*world2zoomedWorld(TILESIZE), 0, world2zoomedWorld(TILESIZE), world2zoomedWorld(TILESIZE) };
-            SDL_BlitSurface(pDestroyedStructureSurface[currentZoomlevel], &source2, screen, &drawLocation);
-		}
+	// the ground below structures is drawn as well, so the cache does not depend on structures being placed or removed
+	//draw terrain
+	if(destroyedStructureTile == DestroyedStructure_None || destroyedStructureTile == DestroyedStructure_Wall) {
+        SDL_BlitSurface(sprite[currentZoomlevel], &source, pSurface, &drawLocation);
+	}
 
-		if(!isFogged(pLocalHouse->getHouseID())) {
-		    // tracks
-		    for(int i=0;i<NUM_ANGLES;i++) {
-                if(tracksCounter[i] > 0) {
-                    source.x = ((10-i)%8)*world2zoomedWorld(TILESIZE);
-                    SDL_BlitSurface(pGFXManager->getObjPic(ObjPic_Terrain_Tracks)[currentZoomlevel], &source, screen, &drawLocation);
-                }
-		    }
+	if(destroyedStructureTile != DestroyedStructure_None) {
+	    SDL_Surface** pDestroyedStructureSurface = pGFXManager->getObjPic(ObjPic_DestroyedStructure);
+	    SDL_Rect source2 = { destroyedStructureTile*world2zoomedWorld(TILESIZE), 0, world2zoomedWorld(TILESIZE), world2zoomedWorld(TILESIZE) };
+        SDL_BlitSurface(pDestroyedStructureSurface[currentZoomlevel], &source2, pSurface, &drawLocation);
+	}
 
-            // damage
-		    for(std::vector<DAMAGETYPE>::const_iterator iter = damage.begin(); iter != damage.end(); ++iter) {
-                source.x = iter->tile*world2zoomedWorld(TILESIZE);
-                SDL_Rect dest = {   screenborder->world2screenX(iter->realPos.x) - world2zoomedWorld(TILESIZE)/2,
-                                    screenborder->world2screenY(iter->realPos.y) - world2zoomedWorld(TILESIZE)/2,
-                                    world2zoomedWorld(TILESIZE),
-                                    world2zoomedWorld(TILESIZE) };
+	if(!isFogged(pLocalHouse->getHouseID())) {
+	    // tracks
+	    for(int i=0;i<NUM_ANGLES;i++) {
+            if(tracksCounter[i] > 0) {
+                source.x = ((10-i)%8)*world2zoomedWorld(TILESIZE);
+                SDL_BlitSurface(pGFXManager->getObjPic(ObjPic_Terrain_Tracks)[currentZoomlevel], &source, pSurface, &drawLocation);
+            }
+	    }
 
-                if(iter->damageType == Terrain_RockDamage) {
-                    SDL_BlitSurface(pGFXManager->getObjPic(ObjPic_RockDamage)[currentZoomlevel], &source, screen, &dest);
-                } else {
-                    SDL_BlitSurface(pGFXManager->getObjPic(ObjPic_SandDamage)[currentZoomlevel], &source, screen, &drawLocation);
-                }
-		    }
-		}
+        // damage
+	    for(std::vector<DAMAGETYPE>::const_iterator iter = damage.begin(); iter != damage.end(); ++iter) {
+            source.x = iter->tile*world2zoomedWorld(TILESIZE);
+            SDL_Rect dest = {   xPos + world2zoomedWorld(iter->realPos.x - location.x*TILESIZE) - world2zoomedWorld(TILESIZE)/2,
+                                yPos + world2zoomedWorld(iter->realPos.y - location.y*TILESIZE) - world2zoomedWorld(TILESIZE)/2,
+                                world2zoomedWorld(TILESIZE),
+                                world2zoomedWorld(TILESIZE) };
+
+            if(iter->damageType == Terrain_RockDamage) {
+                SDL_BlitSurface(pGFXManager->getObjPic(ObjPic_RockDamage)[currentZoomlevel], &source, pSurface, &dest);
+            } else {
+                SDL_BlitSurface(pGFXManager->getObjPic(ObjPic_SandDamage)[currentZoomlevel], &source, pSurface, &drawLocation);
+            }
+	    }
 	}
-
 }
 
 void Tile::blitStructures(int xPos, int yPos) {
@@ -480,41 +492,7 @@ void Tile::drawLight(Uint32 color) {
 		SDL_Rect drawLocation = {   x, y,
 									zoomedTileSize, zoomedTileSize };
 
-		SDL_Rect mini = {0, 0, 1, 1};
-
-		SDL_Rect drawLoc = {drawLocation.x, drawLocation.y, 0, 0};
-		SDL_Surface** hiddenSurf = pGFXManager->getObjPic(ObjPic_Terrain_Hidden);
-
-		SDL_Surface* fogSurf = pGFXManager->getTransparent150Surface();
-
-		if(!SDL_MUSTLOCK(screen) || (SDL_LockSurface(screen) == 0)) {
-			SDL_LockSurface(hiddenSurf[currentZoomlevel]);
-
-		for(int i=0;i<zoomedTileSize; i++) {
-			for(int j=0;j<zoomedTileSize; j++) {
-				if(getPixel(hiddenSurf[currentZoomlevel],source.x+i,source.y+j) == 12 ) {
-					drawLoc.x = drawLocation.x + i;
-					drawLoc.y = drawLocation.y + j;
-					//fogSurf = mapSurfaceColorRange(fogSurf, 12, color);
-					SDL_BlitSurface(fogSurf,&mini,screen,&drawLoc);
-				}
-			}
-		}
-
-				//SDL_BlitSurface(fogSurf,&source2,screen,&drawLoc);
-
-
-
-			SDL_UnlockSurface(hiddenSurf[currentZoomlevel]);
-		}
-
-
-		if(SDL_MUSTLOCK(screen)) {
-			SDL_UnlockSurface(screen);
-		}
-
-
-
+		SDL_BlitSurface(pGFXManager->getFog150Mask(currentZoomlevel), &source, screen, &drawLocation);
 }
 
 void Tile::drawOverlay(ObjectBase* obj, Uint32 color, Tile* tile) {
@@ -548,97 +526,7 @@ void Tile::drawOverlay(ObjectBase* obj, Uint32 color, Tile* tile) {
 	SDL_Rect drawLocation = {   x, y,
 								zoomedTileSize, zoomedTileSize };
 
-	SDL_Rect mini = {0, 0, 1, 1};
-
-
-	/*
-	SDL_Rect source2 ;
-
-	if (obj->isAUnit())
-		source2 = { obj->getDrawnAngle() * obj->getGraphic()[currentZoomlevel]->w/obj->getNumImagesX(), 0, world2zoomedWorld(TILESIZE), world2zoomedWorld(TILESIZE)};
-	else
-		source2 = { 0, 0, world2zoomedWorld(TILESIZE), world2zoomedWorld(TILESIZE)};
-	*/
-
-	SDL_Rect drawLoc = {drawLocation.x, drawLocation.y, 0, 0};
-
-
-
-
-
-	int objcolor;
-
-	if (obj != NULL) {
-		switch ((obj->getOwner())->getHouseID())
-		{
-			case HOUSE_HARKONNEN:
-				objcolor = COLOR_HARKONNEN;
-				break;
-			case HOUSE_ATREIDES:
-				objcolor = COLOR_ATREIDES;
-				break;
-			case HOUSE_ORDOS:
-				objcolor = COLOR_ORDOS;
-				break;
-			case HOUSE_FREMEN:
-				objcolor = COLOR_FREMEN;
-				break;
-			case HOUSE_SARDAUKAR:
-				objcolor = COLOR_SARDAUKAR;
-				break;
-			case HOUSE_MERCENARY:
-				objcolor = COLOR_MERCENARY;
-				break;
-			default:
-				objcolor = 12;
-				break;
-		}
-	}
-
-	color = COLOR_LIGHTRED;
-	SDL_Surface** hiddenSurf = pGFXManager->getObjPic(ObjPic_Terrain_Hidden);
-
-	SDL_Surface* fogSurf = // obj->getGraphic()[currentZoomlevel] ;
-			pGFXManager->getTransparent150Surface();
-
-				//mapSurfaceColorRange(obj->getGraphic()[currentZoomlevel],objcolor, color);
-
-
-	//mapSurfaceColorRange(resolveItemPicture(obj->getItemID(),(HOUSETYPE)(obj->getOwner())->getHouseID()),objcolor , color);
-
-
-
-   // fogSurf = mapSurfaceColorRange(fogSurf, objcolor, color);
-  //  replaceColor(*hiddenSurf, objcolor, objcolor << 8);
-
-
-	if(!SDL_MUSTLOCK(screen) || (SDL_LockSurface(screen) == 0)) {
-		SDL_LockSurface(hiddenSurf[currentZoomlevel]);
-
-	for(int i=0;i<zoomedTileSize; i++) {
-		for(int j=0;j<zoomedTileSize; j++) {
-			if(getPixel(hiddenSurf[currentZoomlevel],source.x+i,source.y+j) == 12 ) {
-				drawLoc.x = drawLocation.x + i;
-				drawLoc.y = drawLocation.y + j;
-				//fogSurf = mapSurfaceColorRange(fogSurf, 12, color);
-				SDL_BlitSurface(fogSurf,&mini,screen,&drawLoc);
-			}
-		}
-	}
-
-			//SDL_BlitSurface(fogSurf,&source2,screen,&drawLoc);
-
-
-
-		SDL_UnlockSurface(hiddenSurf[currentZoomlevel]);
-	}
-
-
-	if(SDL_MUSTLOCK(screen)) {
-		SDL_UnlockSurface(screen);
-	}
-
-
+	SDL_BlitSurface(pGFXManager->getFog150Mask(currentZoomlevel), &source, screen, &drawLocation);
 }
 
 void Tile::drawRallyPoint(ObjectBase* obj, Uint32 color, Coord size) {
@@ -820,11 +708,46 @@ void Tile::blitSelectionRects(int xPos, int yPos) {
 }
 
 
+void Tile::activate() {
+	if(!bActive) {
+		currentGameMap->activateTile(this);
+	}
+}
+
 void Tile::clearTerrain() {
+    if(!damage.empty()) {
+        // rock damage reaches into the neighbour tiles
+        currentGameMap->markTerrainDirty(location, 1);
+    }
+
     damage.clear();
     deadUnits.clear();
 }
 
+void Tile::addDamage(Uint32 damageType, int tile, Coord realPos) {
+    if(damage.size() < DAMAGE_PER_TILE) {
+        DAMAGETYPE newDamage;
+        newDamage.tile = tile;
+        newDamage.damageType = damageType;
+        newDamage.realPos = realPos;
+
+        damage.push_back(newDamage);
+
+        currentGameMap->markTerrainDirty(location, (damageType == Terrain_RockDamage) ? 1 : 0);
+    }
+}
+
+void Tile::setDestroyedStructureTile(int newDestroyedStructureTile) {
+    if(destroyedStructureTile != newDestroyedStructureTile) {
+        destroyedStructureTile = newDestroyedStructureTile;
+        markTerrainDirty();
+    }
+}
+
+void Tile::markTerrainDirty() {
+    currentGameMap->markTerrainDirty(location);
+}
+
 
 void Tile::selectAllPlayersUnits(int houseID, ObjectBase** lastCheckedObject, ObjectBase** lastSelectedObject, ObjectBase* groupLeader) {
 	ConcatIterator<Uint32> iterator;
@@ -947,20 +870,29 @@ void Tile::selectAllPlayersUnitsOfType(int houseID, ObjectBase* lastSinglySelect
 
 
 void Tile::unassignAirUnit(Uint32 objectID) {
-	assignedAirUnitList.remove(objectID);
+	removeFromList(assignedAirUnitList, objectID);
 }
 
 
 void Tile::unassignNonInfantryGroundObject(Uint32 objectID) {
-	assignedNonInfantryGroundObjectList.remove(objectID);
+	removeFromList(assignedNonInfantryGroundObjectList, objectID);
 }
 
 void Tile::unassignUndergroundUnit(Uint32 objectID) {
-	assignedUndergroundUnitList.remove(objectID);
+	removeFromList(assignedUndergroundUnitList, objectID);
 }
 
 void Tile::unassignInfantry(Uint32 objectID, int currentPosition) {
-	assignedInfantryList.remove(objectID);
+	removeFromList(assignedInfantryList, objectID);
+}
+
+void Tile::removeFromList(std::list<Uint32>& objectList, Uint32 objectID) {
+	size_t oldSize = objectList.size();
+	objectList.remove(objectID);
+
+	for(size_t i = objectList.size(); i < oldSize; i++) {
+		currentGameMap->removeFromObjectTileIndex(objectID, location);
+	}
 }
 
 void Tile::unassignObject(Uint32 objectID) {
@@ -972,6 +904,10 @@ void Tile::unassignObject(Uint32 objectID) {
 
 
 void Tile::setType(int newType, bool resetSpice) {
+	bool bWasMountain = isMountain();
+	bool bWasRock = isRock();
+	Uint32 oldType = type;
+
 	type = newType;
 	destroyedStructureTile = DestroyedStructure_None;
 
@@ -1035,6 +971,16 @@ void Tile::setType(int newType, bool resetSpice) {
 		}
 	}
 
+	if((bWasMountain != isMountain()) || (bWasRock != isRock())) {
+		currentGameMap->tilePassabilityChanged(location);
+	} else if(type != oldType) {
+		// the terrain difficulty changed
+		currentGameMap->getFlowFieldCache().clear();
+	}
+
+	currentGameMap->invalidateTerrainTiles(location);
+	currentGameMap->markRadarDirty(location);
+
 	for (int i=location.x; i <= location.x+3; i++) {
 		for (int j=location.y; j <= location.y+3; j++) {
 			if (currentGameMap->tileExists(i, j)) {
@@ -1119,6 +1065,8 @@ float Tile::harvestSpice(float extractionspeed) {
 
 
 void Tile::setSpice(float newSpice) {
+	Uint32 oldType = type;
+
 	if(newSpice <= 0.0f) {
 		type = Terrain_Sand;
 	} else if(newSpice >= RANDOMTHICKSPICEMIN) {
@@ -1127,6 +1075,14 @@ void Tile::setSpice(float newSpice) {
 		type = Terrain_Spice;
 	}
 	spice = newSpice;
+
+	if(type != oldType) {
+		// the terrain difficulty changed
+		currentGameMap->getFlowFieldCache().clear();
+	}
+
+	currentGameMap->invalidateTerrainTiles(location);
+	currentGameMap->markRadarDirty(location);
 }
 
 
@@ -1361,7 +1317,7 @@ bool Tile::isFogged(int houseID) {
 
 	if(currentGame->getGameInitSettings().getGameOptions().fogOfWar == false) {
 		return false;
-	} else if((currentGame->getGameCycleCount() - lastAccess[houseID]) >= MILLI2CYCLES(10*1000)) {
+	} else if((currentGame->getGameCycleCount() - lastAccess[houseID]) >= FOGTIMEOUT) {
 		// TODO : shroud regain should be made an option
 		return true;
 	} else {
@@ -1419,7 +1375,7 @@ Uint32 Tile::getRadarColor(House* pHouse, bool radar) {
 	}
 }
 
-int Tile::getTerrainTile() const {
+int Tile::computeTerrainTile() const {
     switch(type) {
         case Terrain_Slab: {
             return TerrainTile_Slab;
@@ -1493,7 +1449,7 @@ int Tile::getTerrainTile() const {
     }
 }
 
-int Tile::getHideTile(int houseID) const {
+int Tile::computeHideTile(int houseID) const {
 
     // are all surounding tiles explored?
     if( ((currentGameMap->tileExists(location.x,location.y-1) == false) || (currentGameMap->getTile(location.x, location.y-1)->isExplored(houseID) == true))
@@ -1512,25 +1468,82 @@ int Tile::getHideTile(int houseID) const {
     return (up | (right << 1) | (down << 2) | (left << 3));
 }
 
-int Tile::getFogTile(int houseID) const {
+int Tile::computeFogTile(int houseID) const {
+
+    //determine what tiles are fogged
+    bool up = (currentGameMap->tileExists(location.x,location.y-1) == false) || currentGameMap->getTile(location.x, location.y-1)->fogTimedOut[houseID];
+    bool right = (currentGameMap->tileExists(location.x+1,location.y) == false) || currentGameMap->getTile(location.x+1, location.y)->fogTimedOut[houseID];
+    bool down = (currentGameMap->tileExists(location.x,location.y+1) == false) || currentGameMap->getTile(location.x, location.y+1)->fogTimedOut[houseID];
+    bool left = (currentGameMap->tileExists(location.x-1,location.y) == false) || currentGameMap->getTile(location.x-1, location.y)->fogTimedOut[houseID];
 
-    // are all surounding tiles fogged?
-    if( ((currentGameMap->tileExists(location.x,location.y-1) == false) || (currentGameMap->getTile(location.x, location.y-1)->isFogged(houseID) == false))
-        && ((currentGameMap->tileExists(location.x+1,location.y) == false) || (currentGameMap->getTile(location.x+1, location.y)->isFogged(houseID) == false))
-        && ((currentGameMap->tileExists(location.x,location.y+1) == false) || (currentGameMap->getTile(location.x, location.y+1)->isFogged(houseID) == false))
-        && ((currentGameMap->tileExists(location.x-1,location.y) == false) || (currentGameMap->getTile(location.x-1, location.y)->isFogged(houseID) == false))) {
+    // are all surounding tiles not fogged?
+    if(!up && !right && !down && !left) {
         return 0;
     }
 
-    //determine what tiles are fogged
-    bool up = (currentGameMap->tileExists(location.x,location.y-1) == false) || (currentGameMap->getTile(location.x, location.y-1)->isFogged(houseID) == true);
-    bool right = (currentGameMap->tileExists(location.x+1,location.y) == false) || (currentGameMap->getTile(location.x+1, location.y)->isFogged(houseID) == true);
-    bool down = (currentGameMap->tileExists(location.x,location.y+1) == false) || (currentGameMap->getTile(location.x, location.y+1)->isFogged(houseID) == true);
-    bool left = (currentGameMap->tileExists(location.x-1,location.y) == false) || (currentGameMap->getTile(location.x-1, location.y)->isFogged(houseID) == true);
-
     return (up | (right << 1) | (down << 2) | (left << 3));
 }
 
+int Tile::getTerrainTile() const {
+    if(terrainTile == INVALID) {
+        terrainTile = computeTerrainTile();
+    }
+    return terrainTile;
+}
+
+int Tile::getHideTile(int houseID) const {
+    if(hideTile[houseID] == INVALID) {
+        hideTile[houseID] = computeHideTile(houseID);
+    }
+    return hideTile[houseID];
+}
+
+int Tile::getFogTile(int houseID) const {
+    if(debug) {
+        return 0;
+    }
+
+    // the fog timeouts are only tracked if fog of war is enabled, otherwise no tile is ever fogged
+    if(fogTile[houseID] == INVALID) {
+        fogTile[houseID] = computeFogTile(houseID);
+    }
+    return fogTile[houseID];
+}
+
+void Tile::exploredStateChanged(int houseID) {
+    if((pLocalHouse != NULL) && (houseID == pLocalHouse->getHouseID())) {
+        currentGameMap->markRadarDirty(location);
+        currentGameMap->markTerrainDirty(location);
+    }
+
+    if(explored[houseID] == false) {
+        explored[houseID] = true;
+        currentGameMap->invalidateHideTiles(location, houseID);
+    }
+
+    if(fogTimedOut[houseID] == true) {
+        fogTimedOut[houseID] = false;
+        currentGameMap->invalidateFogTiles(location, houseID);
+        currentGameMap->addFogTimeout(this, houseID);
+    }
+}
+
+bool Tile::updateFogTimeout(int houseID, Uint32 cycle) {
+    if((cycle - lastAccess[houseID]) < FOGTIMEOUT) {
+        return false;
+    }
+
+    if(fogTimedOut[houseID] == false) {
+        fogTimedOut[houseID] = true;
+        currentGameMap->invalidateFogTiles(location, houseID);
+        if((pLocalHouse != NULL) && (houseID == pLocalHouse->getHouseID())) {
+            currentGameMap->markRadarDirty(location);
+            currentGameMap->markTerrainDirty(location);
+        }
+    }
+    return true;
+}
+
 
 Coord Tile::getUnpreciseCenterPoint() const {
 
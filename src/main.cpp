@@ -43,6 +43,7 @@
 #include <misc/string_util.h>
 
 #include <SoundPlayer.h>
+#include <sand.h>
 
 #include <mmath.h>
 
@@ -74,7 +75,7 @@ void setVideoMode();
 void realign_buttons();
 
 void printUsage() {
-    fprintf(stderr, "Usage:\n\tdunelegacy [--showlog] [--fullscreen|--window] [--PlayerName=X] [--ServerPort=X]\n");
+    fprintf(stderr, "Usage:\n\tdunelegacy [--showlog] [--fullscreen|--window] [--PlayerName=X] [--ServerPort=X] [--Pathfinding=AStar|HPA] [--headless --replay file.rpl [--bench] [--checkreplay]]\n");
 }
 
 void setVideoMode()
@@ -147,6 +148,8 @@ void createDefaultConfigFile(std::string configfilepath, std::string language) {
 
 	const char configfile[] =	"[General]\n"
 								"Play Intro = false\t\t\t# Play the intro when starting the game?\n"
+								"Compress Save Games = true\t\t# Compress save games and replays?\n"
+								"Autosave Interval = 5\t\t\t# Minutes between two autosaves (0 = no autosave)\n"
 								"Player Name = %s\t\t\t# The name of the player\n"
 								"Language = %s\t\t\t\t# en = English, fr = French, de = German\n"
 								"\n"
@@ -192,7 +195,9 @@ void createDefaultConfigFile(std::string configfilepath, std::string language) {
                                 "Sandworms Respawn = false\t\t\t\t#If true, killed sandworms respawn after some time\n"
 								"Killed Sandworms Drop Spice = false \t\t\t#If true, killed sandworms drop some spice\n"
 								"Day Night Cycle = false \t\t\t#If true, game will cycle day and night\n"
-								"Day Night Scale = 10 \t\t\t#If DayNight Cycle is true, pick between 9 and 15, the greater make day longer\n";
+								"Day Night Scale = 10 \t\t\t#If DayNight Cycle is true, pick between 9 and 15, the greater make day longer\n"
+								"Hierarchical Pathfinding = false \t\t#If true, long unit paths are searched with hierarchical A* (HPA*)\n"
+								"Flow Field Pathfinding = false \t\t#If true, units moving to the same destination share one flow field\n";
 
     char playername[MAX_PLAYERNAMELENGHT+1] = "Player";
 
@@ -338,6 +343,7 @@ int main(int argc, char *argv[]) {
 	}
 
 	bool bShowDebug = false;
+	std::string headlessReplay;
     for(int i=1; i < argc; i++) {
 	    //check for overiding params
 	    std::string parameter(argv[i]);
@@ -348,13 +354,32 @@ int main(int argc, char *argv[]) {
 		} else if((parameter == "-f") || (parameter == "--fullscreen") || (parameter == "-w") || (parameter == "--window") || (parameter.find("--PlayerName=") == 0) || (parameter.find("--ServerPort=") == 0)) {
             // normal parameter for overwriting settings
             // handle later
+        } else if(parameter == "--Pathfinding=AStar") {
+            // pathfinding used for replays, e.g. to compare A* and HPA* on the same replay
+            replayPathfinding = 1;
+        } else if(parameter == "--Pathfinding=HPA") {
+            replayPathfinding = 2;
+        } else if(parameter == "--headless") {
+            bHeadless = true;
+        } else if(parameter == "--bench") {
+            bBenchmark = true;
+        } else if(parameter == "--checkreplay") {
+            bCheckReplay = true;
+        } else if((parameter == "--replay") && (i+1 < argc)) {
+            headlessReplay = argv[++i];
         } else {
             printUsage();
             exit(EXIT_FAILURE);
 		}
 	}
 
-	if(bShowDebug == false) {
+	if((bHeadless && headlessReplay.empty()) || (bBenchmark && !bHeadless) || (bCheckReplay && !bHeadless)) {
+        // a headless game can only run a replay
+        printUsage();
+        exit(EXIT_FAILURE);
+	}
+
+	if(bShowDebug == false && bHeadless == false) {
 	    // get utf8-encoded log file path
 	    std::string logfilePath = getLogFilepath();
 	    const char* pLogfilePath = logfilePath.c_str();
@@ -463,6 +488,8 @@ int main(int argc, char *argv[]) {
 		INIFile myINIFile(configfilepath);
 
 		settings.general.playIntro = myINIFile.getBoolValue("General","Play Intro",false);
+		settings.general.compressSaveGames = myINIFile.getBoolValue("General","Compress Save Games",true);
+		settings.general.autosaveInterval = myINIFile.getIntValue("General","Autosave Interval",5);
 		settings.general.playerName = myINIFile.getStringValue("General","Player Name","Player");
 		settings.video.width = myINIFile.getIntValue("Video","Width",640);
 		settings.video.height = myINIFile.getIntValue("Video","Height",480);
@@ -496,6 +523,8 @@ int main(int argc, char *argv[]) {
         settings.gameOptions.killedSandwormsDropSpice = myINIFile.getBoolValue("Game Options","Killed Sandworms Drop Spice",false);
         settings.gameOptions.daynight = myINIFile.getBoolValue("Game Options","Day Night Cycle",false);
         settings.gameOptions.dayscale = (Uint8)myINIFile.getIntValue("Game Options","Day Night Scale",false);
+        settings.gameOptions.hierarchicalPathfinding = myINIFile.getBoolValue("Game Options","Hierarchical Pathfinding",false);
+        settings.gameOptions.flowFieldPathfinding = myINIFile.getBoolValue("Game Options","Flow Field Pathfinding",false);
 
         fprintf(stdout, "loading texts....."); fflush(stdout);
         pTextManager = new TextManager();
@@ -517,7 +546,10 @@ int main(int argc, char *argv[]) {
 		    //check for overiding params
             std::string parameter(argv[i]);
 
-			if((parameter == "-f") || (parameter == "--fullscreen")) {
+			if(parameter == "--replay") {
+                // skip the replay filename
+                i++;
+            } else if((parameter == "-f") || (parameter == "--fullscreen")) {
 				settings.video.fullscreen = true;
 			} else if((parameter == "-w") || (parameter == "--window")) {
 				settings.video.fullscreen = false;
@@ -528,6 +560,19 @@ int main(int argc, char *argv[]) {
             }
 		}
 
+        if(bHeadless == true) {
+            // nothing is shown or played, so use SDL's dummy drivers
+            static char videoDriverEnv[] = "SDL_VIDEODRIVER=dummy";
+            static char audioDriverEnv[] = "SDL_AUDIODRIVER=dummy";
+            SDL_putenv(videoDriverEnv);
+            SDL_putenv(audioDriverEnv);
+
+            settings.general.playIntro = false;
+            settings.video.fullscreen = false;
+            settings.audio.playMusic = false;
+            settings.audio.playSFX = false;
+        }
+
         if(bFirstInit == true) {
             fprintf(stdout, "initializing SDL..... \t\t"); fflush(stdout);
             if(SDL_Init(SDL_INIT_TIMER | SDL_INIT_VIDEO) < 0) {
@@ -641,7 +686,7 @@ int main(int argc, char *argv[]) {
             }
 
             // Playing intro
-            if(((bFirstGamestart == true) || (settings.general.playIntro == true)) && (bFirstInit==true)) {
+            if(((bFirstGamestart == true) || (settings.general.playIntro == true)) && (bFirstInit==true) && (bHeadless==false)) {
                 fprintf(stdout, "playing intro.....");fflush(stdout);
                 Intro* pIntro = new Intro();
                 pIntro->run();
@@ -651,13 +696,18 @@ int main(int argc, char *argv[]) {
 
             bFirstInit = false;
 
-            fprintf(stdout, "starting main menu...");fflush(stdout);
-            MainMenu * myMenu = new MainMenu();
-            fprintf(stdout, "\t\tfinished\n"); fflush(stdout);
-            if(myMenu->showMenu() == MENU_QUIT_DEFAULT) {
+            if(bHeadless == true) {
+                startReplay(headlessReplay);
                 bExitGame = true;
+            } else {
+                fprintf(stdout, "starting main menu...");fflush(stdout);
+                MainMenu * myMenu = new MainMenu();
+                fprintf(stdout, "\t\tfinished\n"); fflush(stdout);
+                if(myMenu->showMenu() == MENU_QUIT_DEFAULT) {
+                    bExitGame = true;
+                }
+                delete myMenu;
             }
-            delete myMenu;
 
             fprintf(stdout, "Deinitialize....."); fflush(stdout);
 
@@ -0,0 +1,207 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/Compression.h>
+
+#include <string.h>
+
+#define MINMATCH        4               ///< the shortest match that is encoded as a match
+#define MAXOFFSET       65535           ///< the farthest a match may reach back
+#define LASTLITERALS    5               ///< the last bytes of a block are always literals
+#define MFLIMIT         12              ///< no match may start in the last MFLIMIT bytes
+#define HASHLOG         12              ///< log2 of the number of entries in the hash table
+
+static inline Uint32 read32(const Uint8* p) {
+    Uint32 x;
+    memcpy(&x, p, sizeof(Uint32));
+    return x;
+}
+
+static inline Uint32 hash32(Uint32 sequence) {
+    return (sequence * 2654435761U) >> (32 - HASHLOG);
+}
+
+/**
+    Writes one sequence (literals followed by a match). If matchLength is 0 only the literals are written.
+    \return the new write position or NULL if pDst is too small
+*/
+static Uint8* writeSequence(Uint8* pDst, Uint8* pDstEnd, const Uint8* pLiterals, size_t literalLength, size_t offset, size_t matchLength) {
+    size_t maxLength = 1 + literalLength/255 + 1 + literalLength + 2 + ((matchLength > 0) ? (matchLength/255 + 1) : 0);
+    if((size_t) (pDstEnd - pDst) < maxLength) {
+        return NULL;
+    }
+
+    Uint8* pToken = pDst++;
+
+    if(literalLength >= 15) {
+        *pToken = 15 << 4;
+        size_t length = literalLength - 15;
+        for(; length >= 255; length -= 255) {
+            *pDst++ = 255;
+        }
+        *pDst++ = (Uint8) length;
+    } else {
+        *pToken = (Uint8) (literalLength << 4);
+    }
+
+    memcpy(pDst, pLiterals, literalLength);
+    pDst += literalLength;
+
+    if(matchLength == 0) {
+        return pDst;
+    }
+
+    *pDst++ = (Uint8) (offset & 0xFF);
+    *pDst++ = (Uint8) (offset >> 8);
+
+    size_t length = matchLength - MINMATCH;
+    if(length >= 15) {
+        *pToken |= 15;
+        length -= 15;
+        for(; length >= 255; length -= 255) {
+            *pDst++ = 255;
+        }
+        *pDst++ = (Uint8) length;
+    } else {
+        *pToken |= (Uint8) length;
+    }
+
+    return pDst;
+}
+
+size_t getMaxCompressedSize(size_t srcLength) {
+    return srcLength + srcLength/255 + 16;
+}
+
+size_t compressData(const Uint8* pSrc, size_t srcLength, Uint8* pDst, size_t dstCapacity) {
+    Uint8* pOut = pDst;
+    Uint8* pOutEnd = pDst + dstCapacity;
+
+    size_t anchor = 0;
+
+    if(srcLength > MFLIMIT) {
+        // positions + 1 of the last occurrence of every hash value (0 = none)
+        Uint32 hashTable[1 << HASHLOG];
+        memset(hashTable, 0, sizeof(hashTable));
+
+        const size_t matchStartLimit = srcLength - MFLIMIT;
+        const size_t matchEndLimit = srcLength - LASTLITERALS;
+
+        size_t pos = 0;
+        while(pos < matchStartLimit) {
+            Uint32 sequence = read32(pSrc + pos);
+            Uint32 hash = hash32(sequence);
+            size_t candidate = hashTable[hash];
+            hashTable[hash] = (Uint32) (pos + 1);
+
+            if((candidate == 0) || (pos + 1 - candidate > MAXOFFSET) || (read32(pSrc + candidate - 1) != sequence)) {
+                pos++;
+                continue;
+            }
+
+            size_t matchPos = candidate - 1;
+            size_t matchLength = MINMATCH;
+            while((pos + matchLength < matchEndLimit) && (pSrc[matchPos + matchLength] == pSrc[pos + matchLength])) {
+                matchLength++;
+            }
+
+            pOut = writeSequence(pOut, pOutEnd, pSrc + anchor, pos - anchor, pos - matchPos, matchLength);
+            if(pOut == NULL) {
+                return 0;
+            }
+
+            pos += matchLength;
+            anchor = pos;
+        }
+    }
+
+    pOut = writeSequence(pOut, pOutEnd, pSrc + anchor, srcLength - anchor, 0, 0);
+    if(pOut == NULL) {
+        return 0;
+    }
+
+    return pOut - pDst;
+}
+
+bool decompressData(const Uint8* pSrc, size_t srcLength, Uint8* pDst, size_t dstLength) {
+    size_t inPos = 0;
+    size_t outPos = 0;
+
+    while(inPos < srcLength) {
+        Uint8 token = pSrc[inPos++];
+
+        size_t literalLength = token >> 4;
+        if(literalLength == 15) {
+            Uint8 x;
+            do {
+                if(inPos >= srcLength) {
+                    return false;
+                }
+                x = pSrc[inPos++];
+                literalLength += x;
+            } while(x == 255);
+        }
+
+        if((literalLength > srcLength - inPos) || (literalLength > dstLength - outPos)) {
+            return false;
+        }
+        memcpy(pDst + outPos, pSrc + inPos, literalLength);
+        inPos += literalLength;
+        outPos += literalLength;
+
+        if(inPos == srcLength) {
+            // the last sequence has no match
+            break;
+        }
+
+        if(srcLength - inPos < 2) {
+            return false;
+        }
+        size_t offset = pSrc[inPos] | (pSrc[inPos+1] << 8);
+        inPos += 2;
+        if((offset == 0) || (offset > outPos)) {
+            return false;
+        }
+
+        size_t matchLength = token & 15;
+        if(matchLength == 15) {
+            Uint8 x;
+            do {
+                if(inPos >= srcLength) {
+                    return false;
+                }
+                x = pSrc[inPos++];
+                matchLength += x;
+            } while(x == 255);
+        }
+        matchLength += MINMATCH;
+
+        if(matchLength > dstLength - outPos) {
+            return false;
+        }
+
+        // the match may overlap the bytes it produces, so copy byte by byte
+        const Uint8* pMatch = pDst + outPos - offset;
+        Uint8* pOut = pDst + outPos;
+        for(size_t i = 0; i < matchLength; i++) {
+            pOut[i] = pMatch[i];
+        }
+        outPos += matchLength;
+    }
+
+    return (outPos == dstLength);
+}
@@ -0,0 +1,153 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/ICompressedStream.h>
+
+#include <misc/OCompressedStream.h>
+#include <misc/Compression.h>
+
+#include <string.h>
+#include <SDL_endian.h>
+#include <algorithm>
+
+ICompressedStream::ICompressedStream(InputStream* pStream, bool bOwnStream)
+ : pStream(pStream), bOwnStream(bOwnStream), blockPos(0)
+{
+}
+
+ICompressedStream::~ICompressedStream()
+{
+	if(bOwnStream) {
+		delete pStream;
+	}
+}
+
+std::string ICompressedStream::readString()
+{
+	Uint32 length = readUint32();
+
+	if(length == 0) {
+		return "";
+	} else {
+		std::string str;
+		str.resize(length);
+		readBuffered(&str[0], length);
+		return str;
+	}
+}
+
+Uint8 ICompressedStream::readUint8()
+{
+	Uint8 tmp;
+	readBuffered(&tmp, sizeof(Uint8));
+	return tmp;
+}
+
+Uint16 ICompressedStream::readUint16()
+{
+	Uint16 tmp;
+	readBuffered(&tmp, sizeof(Uint16));
+	return SDL_SwapLE16(tmp);
+}
+
+Uint32 ICompressedStream::readUint32()
+{
+	Uint32 tmp;
+	readBuffered(&tmp, sizeof(Uint32));
+	return SDL_SwapLE32(tmp);
+}
+
+Uint64 ICompressedStream::readUint64()
+{
+	Uint64 tmp;
+	readBuffered(&tmp, sizeof(Uint64));
+	return SDL_SwapLE64(tmp);
+}
+
+bool ICompressedStream::readBool()
+{
+	return (readUint8() == 1 ? true : false);
+}
+
+float ICompressedStream::readFloat()
+{
+	Uint32 tmp = readUint32();
+	float tmp2;
+	memcpy(&tmp2,&tmp,sizeof(Uint32)); // workaround for a strange optimization in gcc 4.1
+	return tmp2;
+}
+
+Coord ICompressedStream::readCoord()
+{
+	// same order as IFileStream::readCoord()
+	Sint32 y = readSint32();
+	Sint32 x = readSint32();
+	Coord tmp(x,y);
+	return tmp;
+}
+
+void ICompressedStream::readBuffered(void* pData, size_t length)
+{
+	char* pDest = (char*) pData;
+
+	while(length > 0) {
+		if(blockPos == block.size()) {
+			// throws InputStream::eof at the end of the underlying stream
+			readBlock();
+		}
+
+		size_t n = std::min(length, block.size() - blockPos);
+		memcpy(pDest, block.data() + blockPos, n);
+		blockPos += n;
+		pDest += n;
+		length -= n;
+	}
+}
+
+void ICompressedStream::readBlock()
+{
+	Uint32 length = pStream->readUint32();
+	Uint8 method = pStream->readUint8();
+	std::string data = pStream->readString();
+
+	if((length == 0) || (length > COMPRESSEDSTREAM_BLOCKSIZE)) {
+		throw InputStream::error("ICompressedStream::readBlock(): Invalid block length!");
+	}
+
+	switch(method) {
+		case CompressionMethod_None: {
+			if(data.size() != length) {
+				throw InputStream::error("ICompressedStream::readBlock(): Invalid block length!");
+			}
+			block.swap(data);
+		} break;
+
+		case CompressionMethod_LZ: {
+			block.resize(length);
+			if(decompressData((const Uint8*) data.data(), data.size(), (Uint8*) &block[0], length) == false) {
+				block.clear();
+				throw InputStream::error("ICompressedStream::readBlock(): Corrupt compressed block!");
+			}
+		} break;
+
+		default: {
+			throw InputStream::error("ICompressedStream::readBlock(): Unknown compression method!");
+		} break;
+	}
+
+	blockPos = 0;
+}
@@ -18,6 +18,7 @@
 #include <misc/IFileStream.h>
 
 #include <string.h>
+#include <algorithm>
 #include <SDL_endian.h>
 
 #ifdef _WIN32
@@ -27,18 +28,23 @@
 IFileStream::IFileStream()
 {
 	fp = NULL;
+	bufferPos = 0;
+	bufferFill = 0;
+	pBuffer = (char*) malloc(IFILESTREAM_BUFFERSIZE);
+	if(pBuffer == NULL) {
+		throw InputStream::error("IFileStream::IFileStream(): malloc failed!");
+	}
 }
 
 IFileStream::~IFileStream()
 {
 	close();
+	free(pBuffer);
 }
 
 bool IFileStream::open(const char* filename)
 {
-	if(fp != NULL) {
-		fclose(fp);
-	}
+	close();
 
 	const char* pFilename = filename;
 
@@ -78,6 +84,8 @@ void IFileStream::close()
 		fclose(fp);
 		fp = NULL;
 	}
+	bufferPos = 0;
+	bufferFill = 0;
 }
 
 std::string IFileStream::readString()
@@ -93,13 +101,7 @@ std::string IFileStream::readString()
 
         str.resize(length);
 
-        if(fread(&str[0],length,1,fp) != 1) {
-            if(feof(fp) != 0) {
-                throw InputStream::eof("IFileStream::readString(): End-of-File reached!");
-            } else {
-                throw InputStream::error("IFileStream::readString(): An I/O-Error occurred!");
-            }
-        }
+        readBuffered(&str[0], length, "IFileStream::readString()");
 
         return str;
     }
@@ -108,55 +110,28 @@ std::string IFileStream::readString()
 Uint8 IFileStream::readUint8()
 {
 	Uint8 tmp;
-	if(fread(&tmp,sizeof(Uint8),1,fp) != 1) {
-		if(feof(fp) != 0) {
-			throw InputStream::eof("IFileStream::readUint8(): End-of-File reached!");
-		} else {
-			throw InputStream::error("IFileStream::readUint8(): An I/O-Error occurred!");
-		}
-	}
-
+	readBuffered(&tmp, sizeof(Uint8), "IFileStream::readUint8()");
 	return tmp;
 }
 
 Uint16 IFileStream::readUint16()
 {
 	Uint16 tmp;
-	if(fread(&tmp,sizeof(Uint16),1,fp) != 1) {
-		if(feof(fp) != 0) {
-			throw InputStream::eof("IFileStream::readUint16(): End-of-File reached!");
-		} else {
-			throw InputStream::error("IFileStream::readUint16(): An I/O-Error occurred!");
-		}
-	}
-
+	readBuffered(&tmp, sizeof(Uint16), "IFileStream::readUint16()");
 	return SDL_SwapLE16(tmp);
 }
 
 Uint32 IFileStream::readUint32()
 {
 	Uint32 tmp;
-	if(fread(&tmp,sizeof(Uint32),1,fp) != 1) {
-		if(feof(fp) != 0) {
-			throw InputStream::eof("IFileStream::readUint32(): End-of-File reached!");
-		} else {
-			throw InputStream::error("IFileStream::readUint32(): An I/O-Error occurred!");
-		}
-	}
-
+	readBuffered(&tmp, sizeof(Uint32), "IFileStream::readUint32()");
 	return SDL_SwapLE32(tmp);
 }
 
 Uint64 IFileStream::readUint64()
 {
 	Uint64 tmp;
-	if(fread(&tmp,sizeof(Uint64),1,fp) != 1) {
-		if(feof(fp) != 0) {
-			throw InputStream::eof("IFileStream::readUint64(): End-of-File reached!");
-		} else {
-			throw InputStream::error("IFileStream::readUint64(): An I/O-Error occurred!");
-		}
-	}
+	readBuffered(&tmp, sizeof(Uint64), "IFileStream::readUint64()");
 	return SDL_SwapLE64(tmp);
 }
 
@@ -181,3 +156,27 @@ Coord IFileStream::readCoord()
     return tmp;
 }
 
+void IFileStream::readBuffered(void* pData, size_t length, const char* pFunctionName)
+{
+	char* pDest = (char*) pData;
+
+	while(length > 0) {
+		if(bufferPos == bufferFill) {
+			bufferPos = 0;
+			bufferFill = (fp != NULL) ? fread(pBuffer, 1, IFILESTREAM_BUFFERSIZE, fp) : 0;
+			if(bufferFill == 0) {
+				if((fp == NULL) || (ferror(fp) == 0)) {
+					throw InputStream::eof(std::string(pFunctionName) + ": End-of-File reached!");
+				} else {
+					throw InputStream::error(std::string(pFunctionName) + ": An I/O-Error occurred!");
+				}
+			}
+		}
+
+		size_t n = std::min(length, bufferFill - bufferPos);
+		memcpy(pDest, pBuffer + bufferPos, n);
+		bufferPos += n;
+		pDest += n;
+		length -= n;
+	}
+}
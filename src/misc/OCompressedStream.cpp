@@ -0,0 +1,158 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/OCompressedStream.h>
+
+#include <misc/Compression.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <SDL_endian.h>
+#include <algorithm>
+
+OCompressedStream::OCompressedStream(OutputStream* pStream, bool bCompress, bool bOwnStream)
+ : pStream(pStream), bCompress(bCompress), bOwnStream(bOwnStream), bufferPos(0)
+{
+	pBuffer = (char*) malloc(COMPRESSEDSTREAM_BLOCKSIZE);
+	if(pBuffer == NULL) {
+		throw OutputStream::error("OCompressedStream::OCompressedStream(): malloc failed!");
+	}
+}
+
+OCompressedStream::~OCompressedStream()
+{
+	// we cannot throw in the destructor
+	try {
+		writeBlock();
+		pStream->flush();
+	} catch(OutputStream::exception&) {
+		fprintf(stderr, "OCompressedStream::~OCompressedStream(): An I/O-Error occurred!\n");
+	}
+
+	free(pBuffer);
+
+	if(bOwnStream) {
+		delete pStream;
+	}
+}
+
+void OCompressedStream::flush()
+{
+	writeBlock();
+	pStream->flush();
+}
+
+void OCompressedStream::writeString(const std::string& str)
+{
+	writeUint32(str.length());
+
+	if(!str.empty()) {
+		writeBuffered(str.c_str(), str.length());
+	}
+}
+
+void OCompressedStream::writeUint8(Uint8 x)
+{
+	writeBuffered(&x, sizeof(Uint8));
+}
+
+void OCompressedStream::writeUint16(Uint16 x)
+{
+	x = SDL_SwapLE16(x);
+	writeBuffered(&x, sizeof(Uint16));
+}
+
+void OCompressedStream::writeUint32(Uint32 x)
+{
+	x = SDL_SwapLE32(x);
+	writeBuffered(&x, sizeof(Uint32));
+}
+
+void OCompressedStream::writeUint64(Uint64 x)
+{
+	x = SDL_SwapLE64(x);
+	writeBuffered(&x, sizeof(Uint64));
+}
+
+void OCompressedStream::writeBool(bool x)
+{
+	writeUint8(x == true ? 1 : 0);
+}
+
+void OCompressedStream::writeFloat(float x)
+{
+	Uint32 tmp;
+	memcpy(&tmp,&x,sizeof(Uint32)); // workaround for a strange optimization in gcc 4.1
+	writeUint32(tmp);
+}
+
+void OCompressedStream::writeCoord(Coord c)
+{
+	c.x = SDL_SwapLE32(c.x);
+	c.y = SDL_SwapLE32(c.y);
+
+	writeBuffered(&c.x, sizeof(Uint32));
+	writeBuffered(&c.y, sizeof(Uint32));
+}
+
+void OCompressedStream::writeData(const void* pData, size_t length)
+{
+	writeBuffered(pData, length);
+}
+
+void OCompressedStream::writeBuffered(const void* pData, size_t length)
+{
+	const char* pSrc = (const char*) pData;
+
+	while(length > 0) {
+		size_t n = std::min(length, (size_t) COMPRESSEDSTREAM_BLOCKSIZE - bufferPos);
+		memcpy(pBuffer + bufferPos, pSrc, n);
+		bufferPos += n;
+		pSrc += n;
+		length -= n;
+
+		if(bufferPos == COMPRESSEDSTREAM_BLOCKSIZE) {
+			writeBlock();
+		}
+	}
+}
+
+void OCompressedStream::writeBlock()
+{
+	if(bufferPos == 0) {
+		return;
+	}
+
+	size_t compressedLength = 0;
+	if(bCompress) {
+		compressedBlock.resize(getMaxCompressedSize(bufferPos));
+		compressedLength = compressData((const Uint8*) pBuffer, bufferPos, (Uint8*) &compressedBlock[0], compressedBlock.size());
+	}
+
+	pStream->writeUint32(bufferPos);
+	if((compressedLength > 0) && (compressedLength < bufferPos)) {
+		pStream->writeUint8(CompressionMethod_LZ);
+		compressedBlock.resize(compressedLength);
+		pStream->writeString(compressedBlock);
+	} else {
+		// not compressible (or compression disabled)
+		pStream->writeUint8(CompressionMethod_None);
+		pStream->writeString(std::string(pBuffer, bufferPos));
+	}
+
+	bufferPos = 0;
+}
@@ -17,6 +17,7 @@
 
 #include <misc/OFileStream.h>
 
+#include <stdio.h>
 #include <string.h>
 #include <SDL_endian.h>
 
@@ -27,18 +28,22 @@
 OFileStream::OFileStream()
 {
 	fp = NULL;
+	bufferPos = 0;
+	pBuffer = (char*) malloc(OFILESTREAM_BUFFERSIZE);
+	if(pBuffer == NULL) {
+		throw OutputStream::error("OFileStream::OFileStream(): malloc failed!");
+	}
 }
 
 OFileStream::~OFileStream()
 {
 	close();
+	free(pBuffer);
 }
 
 bool OFileStream::open(const char* filename)
 {
-	if(fp != NULL) {
-		fclose(fp);
-	}
+	close();
 
 	const char* pFilename = filename;
 
@@ -75,13 +80,21 @@ bool OFileStream::open(std::string filename)
 void OFileStream::close()
 {
 	if(fp != NULL) {
+		// close() is called from the destructor, so we cannot throw here
+		if(writeBuffer() == false) {
+			fprintf(stderr, "OFileStream::close(): An I/O-Error occurred!\n");
+		}
 		fclose(fp);
 		fp = NULL;
 	}
+	bufferPos = 0;
 }
 
 void OFileStream::flush() {
     if(fp != NULL) {
+        if(writeBuffer() == false) {
+            throw OutputStream::error("OFileStream::flush(): An I/O-Error occurred!");
+        }
         fflush(fp);
     }
 }
@@ -91,43 +104,31 @@ void OFileStream::writeString(const std::string& str)
 	writeUint32(str.length());
 
     if(!str.empty()) {
-        if(fwrite(str.c_str(),str.length(),1,fp) != 1) {
-            throw OutputStream::error("OFileStream::writeString(): An I/O-Error occurred!");
-        }
+        writeBuffered(str.c_str(), str.length());
     }
 }
 
 void OFileStream::writeUint8(Uint8 x)
 {
-	if(fwrite(&x,sizeof(Uint8),1,fp) != 1) {
-		throw OutputStream::error("OFileStream::writeUint8(): An I/O-Error occurred!");
-	}
+	writeBuffered(&x, sizeof(Uint8));
 }
 
 void OFileStream::writeUint16(Uint16 x)
 {
 	x = SDL_SwapLE16(x);
-
-	if(fwrite(&x,sizeof(Uint16),1,fp) != 1) {
-		throw OutputStream::error("OFileStream::writeUint16(): An I/O-Error occurred!");
-	}
+	writeBuffered(&x, sizeof(Uint16));
 }
 
 void OFileStream::writeUint32(Uint32 x)
 {
 	x = SDL_SwapLE32(x);
-
-	if(fwrite(&x,sizeof(Uint32),1,fp) != 1) {
-		throw OutputStream::error("OFileStream::writeUint32(): An I/O-Error occurred!");
-	}
+	writeBuffered(&x, sizeof(Uint32));
 }
 
 void OFileStream::writeUint64(Uint64 x)
 {
 	x = SDL_SwapLE64(x);
-	if(fwrite(&x,sizeof(Uint64),1,fp) != 1) {
-		throw OutputStream::error("OFileStream::writeUint64(): An I/O-Error occurred!");
-	}
+	writeBuffered(&x, sizeof(Uint64));
 }
 
 void OFileStream::writeBool(bool x)
@@ -147,11 +148,42 @@ void OFileStream::writeCoord(Coord c)
 	c.x = SDL_SwapLE32(c.x);
 	c.y = SDL_SwapLE32(c.y);
 
-	if(fwrite(&c.x,sizeof(Uint32),1,fp) != 1) {
-		throw OutputStream::error("OFileStream::writeCoord(): An I/O-Error occurred!");
-	}
-	if(fwrite(&c.y,sizeof(Uint32),1,fp) != 1) {
-			throw OutputStream::error("OFileStream::writeCoord(): An I/O-Error occurred!");
+	writeBuffered(&c.x, sizeof(Uint32));
+	writeBuffered(&c.y, sizeof(Uint32));
+}
+
+void OFileStream::writeData(const void* pData, size_t length)
+{
+	writeBuffered(pData, length);
+}
+
+void OFileStream::writeBuffered(const void* pData, size_t length)
+{
+	if(bufferPos + length > OFILESTREAM_BUFFERSIZE) {
+		if((fp == NULL) || (writeBuffer() == false)) {
+			throw OutputStream::error("OFileStream::writeBuffered(): An I/O-Error occurred!");
+		}
+
+		if(length > OFILESTREAM_BUFFERSIZE) {
+			// too big for the buffer anyway
+			if(fwrite(pData, length, 1, fp) != 1) {
+				throw OutputStream::error("OFileStream::writeBuffered(): An I/O-Error occurred!");
+			}
+			return;
+		}
 	}
+
+	memcpy(pBuffer + bufferPos, pData, length);
+	bufferPos += length;
 }
 
+bool OFileStream::writeBuffer()
+{
+	if(bufferPos == 0) {
+		return true;
+	}
+
+	size_t length = bufferPos;
+	bufferPos = 0;
+	return (fwrite(pBuffer, length, 1, fp) == 1);
+}
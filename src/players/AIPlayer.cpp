@@ -32,12 +32,16 @@
 #include <units/MCV.h>
 #include <units/Harvester.h>
 
+#include <misc/timing_util.h>
+
 #include <algorithm>
 
 #define AIUPDATEINTERVAL 50
 
 AIPlayer::AIPlayer(House* associatedHouse, std::string playername, Uint8 difficulty)
  : Player(associatedHouse, playername), difficulty(difficulty) {
+    AIPlayer::init();
+
 	attackTimer = (((enum_difficulty::END-1)-difficulty) * MILLI2CYCLES(2*60*1000)) + getRandomGen().rand(MILLI2CYCLES(8*60*1000), MILLI2CYCLES(11*60*1000));
 	buildTimer = getRandomGen().rand(0,3) * 50;
 }
@@ -59,6 +63,10 @@ AIPlayer::AIPlayer(InputStream& stream, House* associatedHouse) : Player(stream,
 }
 
 void AIPlayer::init() {
+    lastUpdateTime = 0;
+    maxUpdateTime = 0;
+    totalUpdateTime = 0;
+    numUpdates = 0;
 }
 
 
@@ -87,6 +95,9 @@ void AIPlayer::update() {
         // we are not updating this AI player this cycle
         return;
     }
+
+    Uint64 startTime = getMicroseconds();
+
     checkAllUnits();
 
 
@@ -101,6 +112,11 @@ void AIPlayer::update() {
 	} else {
         attackTimer -= AIUPDATEINTERVAL;
 	}
+
+	lastUpdateTime = (Uint32) (getMicroseconds() - startTime);
+	maxUpdateTime = std::max(maxUpdateTime, lastUpdateTime);
+	totalUpdateTime += lastUpdateTime;
+	numUpdates++;
 }
 
 void AIPlayer::onIncrementStructures(int itemID) {
@@ -155,7 +171,7 @@ void AIPlayer::onDamage(const ObjectBase* pObject, int damage, Uint32 damagerID)
 }
 
 void AIPlayer::scrambleUnitsAndDefend(const ObjectBase* pIntruder, Uint8 number) {
-    RobustList<const UnitBase*>::const_iterator iter;
+    DenseList<const UnitBase*>::const_iterator iter;
     Uint8 a=0;
     bool retaliate=0;
     /* Dont retaliate on worm we now have a dedicated smarter function */
@@ -191,8 +207,36 @@ void AIPlayer::scrambleUnitsAndDefend(const ObjectBase* pIntruder, Uint8 number)
     
 }
 
+/**
+    Sends up to number of the idle units to attack pIntruder. In contrast to scrambleUnitsAndDefend() only the
+    prepared list of idle units is searched instead of the whole unit list.
+    \param  pIntruder   the unit to attack
+    \param  number      the maximum number of units to send; 0 (a house with less than 10 units) sends all idle units
+                        as scrambleUnitsAndDefend() does
+    \param  idleUnits   our units that were idle and able to retaliate at the beginning of this AI update
+*/
+void AIPlayer::scrambleIdleUnitsAndDefend(const ObjectBase* pIntruder, Uint8 number, const std::vector<const UnitBase*>& idleUnits) {
+    /* Dont retaliate on worm we now have a dedicated smarter function */
+    if(pIntruder == NULL || (pIntruder->getItemID() == Unit_Sandworm)) return;
+
+    size_t maxUnits = (number == 0) ? idleUnits.size() : number;
+
+    size_t a=0;
+    std::vector<const UnitBase*>::const_iterator iter;
+    for(iter = idleUnits.begin(); (iter != idleUnits.end()) && (a < maxUnits); ++iter) {
+        const UnitBase* pUnit = *iter;
+
+        // units sent against an earlier intruder in this update are not idle anymore
+        if((pUnit->getAttackMode() != HUNT) && !pUnit->hasATarget()) {
+            doSetAttackMode(pUnit, HUNT);
+            doAttackObject(pUnit, pIntruder, true);
+            a++;
+        }
+    }
+}
+
 void AIPlayer::scrambleUnitsAndDefendFromWorm(const ObjectBase* pIntruder, Uint8 number) {
-    RobustList<const UnitBase*>::const_iterator iter;
+    DenseList<const UnitBase*>::const_iterator iter;
     Uint8 a=0;
 
     for(iter = getUnitList().begin(); iter != getUnitList().end() ; ++iter) {
@@ -232,7 +276,7 @@ Coord AIPlayer::findPlaceLocation(Uint32 itemID) {
         maxX = getMap().getSizeX() - 1;
         maxY = getMap().getSizeY() - 1;
     } else {
-        RobustList<const StructureBase*>::const_iterator iter;
+        DenseList<const StructureBase*>::const_iterator iter;
         for(iter = getStructureList().begin(); iter != getStructureList().end(); ++iter) {
             const StructureBase* structure = *iter;
             if (structure->getOwner() == getHouse()) {
@@ -291,7 +335,7 @@ Coord AIPlayer::findPlaceLocation(Uint32 itemID) {
                 case Structure_ConstructionYard: {
                     float nearestUnit = 10000000.0f;
 
-                    RobustList<const UnitBase*>::const_iterator iter;
+                    DenseList<const UnitBase*>::const_iterator iter;
                     for(iter = getUnitList().begin(); iter != getUnitList().end(); ++iter) {
                         const UnitBase* pUnit = *iter;
                         if(pUnit->getOwner() == getHouse()) {
@@ -338,7 +382,7 @@ Coord AIPlayer::findPlaceLocation(Uint32 itemID) {
                     // place towards enemy
                     float nearestEnemy = 10000000.0f;
 
-                    RobustList<const StructureBase*>::const_iterator iter2;
+                    DenseList<const StructureBase*>::const_iterator iter2;
                     for(iter2 = getStructureList().begin(); iter2 != getStructureList().end(); ++iter2) {
                         const StructureBase* pStructure = *iter2;
                         if(pStructure->getOwner()->getTeam() != getHouse()->getTeam()) {
@@ -363,7 +407,7 @@ Coord AIPlayer::findPlaceLocation(Uint32 itemID) {
                     // place at a save place
                     float nearestEnemy = 10000000.0f;
 
-                    RobustList<const StructureBase*>::const_iterator iter2;
+                    DenseList<const StructureBase*>::const_iterator iter2;
                     for(iter2 = getStructureList().begin(); iter2 != getStructureList().end(); ++iter2) {
                         const StructureBase* pStructure = *iter2;
                         if(pStructure->getOwner()->getTeam() != getHouse()->getTeam()) {
@@ -419,7 +463,7 @@ int AIPlayer::getNumAdjacentStructureTiles(Coord pos, int structureSizeX, int st
 void AIPlayer::build() {
 	bool bConstructionYardChecked = false;
 
-    RobustList<const StructureBase*>::const_iterator iter;
+    DenseList<const StructureBase*>::const_iterator iter;
     for(iter = getStructureList().begin(); iter != getStructureList().end(); ++iter) {
         const StructureBase* pStructure = *iter;
 
@@ -753,7 +797,7 @@ Coord AIPlayer::mentatAnalysis_AttackVector(const ObjectBase* target) {
     }
 
 
-	RobustList<UnitBase*>::const_iterator iter;
+	DenseList<UnitBase*>::const_iterator iter;
 	for(iter = unitList.begin(); iter != unitList.end(); ++iter) {
 		UnitBase* tempUnit = *iter;
 		Uint32 itemID = tempUnit->getItemID();
@@ -867,7 +911,7 @@ bool AIPlayer::mentatAnalysis(bool performIfAdvised) {
 			// Regroup for a later attack : on perform doMove
 			if (performIfAdvised) {
 				doMove2Pos(pLeaderUnit, attackPos.x, attackPos.y, true);
-				RobustList<UnitBase*>::const_iterator iter;
+				DenseList<UnitBase*>::const_iterator iter;
 				for(iter = unitList.begin(); iter != unitList.end(); ++iter) {
 					UnitBase* tempUnit = *iter;
 					Uint32 itemID = tempUnit->getItemID();
@@ -892,7 +936,7 @@ bool AIPlayer::mentatAnalysis(bool performIfAdvised) {
 			// Go for attack if advised
 			if (performIfAdvised) {
 				doMove2Pos(pLeaderUnit, attackPos.x, attackPos.y, true);
-				RobustList<UnitBase*>::const_iterator iter;
+				DenseList<UnitBase*>::const_iterator iter;
 				for(iter = unitList.begin(); iter != unitList.end(); ++iter) {
 					UnitBase* tempUnit = *iter;
 					Uint32 itemID = tempUnit->getItemID();
@@ -932,7 +976,7 @@ void AIPlayer::attack() {
 		mentatAnalysis(true);
 
 	    /* If we can combine with a super weapon , let's do it ! */
-	   RobustList<const StructureBase*>::const_iterator iter2;
+	   DenseList<const StructureBase*>::const_iterator iter2;
 	   for(iter2 = getStructureList().begin(); iter2 != getStructureList().end(); ++iter2) {
 		   const StructureBase *pStruct = *iter2;
 
@@ -962,60 +1006,98 @@ void AIPlayer::attack() {
 }
 
 void AIPlayer::checkAllUnits() {
-    RobustList<const UnitBase*>::const_iterator iter;
+    // sort the units into buckets once, so that no threat below has to search the whole unit list again
+    std::vector<const UnitBase*> activeSandworms;
+    std::vector<const UnitBase*> attackers;             // enemy units that target one of our units
+    std::vector<const UnitBase*> ownUnits;
+    std::vector<const Harvester*> ownHarvesters;
+    std::vector<const UnitBase*> idleDefenders;         // our idle units that can retaliate against ground units
+    std::vector<const UnitBase*> idleAirDefenders;      // our idle units that can retaliate against air units
+
+    DenseList<const UnitBase*>::const_iterator iter;
     for(iter = getUnitList().begin(); iter != getUnitList().end(); ++iter) {
         const UnitBase* pUnit = *iter;
+        Uint32 itemID = pUnit->getItemID();
 
-		/* Return harvester and detach a small force to protect */
-        if(pUnit->getItemID() == Unit_Sandworm && pUnit->isActive()) {
-                RobustList<const UnitBase*>::const_iterator iter2;
-                for(iter2 = getUnitList().begin(); iter2 != getUnitList().end(); ++iter2) {
-                    const UnitBase* pUnit2 = *iter2;
-
-                    if(pUnit2->getOwner() == getHouse() && pUnit2->getItemID() == Unit_Harvester) {
-                        const Harvester* pHarvester = dynamic_cast<const Harvester*>(pUnit2);
-                        Uint8 responseAllocation = getHouse()->allocateSquadSize((ObjectBase*)pHarvester,(Uint32)pUnit->getItemID());
-
-                        if( pHarvester != NULL
-                            && getMap().tileExists(pHarvester->getLocation())
-                            && !getMap().getTile(pHarvester->getLocation())->isRock()
-                            && blockDistance(pUnit->getLocation(), pHarvester->getLocation()) <= 10) {
-                            doReturn(pHarvester);
-                            scrambleUnitsAndDefend(pUnit,responseAllocation);
-                        }
-                    }
+        if(itemID == Unit_Sandworm) {
+            if(pUnit->isActive()) {
+                activeSandworms.push_back(pUnit);
+            }
+        } else if(pUnit->getOwner() != getHouse()) {
+            if(pUnit->isActive() && pUnit->hasATarget() && pUnit->getTarget() != NULL && (pUnit->getTarget())->getOwner() == getHouse()) {
+                attackers.push_back(pUnit);
+            }
+        } else {
+            ownUnits.push_back(pUnit);
+
+            if(itemID == Unit_Harvester) {
+                ownHarvesters.push_back(static_cast<const Harvester*>(pUnit));
+            }
+
+            if(pUnit->isRespondable() && (pUnit->getAttackMode() != HUNT) && !pUnit->hasATarget()) {
+                bool retaliate_mask = 		 (itemID != Unit_Harvester) && (itemID != Unit_MCV) && (itemID != Unit_Carryall) && (itemID != Unit_Frigate) && (itemID != Unit_Saboteur);
+                bool retaliate_mask_vs_air = retaliate_mask && ( itemID == Unit_Ornithopter || itemID == Unit_Launcher  || itemID == Unit_Troopers || itemID == Unit_Trooper );
+
+                if(retaliate_mask) {
+                    idleDefenders.push_back(pUnit);
                 }
-            continue;
+                if(retaliate_mask_vs_air) {
+                    idleAirDefenders.push_back(pUnit);
+                }
+            }
         }
-        
-        /* Pullback and detach a small force to cover before being damage */
-        if(pUnit->getOwner() != getHouse() && pUnit->isActive() && pUnit->hasATarget() && pUnit->getTarget() != NULL &&(pUnit->getTarget())->getOwner() == getHouse()) {
-                      RobustList<const UnitBase*>::const_iterator iter2;
-                      for(iter2 = getUnitList().begin(); iter2 != getUnitList().end(); ++iter2) {
-                          const UnitBase* pUnit2 = *iter2;
-                          int itemID = pUnit2->getItemID();
-
-                          bool retaliate_mask = (itemID != Unit_Harvester)  && (itemID != Unit_Carryall) && (itemID != Unit_Frigate) && (itemID != Unit_Saboteur) && (itemID != Unit_Sandworm);
-                          bool attacker_mask = pUnit->hasATarget() && pUnit->getTarget() != NULL && pUnit->getTarget() ==  pUnit2 && pUnit->canAttack(pUnit2) && pUnit->targetInWeaponRange() ;
-
-                          if (pUnit2->getOwner() == getHouse() && pUnit2->isActive() && !pUnit2->wasForced() && (attacker_mask) &&  (retaliate_mask) ) {
-                        	  Uint8 responseAllocation = getHouse()->allocateSquadSize((ObjectBase*)pUnit2,(Uint32)pUnit->getItemID());
-
-                              if( blockDistance(pUnit->getLocation(), pUnit2->getLocation()) <= pUnit->getAreaGuardRange()) {
-                            	  if (pUnit2->getHealth() < pUnit2->getMaxHealth()/4)
-                            		  doRepair((ObjectBase*)pUnit2);
-                            	  if (pUnit2->getAttackMode() != HUNT || pUnit2->getAttackMode() != AMBUSH)
-                            		  scrambleUnitsAndDefend(pUnit,responseAllocation);
-                              	 err_print("Player %s checkAllUnits scrambleUnitsAndDefend from %d!\n", AIPlayer::getPlayername().c_str(),pUnit->getItemID());
-                              }
-                          }
-                      }
-                  continue;
+    }
+
+    /* Return harvester when a worm is near (ornithopters are sent against the worm in onDamage()) */
+    std::vector<const UnitBase*>::const_iterator wormIter;
+    for(wormIter = activeSandworms.begin(); wormIter != activeSandworms.end(); ++wormIter) {
+        const UnitBase* pSandworm = *wormIter;
+
+        std::vector<const Harvester*>::const_iterator harvesterIter;
+        for(harvesterIter = ownHarvesters.begin(); harvesterIter != ownHarvesters.end(); ++harvesterIter) {
+            const Harvester* pHarvester = *harvesterIter;
+
+            if( getMap().tileExists(pHarvester->getLocation())
+                && !getMap().getTile(pHarvester->getLocation())->isRock()
+                && blockDistance(pSandworm->getLocation(), pHarvester->getLocation()) <= 10) {
+                doReturn(pHarvester);
+            }
         }
+    }
+
+    /* Pullback and detach a small force to cover before being damage */
+    std::vector<const UnitBase*>::const_iterator attackerIter;
+    for(attackerIter = attackers.begin(); attackerIter != attackers.end(); ++attackerIter) {
+        const UnitBase* pUnit = *attackerIter;
 
-        if(pUnit->getOwner() != getHouse()) {
+        // the only unit of ours that can be in danger from this attacker is its target
+        const ObjectBase* pTarget = pUnit->getTarget();
+        if(!pTarget->isAUnit()) {
             continue;
         }
+
+        const UnitBase* pUnit2 = static_cast<const UnitBase*>(pTarget);
+        int itemID = pUnit2->getItemID();
+
+        bool retaliate_mask = (itemID != Unit_Harvester)  && (itemID != Unit_Carryall) && (itemID != Unit_Frigate) && (itemID != Unit_Saboteur) && (itemID != Unit_Sandworm);
+        bool attacker_mask = pUnit->canAttack(pUnit2) && pUnit->targetInWeaponRange() ;
+
+        if (pUnit2->isActive() && !pUnit2->wasForced() && (attacker_mask) &&  (retaliate_mask) ) {
+            Uint8 responseAllocation = getHouse()->allocateSquadSize((ObjectBase*)pUnit2,(Uint32)pUnit->getItemID());
+
+            if( blockDistance(pUnit->getLocation(), pUnit2->getLocation()) <= pUnit->getAreaGuardRange()) {
+                if (pUnit2->getHealth() < pUnit2->getMaxHealth()/4)
+                    doRepair((ObjectBase*)pUnit2);
+                if (pUnit2->getAttackMode() != HUNT || pUnit2->getAttackMode() != AMBUSH)
+                    scrambleIdleUnitsAndDefend(pUnit, responseAllocation, pUnit->isAFlyingUnit() ? idleAirDefenders : idleDefenders);
+                err_print("Player %s checkAllUnits scrambleUnitsAndDefend from %d!\n", AIPlayer::getPlayername().c_str(),pUnit->getItemID());
+            }
+        }
+    }
+
+    std::vector<const UnitBase*>::const_iterator ownIter;
+    for(ownIter = ownUnits.begin(); ownIter != ownUnits.end(); ++ownIter) {
+        const UnitBase* pUnit = *ownIter;
         
 		/* Our units */
         switch(pUnit->getItemID()) {
@@ -95,7 +95,7 @@ void onDamage(const ObjectBase* pObject, int damage, Uint32 damagerID) {
 void HumanPlayer::build() {
 	bool bConstructionYardChecked = false;
 
-    RobustList<const StructureBase*>::const_iterator iter;
+    DenseList<const StructureBase*>::const_iterator iter;
 
     for(iter = getStructureList().begin(); iter != getStructureList().end(); ++iter) {
         const StructureBase* pStructure = *iter;
@@ -309,13 +309,13 @@ void HumanPlayer::build() {
 }
 
 void HumanPlayer::checkAllUnits() {
-    RobustList<const UnitBase*>::const_iterator iter;
+    DenseList<const UnitBase*>::const_iterator iter;
     for(iter = getUnitList().begin(); iter != getUnitList().end(); ++iter) {
         const UnitBase* pUnit = *iter;
 
 		/* Return harvester  */
         if(pUnit->getItemID() == Unit_Sandworm && pUnit->isActive()) {
-                RobustList<const UnitBase*>::const_iterator iter2;
+                DenseList<const UnitBase*>::const_iterator iter2;
                 for(iter2 = getUnitList().begin(); iter2 != getUnitList().end(); ++iter2) {
                     const UnitBase* pUnit2 = *iter2;
 
@@ -395,7 +395,7 @@ Coord HumanPlayer::findPlaceLocation(Uint32 itemID) {
         maxX = getMap().getSizeX() - 1;
         maxY = getMap().getSizeY() - 1;
     } else {
-        RobustList<const StructureBase*>::const_iterator iter;
+        DenseList<const StructureBase*>::const_iterator iter;
         for(iter = getStructureList().begin(); iter != getStructureList().end(); ++iter) {
             const StructureBase* structure = *iter;
             if (structure->getOwner() == getHouse()) {
@@ -454,7 +454,7 @@ Coord HumanPlayer::findPlaceLocation(Uint32 itemID) {
                 case Structure_ConstructionYard: {
                     float nearestUnit = 10000000.0f;
 
-                    RobustList<const UnitBase*>::const_iterator iter;
+                    DenseList<const UnitBase*>::const_iterator iter;
                     for(iter = getUnitList().begin(); iter != getUnitList().end(); ++iter) {
                         const UnitBase* pUnit = *iter;
                         if(pUnit->getOwner() == getHouse()) {
@@ -501,7 +501,7 @@ Coord HumanPlayer::findPlaceLocation(Uint32 itemID) {
                     // place towards enemy
                     float nearestEnemy = 10000000.0f;
 
-                    RobustList<const StructureBase*>::const_iterator iter2;
+                    DenseList<const StructureBase*>::const_iterator iter2;
                     for(iter2 = getStructureList().begin(); iter2 != getStructureList().end(); ++iter2) {
                         const StructureBase* pStructure = *iter2;
                         if(pStructure->getOwner()->getTeam() != getHouse()->getTeam()) {
@@ -526,7 +526,7 @@ Coord HumanPlayer::findPlaceLocation(Uint32 itemID) {
                     // place at a save place
                     float nearestEnemy = 10000000.0f;
 
-                    RobustList<const StructureBase*>::const_iterator iter2;
+                    DenseList<const StructureBase*>::const_iterator iter2;
                     for(iter2 = getStructureList().begin(); iter2 != getStructureList().end(); ++iter2) {
                         const StructureBase* pStructure = *iter2;
                         if(pStructure->getOwner()->getTeam() != getHouse()->getTeam()) {
@@ -82,7 +82,7 @@ void OldAIPlayer::update() {
 	bool bConstructionYardChecked = false;
 	if(buildTimer == 0) {
 
-		RobustList<const StructureBase*>::const_iterator iter;
+		DenseList<const StructureBase*>::const_iterator iter;
 		for(iter = getStructureList().begin(); iter != getStructureList().end(); ++iter) {
             const StructureBase* pStructure = *iter;
 
@@ -316,7 +316,7 @@ void OldAIPlayer::update() {
 	} else {
         Coord destination;
         const UnitBase* pLeaderUnit = NULL;
-        RobustList<const UnitBase*>::const_iterator iter;
+        DenseList<const UnitBase*>::const_iterator iter;
 	    for(iter = getUnitList().begin(); iter != getUnitList().end(); ++iter) {
             const UnitBase *pUnit = *iter;
             if (pUnit->isRespondable()
@@ -370,7 +370,7 @@ void OldAIPlayer::onDecrementStructures(int itemID, const Coord& location) {
 	//rebuild the structure if its the original gameType
 
 	if (((currentGame->gameType == GAMETYPE_CAMPAIGN) || (currentGame->gameType == GAMETYPE_SKIRMISH)) && !structureList.empty()) {
-		RobustList<StructureBase*>::const_iterator iter;
+		DenseList<StructureBase*>::const_iterator iter;
 		for(iter = structureList.begin(); iter != structureList.end(); ++iter) {
 			StructureBase* structure = *iter;
 			if ((structure->getItemID() == Structure_ConstructionYard) && (structure->getOwner() == this)) {
@@ -448,7 +448,7 @@ void OldAIPlayer::setAttackTimer(int newAttackTimer) {
 }
 
 void OldAIPlayer::scrambleUnitsAndDefend(Uint32 intruderID) {
-    RobustList<const UnitBase*>::const_iterator iter;
+    DenseList<const UnitBase*>::const_iterator iter;
     for(iter = getUnitList().begin(); iter != getUnitList().end(); ++iter) {
         const UnitBase* pUnit = *iter;
         if(pUnit->isRespondable() && (pUnit->getOwner() == getHouse())) {
@@ -476,7 +476,7 @@ Coord OldAIPlayer::findPlaceLocation(Uint32 itemID) {
     int minY = getMap().getSizeY();
     int maxY = -1;
 
-    RobustList<const StructureBase*>::const_iterator iter;
+    DenseList<const StructureBase*>::const_iterator iter;
     for(iter = getStructureList().begin(); iter != getStructureList().end(); ++iter) {
 		const StructureBase* structure = *iter;
 		if (structure->getOwner() == getHouse()) {
@@ -556,7 +556,7 @@ Coord OldAIPlayer::findPlaceLocation(Uint32 itemID) {
                     // place towards enemy
                     float nearestEnemy = 10000000.0f;
 
-                    RobustList<const StructureBase*>::const_iterator iter2;
+                    DenseList<const StructureBase*>::const_iterator iter2;
                     for(iter2 = getStructureList().begin(); iter2 != getStructureList().end(); ++iter2) {
                         const StructureBase* pStructure = *iter2;
                         if(pStructure->getOwner()->getTeam() != getHouse()->getTeam()) {
@@ -581,7 +581,7 @@ Coord OldAIPlayer::findPlaceLocation(Uint32 itemID) {
                     // place at a save place
                     float nearestEnemy = 10000000.0f;
 
-                    RobustList<const StructureBase*>::const_iterator iter2;
+                    DenseList<const StructureBase*>::const_iterator iter2;
                     for(iter2 = getStructureList().begin(); iter2 != getStructureList().end(); ++iter2) {
                         const StructureBase* pStructure = *iter2;
                         if(pStructure->getOwner()->getTeam() != getHouse()->getTeam()) {
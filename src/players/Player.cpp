@@ -75,12 +75,12 @@ const ObjectBase* Player::getObject(Uint32 objectID) const {
     return currentGame->getObjectManager().getObject(objectID);
 }
 
-const RobustList<const StructureBase*>& Player::getStructureList() const {
-    return reinterpret_cast<const RobustList<const StructureBase*>&>(structureList);
+const DenseList<const StructureBase*>& Player::getStructureList() const {
+    return reinterpret_cast<const DenseList<const StructureBase*>&>(structureList);
 }
 
-const RobustList<const UnitBase*>& Player::getUnitList() const {
-    return reinterpret_cast<const RobustList<const UnitBase*>&>(unitList);
+const DenseList<const UnitBase*>& Player::getUnitList() const {
+    return reinterpret_cast<const DenseList<const UnitBase*>&>(unitList);
 }
 
 const House* Player::getHouse(int houseID) const {
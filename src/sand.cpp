@@ -757,7 +757,11 @@ void startReplay(std::string filename) {
     printf("Initialization finished!\n");
     fflush(stdout);
 
-    currentGame->runMainLoop();
+    if(bHeadless) {
+        currentGame->runHeadless();
+    } else {
+        currentGame->runMainLoop();
+    }
 
     delete currentGame;
 
@@ -180,7 +180,7 @@ void BuilderBase::removeItem(std::list<BuildItem>& buildItemList, std::list<Buil
 
 
 void BuilderBase::setOwner(House *no) {
-	this->owner = no;
+	ObjectBase::setOwner(no);
 }
 
 bool BuilderBase::isWaitingToPlace() const {
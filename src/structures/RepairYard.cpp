@@ -166,7 +166,7 @@ void RepairYard::updateStructureSpecificStuff() {
 		    Carryall* pCarryall = NULL;
 		    float distance = std::numeric_limits<float>::infinity();
             if((pRepairUnit->getGuardPoint().isValid()) && getOwner()->hasCarryalls())	{
-                RobustList<UnitBase*>::const_iterator iter;
+                DenseList<UnitBase*>::const_iterator iter;
                 for(iter = unitList.begin(); iter != unitList.end(); ++iter) {
                     UnitBase* unit = *iter;
                     if ((unit->getOwner() == owner) && (unit->getItemID() == Unit_Carryall)) {
@@ -75,6 +75,11 @@ void StructureBase::init() {
 
 StructureBase::~StructureBase() {
     currentGameMap->removeObjectFromMap(getObjectID());	//no map point will reference now
+	for(int i = location.x; i < location.x + structureSize.x; i++) {
+		for(int j = location.y; j < location.y + structureSize.y; j++) {
+			currentGameMap->tilePassabilityChanged(Coord(i,j));
+		}
+	}
 	currentGame->getObjectManager().removeObject(getObjectID());
 	structureList.remove(this);
 	owner->decrementStructures(itemID, location);
@@ -115,6 +120,7 @@ void StructureBase::assignToMap(const Coord& pos) {
                     }
 				}
 				pTile->setType(Terrain_Rock);
+				currentGameMap->tilePassabilityChanged(Coord(i,j));
 				pTile->setOwner(getOwner()->getHouseID());
 				currentGameMap->viewMap(getOwner()->getTeam(), Coord(i,j), getViewRange());
 
@@ -70,9 +70,20 @@ void TurretBase::save(OutputStream& stream) const {
 
 
 void TurretBase::updateStructureSpecificStuff() {
+	// the target search is only done when it is our turn (see Game::mayScanForTarget()) and at most once per cycle
+	bool bSearchedTarget = false;
+	const ObjectBase* pFoundTarget = NULL;
+	auto scheduledFindTarget = [&]() -> const ObjectBase* {
+		if(!bSearchedTarget) {
+			bSearchedTarget = true;
+			pFoundTarget = currentGame->mayScanForTarget(this) ? findTarget() : NULL;
+		}
+		return pFoundTarget;
+	};
+
 	if (oldtarget && (oldtarget.getObjPointer() != NULL)) {
 		if(!canAttack(oldtarget.getObjPointer()) || !oldtargetInWeaponRange()) {
-			const ObjectBase * tmp = findTarget();
+			const ObjectBase * tmp = scheduledFindTarget();
 			float closeTargetDistance = tmp != NULL ?  blockDistance(location, tmp->getLocation()) :  std::numeric_limits<float>::infinity();
 			if(findTargetTimer == 0 && closeTargetDistance <= getWeaponRange()) {
 				setOldTarget(tmp);
@@ -85,7 +96,7 @@ void TurretBase::updateStructureSpecificStuff() {
 	}
 	if(target && (target.getObjPointer() != NULL)) {
 		if(!canAttack(target.getObjPointer()) || !targetInWeaponRange()) {
-			const ObjectBase * tmp = findTarget();
+			const ObjectBase * tmp = scheduledFindTarget();
 			float closeTargetDistance = tmp != NULL ?  blockDistance(location, tmp->getLocation()) :  std::numeric_limits<float>::infinity();
 			// XXX : We may have an near target that is ready to attack us
 			if(closeTargetDistance <= getWeaponRange() && tmp->getTarget() == this && tmp->getTarget()->targetInWeaponRange()) {
@@ -106,7 +117,7 @@ void TurretBase::updateStructureSpecificStuff() {
 
 	if (!target || target.getObjPointer() == NULL) {
 		if (findTargetTimer == 0) {
-			const ObjectBase * tmp = findTarget();
+			const ObjectBase * tmp = scheduledFindTarget();
 			float closeTargetDistance = tmp != NULL ?  blockDistance(location, tmp->getLocation()) :  std::numeric_limits<float>::infinity();
 			if(closeTargetDistance <= getWeaponRange()) {
 				setTarget(tmp);
@@ -118,7 +129,7 @@ void TurretBase::updateStructureSpecificStuff() {
 	// thus preventing the RocketTurret::attack "rturret able to take an opportunistic second shoot" behavior
 	if (!oldtarget || oldtarget.getObjPointer() == NULL) {
 		if (findTargetTimer == 0 || findTargetTimer == 100) {
-			const ObjectBase * tmp = findTarget();
+			const ObjectBase * tmp = scheduledFindTarget();
 			float closeTargetDistance = tmp != NULL ?  blockDistance(location, tmp->getLocation()) :  std::numeric_limits<float>::infinity();
 			if(closeTargetDistance <= getWeaponRange()) {
 				setOldTarget(tmp);
@@ -938,7 +938,7 @@ ConstructionYard* Carryall::findConstYard() {
 	float	closestYardDistance = std::numeric_limits<float>::infinity();;
 	ConstructionYard* bestYard = NULL;
 
-	RobustList<StructureBase*>::const_iterator iter;
+	DenseList<StructureBase*>::const_iterator iter;
 	for(iter = structureList.begin(); iter != structureList.end(); ++iter) {
 		StructureBase* tempStructure = *iter;
 
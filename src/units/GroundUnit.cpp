@@ -126,7 +126,7 @@ bool GroundUnit::requestCarryall() {
 		Carryall* carryall = NULL;
 		float distance = std::numeric_limits<float>::infinity();
 
-		RobustList<UnitBase*>::const_iterator iter;
+		DenseList<UnitBase*>::const_iterator iter;
 		UnitBase* unit, *bestunit = NULL;
 	    for(iter = unitList.begin(); iter != unitList.end(); ++iter) {
 			unit = *iter;
@@ -201,7 +201,7 @@ void GroundUnit::doRepair() {
 		float	closestLeastBookedRepairYardDistance = std::numeric_limits<float>::infinity();
         RepairYard* bestRepairYard = NULL;
 
-        RobustList<StructureBase*>::const_iterator iter;
+        DenseList<StructureBase*>::const_iterator iter;
         for(iter = structureList.begin(); iter != structureList.end(); ++iter) {
             StructureBase* tempStructure = *iter;
 
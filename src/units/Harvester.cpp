@@ -168,7 +168,7 @@ Refinery* Harvester::findRefinery() {
 		float	closestLeastBookedRefineryDistance = std::numeric_limits<float>::infinity();
 
 
-        RobustList<StructureBase*>::const_iterator iter;
+        DenseList<StructureBase*>::const_iterator iter;
         for(iter = structureList.begin(); iter != structureList.end(); ++iter) {
 			StructureBase* tempStructure = *iter;
 
@@ -457,7 +457,7 @@ const ObjectBase* Sandworm::findTarget() const {
 	if(attackMode == HUNT) {
 	    float closestDistance = INFINITY;
 
-        RobustList<UnitBase*>::const_iterator iter;
+        DenseList<UnitBase*>::const_iterator iter;
 	    for(iter = unitList.begin() ; iter != unitList.end()  ; ++iter) {
 			UnitBase* tempUnit = *iter;
 			// find Heavy unit (worms are attracted by vibrations from far away)
@@ -198,7 +198,11 @@ void TankBase::targeting() {
         if(attackMode != STOP && !closeTarget && ((!moving && !justStoppedMoving) || bFollow)) {
         	const ObjectBase * tmp = getNearerTarget(getWeaponRange(),false);
             // we already have our target or our old target in range or find another temp target
-            closeTarget = tmp != NULL ? tmp :  findTarget();
+            if(tmp != NULL) {
+            	closeTarget = tmp;
+            } else if(currentGame->mayScanForTarget(this)) {
+            	closeTarget = findTarget();
+            }
         }
     }
 
@@ -541,7 +541,7 @@ void UnitBase::destroy() {
 
             if(owner->getHouseID() != originalHouseID) {
                 // deviation is inherited
-                pNewUnit->owner = owner;
+                pNewUnit->setOwner(owner);
                 pNewUnit->graphic = pGFXManager->getObjPic(pNewUnit->graphicID,owner->getHouseID());
                 pNewUnit->deviationTimer = deviationTimer;
             }
@@ -567,7 +567,7 @@ void UnitBase::deviate(House* newOwner) {
         setDestination(location);
         clearPath();
         doSetAttackMode(GUARD);
-        owner = newOwner;
+        setOwner(newOwner);
         graphic = pGFXManager->getObjPic(graphicID,getOwner()->getHouseID());
         deviationTimer = DEVIATIONTIME;
         idle = true;
@@ -2262,8 +2262,13 @@ void UnitBase::targeting() {
                     if( tmp != NULL && tmp->getTarget() == this && tmp->targetInWeaponRange()) {
                     	pNewTarget = tmp;
                     }
-                    else {
+                    else if(currentGame->mayScanForTarget(this)) {
                     	pNewTarget = findTarget();
+                    }
+                    else {
+                    	// not our turn to search in this cycle => try again next cycle
+                    	engageTarget();
+                    	return;
                     }
                 	if (this->isSelected()) err_relax_print("UnitBase::targeting-- ID:%d choose NEW target %d\n", objectID,pNewTarget != NULL ? pNewTarget->getObjectID() : 0);
 
@@ -2373,7 +2378,7 @@ void UnitBase::quitDeviation() {
         setTarget(NULL);
         setGuardPoint(location);
         setDestination(location);
-        owner = currentGame->getHouse(originalHouseID);
+        setOwner(currentGame->getHouse(originalHouseID));
         graphic = pGFXManager->getObjPic(graphicID,getOwner()->getHouseID());
         deviationTimer = INVALID;
     }
@@ -2519,8 +2524,22 @@ bool UnitBase::SearchPathWithAStar() {
             destinationCoord = target.getObjPointer()->getClosestPoint(location);
 	}
 
-	AStarSearch pathfinder(currentGameMap, this, location, destinationCoord);
-	pathList = pathfinder.getFoundPath();
+	// do not let A* sweep the whole area around a destination that cannot be reached at all
+	ReachabilityIndex& reachabilityIndex = currentGameMap->getReachabilityIndex();
+	ReachabilityIndex::MOVECLASS moveClass = ReachabilityIndex::getMoveClass(this);
+	if(!reachabilityIndex.isReachable(moveClass, location, destinationCoord)) {
+		destinationCoord = reachabilityIndex.findClosestReachableTile(moveClass, location, destinationCoord);
+	}
+
+	// units ordered to the same destination share one flow field
+	if(!currentGame->getGameInitSettings().getGameOptions().flowFieldPathfinding
+		|| (destinationCoord != destination) || !currentGameMap->getFlowFieldCache().searchPath(this, location, destinationCoord, pathList)) {
+		if(!currentGame->getGameInitSettings().getGameOptions().hierarchicalPathfinding
+			|| !currentGameMap->getHierarchicalPathfinder().searchPath(this, location, destinationCoord, pathList)) {
+			AStarSearch pathfinder(currentGameMap, this, location, destinationCoord);
+			pathList = pathfinder.getFoundPath();
+		}
+	}
 
 	if(pathList.empty() == true) {
         nextSpotFound = false;
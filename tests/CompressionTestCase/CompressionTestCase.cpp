@@ -0,0 +1,90 @@
+#include <misc/Compression.h>
+
+#include <vector>
+
+#include "CompressionTestCase.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(CompressionTestCase);
+
+
+void CompressionTestCase::setUp() {
+}
+
+void CompressionTestCase::tearDown() {
+}
+
+bool CompressionTestCase::roundTrip(const std::vector<Uint8>& data, size_t* pCompressedLength) {
+	std::vector<Uint8> compressed(getMaxCompressedSize(data.size()));
+	size_t compressedLength = compressData(data.empty() ? NULL : &data[0], data.size(), &compressed[0], compressed.size());
+	if(compressedLength == 0) {
+		return false;
+	}
+
+	if(pCompressedLength != NULL) {
+		*pCompressedLength = compressedLength;
+	}
+
+	std::vector<Uint8> decompressed(data.size() + 1);
+	if(decompressData(&compressed[0], compressedLength, &decompressed[0], data.size()) == false) {
+		return false;
+	}
+	decompressed.resize(data.size());
+
+	return (decompressed == data);
+}
+
+void CompressionTestCase::testEmpty() {
+	CPPUNIT_ASSERT(roundTrip(std::vector<Uint8>()));
+	CPPUNIT_ASSERT(roundTrip(std::vector<Uint8>(1, 42)));
+	CPPUNIT_ASSERT(roundTrip(std::vector<Uint8>(13, 42)));
+}
+
+void CompressionTestCase::testRepetitive() {
+	std::vector<Uint8> data;
+	for(int i = 0; i < 65536; i++) {
+		data.push_back(i % 7);
+	}
+
+	size_t compressedLength = 0;
+	CPPUNIT_ASSERT(roundTrip(data, &compressedLength));
+	CPPUNIT_ASSERT(compressedLength < data.size() / 50);
+
+	std::vector<Uint8> zeros(100000, 0);
+	CPPUNIT_ASSERT(roundTrip(zeros, &compressedLength));
+	CPPUNIT_ASSERT(compressedLength < zeros.size() / 50);
+}
+
+void CompressionTestCase::testRandom() {
+	Uint32 seed = 12345;
+	for(size_t length = 1; length < 100000; length = length*3 + 1) {
+		std::vector<Uint8> data;
+		for(size_t i = 0; i < length; i++) {
+			seed = seed * 1103515245 + 12345;
+			// mix random bytes with repeated parts
+			if((i > 16) && ((seed >> 16) % 4 == 0)) {
+				data.push_back(data[i - 1 - (seed >> 24) % 16]);
+			} else {
+				data.push_back((Uint8) (seed >> 16));
+			}
+		}
+
+		CPPUNIT_ASSERT(roundTrip(data));
+	}
+}
+
+void CompressionTestCase::testCorrupt() {
+	std::vector<Uint8> data(1000, 1);
+	std::vector<Uint8> compressed(getMaxCompressedSize(data.size()));
+	size_t compressedLength = compressData(&data[0], data.size(), &compressed[0], compressed.size());
+	CPPUNIT_ASSERT(compressedLength > 0);
+
+	std::vector<Uint8> decompressed(data.size());
+
+	// wrong uncompressed length
+	CPPUNIT_ASSERT(decompressData(&compressed[0], compressedLength, &decompressed[0], data.size() - 1) == false);
+
+	// truncated data
+	CPPUNIT_ASSERT(decompressData(&compressed[0], compressedLength - 1, &decompressed[0], data.size()) == false);
+}
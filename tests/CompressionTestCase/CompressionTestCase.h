@@ -0,0 +1,27 @@
+
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class CompressionTestCase: public CppUnit::TestFixture  {
+
+	CPPUNIT_TEST_SUITE(CompressionTestCase);
+
+	CPPUNIT_TEST(testEmpty);
+	CPPUNIT_TEST(testRepetitive);
+	CPPUNIT_TEST(testRandom);
+	CPPUNIT_TEST(testCorrupt);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testEmpty();
+	void testRepetitive();
+	void testRandom();
+	void testCorrupt();
+
+private:
+	bool roundTrip(const std::vector<Uint8>& data, size_t* pCompressedLength = NULL);
+};
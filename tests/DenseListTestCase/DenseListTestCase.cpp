@@ -0,0 +1,114 @@
+#include <misc/DenseList.h>
+
+#include <vector>
+
+#include "DenseListTestCase.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DenseListTestCase);
+
+
+static std::vector<int*> toVector(const DenseList<int*>& list) {
+	std::vector<int*> result;
+	for(DenseList<int*>::const_iterator iter = list.begin(); iter != list.end(); ++iter) {
+		result.push_back(*iter);
+	}
+	return result;
+}
+
+void DenseListTestCase::setUp() {
+	for(int i = 0; i < 10; i++) {
+		values[i] = i;
+	}
+}
+
+void DenseListTestCase::tearDown() {
+}
+
+void DenseListTestCase::testOrder() {
+	DenseList<int*> list;
+	CPPUNIT_ASSERT(list.empty());
+	CPPUNIT_ASSERT(list.begin() == list.end());
+
+	for(int i = 0; i < 10; i++) {
+		list.push_back(&values[i]);
+	}
+	CPPUNIT_ASSERT(list.size() == 10);
+
+	std::vector<int*> content = toVector(list);
+	CPPUNIT_ASSERT(content.size() == 10);
+	for(int i = 0; i < 10; i++) {
+		CPPUNIT_ASSERT(content[i] == &values[i]);
+	}
+}
+
+void DenseListTestCase::testRemoveWhileIterating() {
+	DenseList<int*> list;
+	for(int i = 0; i < 10; i++) {
+		list.push_back(&values[i]);
+	}
+
+	// remove the current element and the one after it
+	std::vector<int*> visited;
+	for(DenseList<int*>::iterator iter = list.begin(); iter != list.end(); ++iter) {
+		int* pValue = *iter;
+		visited.push_back(pValue);
+		if(*pValue == 3) {
+			list.remove(pValue);
+			list.remove(&values[4]);
+			CPPUNIT_ASSERT(*iter == NULL);
+		}
+	}
+
+	CPPUNIT_ASSERT(visited.size() == 9);
+	CPPUNIT_ASSERT(visited[3] == &values[3]);
+	CPPUNIT_ASSERT(visited[4] == &values[5]);
+	CPPUNIT_ASSERT(list.size() == 8);
+
+	// removing an element that is not in the list does nothing
+	list.remove(&values[4]);
+	CPPUNIT_ASSERT(list.size() == 8);
+}
+
+void DenseListTestCase::testAddWhileIterating() {
+	DenseList<int*> list;
+	list.push_back(&values[0]);
+	list.push_back(&values[1]);
+
+	// elements added while iterating are visited in the same iteration
+	std::vector<int*> visited;
+	for(DenseList<int*>::iterator iter = list.begin(); iter != list.end(); ++iter) {
+		visited.push_back(*iter);
+		if(list.size() < 5) {
+			list.push_back(&values[list.size()]);
+		}
+	}
+
+	CPPUNIT_ASSERT(visited.size() == 5);
+	for(int i = 0; i < 5; i++) {
+		CPPUNIT_ASSERT(visited[i] == &values[i]);
+	}
+}
+
+void DenseListTestCase::testCompact() {
+	DenseList<int*> list;
+	for(int i = 0; i < 10; i++) {
+		list.push_back(&values[i]);
+	}
+
+	for(int i = 0; i < 10; i += 3) {
+		list.remove(&values[i]);
+	}
+
+	std::vector<int*> before = toVector(list);
+	list.compact();
+	std::vector<int*> after = toVector(list);
+
+	CPPUNIT_ASSERT(list.size() == 6);
+	CPPUNIT_ASSERT(before == after);
+
+	list.clear();
+	CPPUNIT_ASSERT(list.empty());
+	CPPUNIT_ASSERT(list.begin() == list.end());
+}
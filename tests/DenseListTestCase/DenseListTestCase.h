@@ -0,0 +1,25 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+class DenseListTestCase: public CppUnit::TestFixture  {
+
+	CPPUNIT_TEST_SUITE(DenseListTestCase);
+
+	CPPUNIT_TEST(testOrder);
+	CPPUNIT_TEST(testRemoveWhileIterating);
+	CPPUNIT_TEST(testAddWhileIterating);
+	CPPUNIT_TEST(testCompact);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testOrder();
+	void testRemoveWhileIterating();
+	void testAddWhileIterating();
+	void testCompact();
+
+private:
+	int values[10];
+};